@@ -26,7 +26,6 @@
 #include <boost/asio/ssl.hpp>
 #include <boost/asio/strand.hpp>
 #include <boost/make_unique.hpp>
-#include <boost/optional.hpp>
 #include <algorithm>
 #include <cstdlib>
 #include <iostream>
@@ -452,9 +451,11 @@ class http_session
     static constexpr std::size_t queue_limit = 8; // max responses
     std::queue<http::message_generator> response_queue_;
 
-    // The parser is stored in an optional container so we can
-    // construct it from scratch it at the beginning of each new message.
-    boost::optional<http::request_parser<http::string_body>> parser_;
+    // One parser reads every request on the connection. It is
+    // reset before each read, and the request it parsed is moved
+    // out with release(), so the parser state is reused but the
+    // message storage is not.
+    http::request_parser<http::string_body> parser_;
 
 protected:
     beast::flat_buffer buffer_;
@@ -472,12 +473,12 @@ public:
     void
     do_read()
     {
-        // Construct a new parser for each message
-        parser_.emplace();
+        // Prepare the parser for the next message
+        parser_.reset();
 
         // Apply a reasonable limit to the allowed size
         // of the body in bytes to prevent abuse.
-        parser_->body_limit(10000);
+        parser_.body_limit(10000);
 
         // Set the timeout.
         beast::get_lowest_layer(
@@ -487,7 +488,7 @@ public:
         http::async_read(
             derived().stream(),
             buffer_,
-            *parser_,
+            parser_,
             beast::bind_front_handler(
                 &http_session::on_read,
                 derived().shared_from_this()));
@@ -506,7 +507,7 @@ public:
             return fail(ec, "read");
 
         // See if it is a WebSocket Upgrade
-        if(websocket::is_upgrade(parser_->get()))
+        if(websocket::is_upgrade(parser_.get()))
         {
             // Disable the timeout.
             // The websocket::stream uses its own timeout settings.
@@ -516,11 +517,11 @@ public:
             // of both the socket and the HTTP request.
             return make_websocket_session(
                 derived().release_stream(),
-                parser_->release());
+                parser_.release());
         }
 
         // Send the response
-        queue_write(handle_request(*doc_root_, parser_->release()));
+        queue_write(handle_request(*doc_root_, parser_.release()));
 
         // If we aren't at the queue limit, try to pipeline another request
         if (response_queue_.size() < queue_limit)
@@ -22,7 +22,6 @@
 #include <boost/asio/signal_set.hpp>
 #include <boost/asio/strand.hpp>
 #include <boost/make_unique.hpp>
-#include <boost/optional.hpp>
 #include <algorithm>
 #include <cstdlib>
 #include <functional>
@@ -331,9 +330,11 @@ class http_session : public std::enable_shared_from_this<http_session>
     static constexpr std::size_t queue_limit = 8; // max responses
     std::queue<http::message_generator> response_queue_;
 
-    // The parser is stored in an optional container so we can
-    // construct it from scratch it at the beginning of each new message.
-    boost::optional<http::request_parser<http::string_body>> parser_;
+    // One parser reads every request on the connection. It is
+    // reset before each read, and the request it parsed is moved
+    // out with release(), so the parser state is reused but the
+    // message storage is not.
+    http::request_parser<http::string_body> parser_;
 
 public:
     // Take ownership of the socket
@@ -366,12 +367,12 @@ private:
     void
     do_read()
     {
-        // Construct a new parser for each message
-        parser_.emplace();
+        // Prepare the parser for the next message
+        parser_.reset();
 
         // Apply a reasonable limit to the allowed size
         // of the body in bytes to prevent abuse.
-        parser_->body_limit(10000);
+        parser_.body_limit(10000);
 
         // Set the timeout.
         stream_.expires_after(std::chrono::seconds(30));
@@ -380,7 +381,7 @@ private:
         http::async_read(
             stream_,
             buffer_,
-            *parser_,
+            parser_,
             beast::bind_front_handler(
                 &http_session::on_read,
                 shared_from_this()));
@@ -399,17 +400,17 @@ private:
             return fail(ec, "read");
 
         // See if it is a WebSocket Upgrade
-        if(websocket::is_upgrade(parser_->get()))
+        if(websocket::is_upgrade(parser_.get()))
         {
             // Create a websocket session, transferring ownership
             // of both the socket and the HTTP request.
             std::make_shared<websocket_session>(
-                stream_.release_socket())->do_accept(parser_->release());
+                stream_.release_socket())->do_accept(parser_.release());
             return;
         }
 
         // Send the response
-        queue_write(handle_request(*doc_root_, parser_->release()));
+        queue_write(handle_request(*doc_root_, parser_.release()));
 
         // If we aren't at the queue limit, try to pipeline another request
         if (response_queue_.size() < queue_limit)
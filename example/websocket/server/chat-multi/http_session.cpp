@@ -215,12 +215,12 @@ void
 http_session::
 do_read()
 {
-    // Construct a new parser for each message
-    parser_.emplace();
+    // Prepare the parser for the next message
+    parser_.reset();
 
     // Apply a reasonable limit to the allowed size
     // of the body in bytes to prevent abuse.
-    parser_->body_limit(10000);
+    parser_.body_limit(10000);
 
     // Set the timeout.
     stream_.expires_after(std::chrono::seconds(30));
@@ -229,7 +229,7 @@ do_read()
     http::async_read(
         stream_,
         buffer_,
-        parser_->get(),
+        parser_,
         beast::bind_front_handler(
             &http_session::on_read,
             shared_from_this()));
@@ -251,19 +251,19 @@ on_read(beast::error_code ec, std::size_t)
         return fail(ec, "read");
 
     // See if it is a WebSocket Upgrade
-    if(websocket::is_upgrade(parser_->get()))
+    if(websocket::is_upgrade(parser_.get()))
     {
         // Create a websocket session, transferring ownership
         // of both the socket and the HTTP request.
         boost::make_shared<websocket_session>(
             stream_.release_socket(),
-                state_)->run(parser_->release());
+                state_)->run(parser_.release());
         return;
     }
 
     // Handle request
     http::message_generator msg =
-        handle_request(state_->doc_root(), parser_->release());
+        handle_request(state_->doc_root(), parser_.release());
 
     // Determine if we should close the connection
     bool keep_alive = msg.keep_alive();
@@ -13,7 +13,6 @@
 #include "net.hpp"
 #include "beast.hpp"
 #include "shared_state.hpp"
-#include <boost/optional.hpp>
 #include <boost/smart_ptr.hpp>
 #include <cstdlib>
 #include <memory>
@@ -26,9 +25,11 @@ class http_session : public boost::enable_shared_from_this<http_session>
     beast::flat_buffer buffer_;
     boost::shared_ptr<shared_state> state_;
 
-    // The parser is stored in an optional container so we can
-    // construct it from scratch it at the beginning of each new message.
-    boost::optional<http::request_parser<http::string_body>> parser_;
+    // One parser reads every request on the connection. It is
+    // reset before each read, and the request it parsed is moved
+    // out with release(), so the parser state is reused but the
+    // message storage is not.
+    http::request_parser<http::string_body> parser_;
 
     struct send_lambda;
 
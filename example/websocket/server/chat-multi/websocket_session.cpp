@@ -81,7 +81,7 @@ on_read(beast::error_code ec, std::size_t)
 
 void
 websocket_session::
-send(boost::shared_ptr<std::string const> const& ss)
+send(websocket::prepared_message const& msg)
 {
     // Post our work to the strand, this ensures
     // that the members of `this` will not be
@@ -92,23 +92,23 @@ send(boost::shared_ptr<std::string const> const& ss)
         beast::bind_front_handler(
             &websocket_session::on_send,
             shared_from_this(),
-            ss));
+            msg));
 }
 
 void
 websocket_session::
-on_send(boost::shared_ptr<std::string const> const& ss)
+on_send(websocket::prepared_message const& msg)
 {
     // Always add to queue
-    queue_.push_back(ss);
+    queue_.push_back(msg);
 
     // Are we already writing?
     if(queue_.size() > 1)
         return;
 
     // We are not currently writing, so send this immediately
-    ws_.async_write(
-        net::buffer(*queue_.front()),
+    ws_.async_write_prepared(
+        queue_.front(),
         beast::bind_front_handler(
             &websocket_session::on_write,
             shared_from_this()));
@@ -122,13 +122,13 @@ on_write(beast::error_code ec, std::size_t)
     if(ec)
         return fail(ec, "write");
 
-    // Remove the string from the queue
+    // Remove the message from the queue
     queue_.erase(queue_.begin());
 
     // Send the next message if any
     if(! queue_.empty())
-        ws_.async_write(
-            net::buffer(*queue_.front()),
+        ws_.async_write_prepared(
+            queue_.front(),
             beast::bind_front_handler(
                 &websocket_session::on_write,
                 shared_from_this()));
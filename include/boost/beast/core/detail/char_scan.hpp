@@ -0,0 +1,133 @@
+//
+// Copyright (c) 2016-2019 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/beast
+//
+
+#ifndef BOOST_BEAST_DETAIL_CHAR_SCAN_HPP
+#define BOOST_BEAST_DETAIL_CHAR_SCAN_HPP
+
+#include <boost/beast/core/detail/config.hpp>
+#include <boost/beast/core/detail/cpu_info.hpp>
+#include <cstddef>
+
+namespace boost {
+namespace beast {
+namespace detail {
+
+/*  Vectorized character scanning.
+
+    A set of characters is described by up to eight inclusive
+    ranges of unsigned byte values, stored as consecutive pairs
+    of characters. For example the string "\x00\x1f\x7f\x7f"
+    describes the ASCII control characters. This is the same
+    format accepted by the SSE4.2 `pcmpestri` instruction.
+
+    Each function returns a pointer to the first character in
+    [first, last) which falls within any of the ranges, or
+    `last` if there is no such character. The portable
+    implementation examines eight bytes at a time using
+    SWAR arithmetic, while the SSE4.2 and AVX2 versions
+    are only compiled when intrinsics are available and
+    must only be called when get_cpu_info() reports
+    support for the corresponding instruction set.
+*/
+namespace char_scan {
+
+// The maximum length of a range string, in bytes
+static std::size_t constexpr max_ranges_size = 16;
+
+BOOST_BEAST_DECL
+char const*
+find_ranges_swar(
+    char const* first,
+    char const* last,
+    char const* ranges,
+    std::size_t ranges_size) noexcept;
+
+#if ! BOOST_BEAST_NO_INTRINSICS
+
+BOOST_BEAST_DECL
+char const*
+find_ranges_sse42(
+    char const* first,
+    char const* last,
+    char const* ranges,
+    std::size_t ranges_size) noexcept;
+
+BOOST_BEAST_DECL
+char const*
+find_ranges_avx2(
+    char const* first,
+    char const* last,
+    char const* ranges,
+    std::size_t ranges_size) noexcept;
+
+#endif
+
+/** Return the first character within any of the ranges.
+
+    The fastest implementation supported by the
+    processor is selected at runtime.
+*/
+BOOST_BEAST_DECL
+char const*
+find_ranges(
+    char const* first,
+    char const* last,
+    char const* ranges,
+    std::size_t ranges_size) noexcept;
+
+//------------------------------------------------------------------------------
+
+/*  Return a pointer to the first occurrence of the four
+    character sequence "\r\n\r\n" in [first, last), or
+    `last` if the sequence does not appear in its entirety.
+*/
+BOOST_BEAST_DECL
+char const*
+find_crlfcrlf_swar(
+    char const* first,
+    char const* last) noexcept;
+
+#if ! BOOST_BEAST_NO_INTRINSICS
+
+BOOST_BEAST_DECL
+char const*
+find_crlfcrlf_sse2(
+    char const* first,
+    char const* last) noexcept;
+
+BOOST_BEAST_DECL
+char const*
+find_crlfcrlf_avx2(
+    char const* first,
+    char const* last) noexcept;
+
+#endif
+
+/** Return the first "\r\n\r\n" in a range of characters.
+
+    The fastest implementation supported by the
+    processor is selected at runtime.
+*/
+BOOST_BEAST_DECL
+char const*
+find_crlfcrlf(
+    char const* first,
+    char const* last) noexcept;
+
+} // char_scan
+
+} // detail
+} // beast
+} // boost
+
+#if BOOST_BEAST_HEADER_ONLY
+#include <boost/beast/core/detail/char_scan.ipp>
+#endif
+
+#endif
@@ -0,0 +1,383 @@
+//
+// Copyright (c) 2016-2019 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/beast
+//
+
+#ifndef BOOST_BEAST_DETAIL_CHAR_SCAN_IPP
+#define BOOST_BEAST_DETAIL_CHAR_SCAN_IPP
+
+#include <boost/beast/core/detail/char_scan.hpp>
+#include <boost/assert.hpp>
+#include <boost/core/bit.hpp>
+#include <boost/endian/conversion.hpp>
+#include <cstdint>
+#include <cstring>
+
+#if ! BOOST_BEAST_NO_INTRINSICS
+#include <immintrin.h>
+#endif
+
+namespace boost {
+namespace beast {
+namespace detail {
+namespace char_scan {
+
+static std::uint64_t constexpr swar_ones = 0x0101010101010101ULL;
+static std::uint64_t constexpr swar_high = 0x8080808080808080ULL;
+
+// One bound of a range, expressed so that the
+// comparison `byte >= bound` can be carried out on
+// eight bytes at once without borrowing between them.
+struct swar_bound
+{
+    std::uint64_t sub = 0;
+    bool high = false;  // bound is above 0x80
+    bool none = false;  // bound is 0x100, nothing matches
+
+    swar_bound() = default;
+
+    explicit
+    swar_bound(unsigned v) noexcept
+    {
+        if(v > 0xff)
+        {
+            none = true;
+        }
+        else if(v > 0x80)
+        {
+            high = true;
+            sub = (v - 0x80) * swar_ones;
+        }
+        else
+        {
+            sub = v * swar_ones;
+        }
+    }
+
+    // Sets the high bit of every byte of w which is >= bound
+    std::uint64_t
+    ge(std::uint64_t w) const noexcept
+    {
+        if(none)
+            return 0;
+        auto const t = (w | swar_high) - sub;
+        return high ? (w & t) : (w | t);
+    }
+};
+
+inline
+bool
+in_ranges(
+    unsigned char c,
+    char const* ranges,
+    std::size_t ranges_size) noexcept
+{
+    for(std::size_t i = 0; i < ranges_size; i += 2)
+        if( c >= static_cast<unsigned char>(ranges[i]) &&
+            c <= static_cast<unsigned char>(ranges[i + 1]))
+            return true;
+    return false;
+}
+
+// Sets the high bit of every byte of w which equals c
+inline
+std::uint64_t
+swar_eq(std::uint64_t w, unsigned char c) noexcept
+{
+    auto const x = w ^ (c * swar_ones);
+    return ~(((x & ~swar_high) + ~swar_high) | x) & swar_high;
+}
+
+inline
+std::uint64_t
+swar_load(char const* p) noexcept
+{
+    std::uint64_t w;
+    std::memcpy(&w, p, sizeof(w));
+    // put the first byte in the least significant position
+    return endian::little_to_native(w);
+}
+
+char const*
+find_ranges_swar(
+    char const* first,
+    char const* last,
+    char const* ranges,
+    std::size_t ranges_size) noexcept
+{
+    BOOST_ASSERT(ranges_size % 2 == 0);
+    BOOST_ASSERT(ranges_size <= max_ranges_size);
+    if(last - first >= 8)
+    {
+        swar_bound lo[max_ranges_size / 2];
+        swar_bound hi[max_ranges_size / 2];
+        auto const n = ranges_size / 2;
+        for(std::size_t i = 0; i < n; ++i)
+        {
+            lo[i] = swar_bound(static_cast<
+                unsigned char>(ranges[2 * i]));
+            hi[i] = swar_bound(static_cast<
+                unsigned char>(ranges[2 * i + 1]) + 1u);
+        }
+        do
+        {
+            auto const w = swar_load(first);
+            std::uint64_t m = 0;
+            for(std::size_t i = 0; i < n; ++i)
+                m |= lo[i].ge(w) & ~hi[i].ge(w);
+            m &= swar_high;
+            if(m != 0)
+                return first + (core::countr_zero(m) / 8);
+            first += 8;
+        }
+        while(last - first >= 8);
+    }
+    for(; first != last; ++first)
+        if(in_ranges(static_cast<unsigned char>(
+                *first), ranges, ranges_size))
+            break;
+    return first;
+}
+
+#if ! BOOST_BEAST_NO_INTRINSICS
+
+BOOST_BEAST_TARGET("sse4.2")
+char const*
+find_ranges_sse42(
+    char const* first,
+    char const* last,
+    char const* ranges,
+    std::size_t ranges_size) noexcept
+{
+    BOOST_ASSERT(ranges_size % 2 == 0);
+    BOOST_ASSERT(ranges_size <= max_ranges_size);
+    if(last - first >= 16)
+    {
+        // the instruction always reads sixteen bytes of ranges
+        char buf[max_ranges_size] = {};
+        std::memcpy(buf, ranges, ranges_size);
+        __m128i const r = _mm_loadu_si128(
+            reinterpret_cast<__m128i const*>(buf));
+        int const n = static_cast<int>(ranges_size);
+        do
+        {
+            __m128i const b = _mm_loadu_si128(
+                reinterpret_cast<__m128i const*>(first));
+            int const i = _mm_cmpestri(r, n, b, 16,
+                _SIDD_LEAST_SIGNIFICANT |
+                _SIDD_CMP_RANGES |
+                _SIDD_UBYTE_OPS);
+            if(i != 16)
+                return first + i;
+            first += 16;
+        }
+        while(last - first >= 16);
+    }
+    return find_ranges_swar(
+        first, last, ranges, ranges_size);
+}
+
+BOOST_BEAST_TARGET("avx2")
+char const*
+find_ranges_avx2(
+    char const* first,
+    char const* last,
+    char const* ranges,
+    std::size_t ranges_size) noexcept
+{
+    BOOST_ASSERT(ranges_size % 2 == 0);
+    BOOST_ASSERT(ranges_size <= max_ranges_size);
+    if(last - first >= 32)
+    {
+        // c is within [lo, hi] when the wrapping
+        // difference c - lo is not greater than hi - lo
+        __m256i lo[max_ranges_size / 2];
+        __m256i len[max_ranges_size / 2];
+        auto const n = ranges_size / 2;
+        for(std::size_t i = 0; i < n; ++i)
+        {
+            lo[i] = _mm256_set1_epi8(ranges[2 * i]);
+            len[i] = _mm256_set1_epi8(static_cast<char>(
+                static_cast<unsigned char>(ranges[2 * i + 1]) -
+                static_cast<unsigned char>(ranges[2 * i])));
+        }
+        do
+        {
+            __m256i const b = _mm256_loadu_si256(
+                reinterpret_cast<__m256i const*>(first));
+            __m256i m = _mm256_setzero_si256();
+            for(std::size_t i = 0; i < n; ++i)
+            {
+                __m256i const d = _mm256_sub_epi8(b, lo[i]);
+                m = _mm256_or_si256(m, _mm256_cmpeq_epi8(
+                    _mm256_min_epu8(d, len[i]), d));
+            }
+            auto const bits = static_cast<std::uint32_t>(
+                _mm256_movemask_epi8(m));
+            if(bits != 0)
+                return first + core::countr_zero(bits);
+            first += 32;
+        }
+        while(last - first >= 32);
+    }
+    return find_ranges_swar(
+        first, last, ranges, ranges_size);
+}
+
+#endif
+
+char const*
+find_ranges(
+    char const* first,
+    char const* last,
+    char const* ranges,
+    std::size_t ranges_size) noexcept
+{
+#if ! BOOST_BEAST_NO_INTRINSICS
+    auto const& ci = get_cpu_info();
+    if(ci.avx2)
+        return find_ranges_avx2(
+            first, last, ranges, ranges_size);
+    if(ci.sse42)
+        return find_ranges_sse42(
+            first, last, ranges, ranges_size);
+#endif
+    return find_ranges_swar(
+        first, last, ranges, ranges_size);
+}
+
+//------------------------------------------------------------------------------
+
+inline
+char const*
+find_crlfcrlf_tail(
+    char const* first,
+    char const* last) noexcept
+{
+    for(; last - first >= 4; ++first)
+        if( first[0] == '\r' && first[1] == '\n' &&
+            first[2] == '\r' && first[3] == '\n')
+            return first;
+    return last;
+}
+
+// Each candidate position i is tested by comparing the
+// blocks starting at i, i+1, i+2 and i+3 against the
+// corresponding character of the pattern at once.
+
+char const*
+find_crlfcrlf_swar(
+    char const* first,
+    char const* last) noexcept
+{
+    while(last - first >= 11)
+    {
+        auto const m =
+            swar_eq(swar_load(first    ), '\r') &
+            swar_eq(swar_load(first + 1), '\n') &
+            swar_eq(swar_load(first + 2), '\r') &
+            swar_eq(swar_load(first + 3), '\n');
+        if(m != 0)
+            return first + (core::countr_zero(m) / 8);
+        first += 8;
+    }
+    return find_crlfcrlf_tail(first, last);
+}
+
+#if ! BOOST_BEAST_NO_INTRINSICS
+
+BOOST_BEAST_TARGET("sse2")
+char const*
+find_crlfcrlf_sse2(
+    char const* first,
+    char const* last) noexcept
+{
+    if(last - first >= 19)
+    {
+        __m128i const cr = _mm_set1_epi8('\r');
+        __m128i const lf = _mm_set1_epi8('\n');
+        do
+        {
+            __m128i const m = _mm_and_si128(
+                _mm_and_si128(
+                    _mm_cmpeq_epi8(cr, _mm_loadu_si128(
+                        reinterpret_cast<__m128i const*>(first))),
+                    _mm_cmpeq_epi8(lf, _mm_loadu_si128(
+                        reinterpret_cast<__m128i const*>(first + 1)))),
+                _mm_and_si128(
+                    _mm_cmpeq_epi8(cr, _mm_loadu_si128(
+                        reinterpret_cast<__m128i const*>(first + 2))),
+                    _mm_cmpeq_epi8(lf, _mm_loadu_si128(
+                        reinterpret_cast<__m128i const*>(first + 3)))));
+            auto const bits = static_cast<std::uint32_t>(
+                _mm_movemask_epi8(m));
+            if(bits != 0)
+                return first + core::countr_zero(bits);
+            first += 16;
+        }
+        while(last - first >= 19);
+    }
+    return find_crlfcrlf_swar(first, last);
+}
+
+BOOST_BEAST_TARGET("avx2")
+char const*
+find_crlfcrlf_avx2(
+    char const* first,
+    char const* last) noexcept
+{
+    if(last - first >= 35)
+    {
+        __m256i const cr = _mm256_set1_epi8('\r');
+        __m256i const lf = _mm256_set1_epi8('\n');
+        do
+        {
+            __m256i const m = _mm256_and_si256(
+                _mm256_and_si256(
+                    _mm256_cmpeq_epi8(cr, _mm256_loadu_si256(
+                        reinterpret_cast<__m256i const*>(first))),
+                    _mm256_cmpeq_epi8(lf, _mm256_loadu_si256(
+                        reinterpret_cast<__m256i const*>(first + 1)))),
+                _mm256_and_si256(
+                    _mm256_cmpeq_epi8(cr, _mm256_loadu_si256(
+                        reinterpret_cast<__m256i const*>(first + 2))),
+                    _mm256_cmpeq_epi8(lf, _mm256_loadu_si256(
+                        reinterpret_cast<__m256i const*>(first + 3)))));
+            auto const bits = static_cast<std::uint32_t>(
+                _mm256_movemask_epi8(m));
+            if(bits != 0)
+                return first + core::countr_zero(bits);
+            first += 32;
+        }
+        while(last - first >= 35);
+    }
+    return find_crlfcrlf_swar(first, last);
+}
+
+#endif
+
+char const*
+find_crlfcrlf(
+    char const* first,
+    char const* last) noexcept
+{
+#if ! BOOST_BEAST_NO_INTRINSICS
+    auto const& ci = get_cpu_info();
+    if(ci.avx2)
+        return find_crlfcrlf_avx2(first, last);
+    if(ci.sse2)
+        return find_crlfcrlf_sse2(first, last);
+#endif
+    return find_crlfcrlf_swar(first, last);
+}
+
+} // char_scan
+} // detail
+} // beast
+} // boost
+
+#endif
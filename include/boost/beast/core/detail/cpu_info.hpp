@@ -13,14 +13,34 @@
 #include <boost/config.hpp>
 #include <cstdint>
 
+// Intrinsics are compiled in on x86 whenever the compiler lets
+// us target an instruction set per function, and the best
+// implementation is chosen at runtime using get_cpu_info().
 #ifndef BOOST_BEAST_NO_INTRINSICS
-# if defined(BOOST_MSVC) || ((defined(BOOST_GCC) || defined(BOOST_CLANG)) && defined(__SSE4_2__))
+# if (defined(BOOST_MSVC) && (defined(_M_IX86) || defined(_M_X64))) || \
+    ((defined(BOOST_GCC) || defined(BOOST_CLANG)) && \
+        (defined(__i386__) || defined(__x86_64__)))
 #  define BOOST_BEAST_NO_INTRINSICS 0
 # else
 #  define BOOST_BEAST_NO_INTRINSICS 1
 # endif
 #endif
 
+// NEON is part of the baseline instruction
+// set on AArch64, so it needs no runtime check.
+// 32-bit ARM is left out, as the kernels use
+// horizontal reductions and table lookups
+// which only exist on AArch64.
+#ifndef BOOST_BEAST_NEON
+# if ! BOOST_BEAST_NO_INTRINSICS
+#  define BOOST_BEAST_NEON 0
+# elif defined(__aarch64__) || defined(_M_ARM64)
+#  define BOOST_BEAST_NEON 1
+# else
+#  define BOOST_BEAST_NEON 0
+# endif
+#endif
+
 #if ! BOOST_BEAST_NO_INTRINSICS
 
 #ifdef BOOST_MSVC
@@ -29,6 +49,16 @@
 #include <cpuid.h>  // __get_cpuid
 #endif
 
+// Marks a function as compiled for the given instruction set.
+// The caller is responsible for checking get_cpu_info() first.
+#ifndef BOOST_BEAST_TARGET
+# ifdef BOOST_MSVC
+#  define BOOST_BEAST_TARGET(isa)
+# else
+#  define BOOST_BEAST_TARGET(isa) __attribute__((target(isa)))
+# endif
+#endif
+
 namespace boost {
 namespace beast {
 namespace detail {
@@ -47,19 +77,38 @@ cpuid(
 {
 #ifdef BOOST_MSVC
     int regs[4];
-    __cpuid(regs, id);
+    __cpuidex(regs, id, 0);
     eax = regs[0];
     ebx = regs[1];
     ecx = regs[2];
     edx = regs[3];
 #else
-    __get_cpuid(id, &eax, &ebx, &ecx, &edx);
+    __cpuid_count(id, 0, eax, ebx, ecx, edx);
+#endif
+}
+
+// Returns the low 32 bits of XCR0, which tell
+// which register files the OS saves on a switch.
+template<class = void>
+std::uint32_t
+xgetbv0()
+{
+#ifdef BOOST_MSVC
+    return static_cast<std::uint32_t>(_xgetbv(0));
+#else
+    std::uint32_t eax;
+    std::uint32_t edx;
+    __asm__ __volatile__("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return eax;
 #endif
 }
 
 struct cpu_info
 {
+    bool sse2 = false;
+    bool ssse3 = false;
     bool sse42 = false;
+    bool avx2 = false;
 
     cpu_info();
 };
@@ -68,7 +117,13 @@ inline
 cpu_info::
 cpu_info()
 {
-    constexpr std::uint32_t SSE42 = 1 << 20;
+    constexpr std::uint32_t SSE2 = 1 << 26;     // edx, leaf 1
+    constexpr std::uint32_t SSSE3 = 1 << 9;     // ecx, leaf 1
+    constexpr std::uint32_t SSE42 = 1 << 20;    // ecx, leaf 1
+    constexpr std::uint32_t OSXSAVE = 1 << 27;  // ecx, leaf 1
+    constexpr std::uint32_t AVX = 1 << 28;      // ecx, leaf 1
+    constexpr std::uint32_t AVX2 = 1 << 5;      // ebx, leaf 7
+    constexpr std::uint32_t XMM_YMM = 0x6;      // XCR0
 
     std::uint32_t eax = 0;
     std::uint32_t ebx = 0;
@@ -76,10 +131,24 @@ cpu_info()
     std::uint32_t edx = 0;
 
     cpuid(0, eax, ebx, ecx, edx);
-    if(eax >= 1)
+    auto const max_id = eax;
+    if(max_id >= 1)
     {
         cpuid(1, eax, ebx, ecx, edx);
+        sse2 = (edx & SSE2) != 0;
+        ssse3 = (ecx & SSSE3) != 0;
         sse42 = (ecx & SSE42) != 0;
+
+        // AVX2 also needs the OS to preserve the upper
+        // halves of the ymm registers across a switch.
+        bool const avx =
+            (ecx & (OSXSAVE | AVX)) == (OSXSAVE | AVX) &&
+            (xgetbv0() & XMM_YMM) == XMM_YMM;
+        if(avx && max_id >= 7)
+        {
+            cpuid(7, eax, ebx, ecx, edx);
+            avx2 = (ebx & AVX2) != 0;
+        }
     }
 }
 
@@ -123,6 +123,17 @@ consume(std::size_t n) noexcept
     }
 }
 
+void
+static_buffer_base::
+reset(void* p, std::size_t n) noexcept
+{
+    begin_ = static_cast<char*>(p);
+    in_off_ = 0;
+    in_size_ = 0;
+    out_size_ = 0;
+    capacity_ = n;
+}
+
 } // beast
 } // boost
 
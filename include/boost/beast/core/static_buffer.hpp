@@ -201,6 +201,26 @@ public:
     BOOST_BEAST_DECL
     void
     consume(std::size_t n) noexcept;
+
+protected:
+    /** Reset the pointed-to buffer.
+
+        This function resets the internal state to the buffer provided.
+        All input and output sequences are invalidated. This function
+        allows the derived class to change the storage used by the
+        static buffer.
+
+        @param p A pointer to valid storage of at least `n` bytes.
+
+        @param n The number of valid bytes pointed to by `p`.
+
+        @esafe
+
+        No-throw guarantee.
+    */
+    BOOST_BEAST_DECL
+    void
+    reset(void* p, std::size_t n) noexcept;
 };
 
 //------------------------------------------------------------------------------
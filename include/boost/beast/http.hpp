@@ -12,20 +12,27 @@
 
 #include <boost/beast/core/detail/config.hpp>
 
+#include <boost/beast/http/arena_fields.hpp>
 #include <boost/beast/http/basic_dynamic_body.hpp>
 #include <boost/beast/http/basic_file_body.hpp>
 #include <boost/beast/http/basic_parser.hpp>
 #include <boost/beast/http/buffer_body.hpp>
 #include <boost/beast/http/chunk_encode.hpp>
+#include <boost/beast/http/date.hpp>
 #include <boost/beast/http/dynamic_body.hpp>
 #include <boost/beast/http/empty_body.hpp>
 #include <boost/beast/http/error.hpp>
 #include <boost/beast/http/field.hpp>
 #include <boost/beast/http/fields.hpp>
+#include <boost/beast/http/fields_view.hpp>
 #include <boost/beast/http/file_body.hpp>
+#include <boost/beast/http/header_view_parser.hpp>
+#include <boost/beast/http/mapped_file_body.hpp>
 #include <boost/beast/http/message_generator.hpp>
 #include <boost/beast/http/message.hpp>
+#include <boost/beast/http/parse_many.hpp>
 #include <boost/beast/http/parser.hpp>
+#include <boost/beast/http/prepared_header.hpp>
 #include <boost/beast/http/read.hpp>
 #include <boost/beast/http/rfc7230.hpp>
 #include <boost/beast/http/serializer.hpp>
@@ -0,0 +1,797 @@
+//
+// Copyright (c) 2016-2019 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/beast
+//
+
+#ifndef BOOST_BEAST_HTTP_ARENA_FIELDS_HPP
+#define BOOST_BEAST_HTTP_ARENA_FIELDS_HPP
+
+#include <boost/beast/http/arena_fields_fwd.hpp>
+
+#include <boost/beast/core/detail/allocator.hpp>
+#include <boost/beast/core/detail/config.hpp>
+#include <boost/beast/core/error.hpp>
+#include <boost/beast/core/string.hpp>
+#include <boost/beast/http/field.hpp>
+#include <boost/asio/buffer.hpp>
+#include <boost/core/empty_value.hpp>
+#include <boost/optional.hpp>
+#include <boost/type_traits/type_with_alignment.hpp>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace boost {
+namespace beast {
+namespace http {
+
+/** A container for storing HTTP header fields in a single block.
+
+    This container is designed to store the field value pairs that make
+    up the fields and trailers in an HTTP message. It offers the same
+    interface as @ref basic_fields for inserting, looking up, and
+    erasing fields, but instead of allocating a separate node for every
+    field it keeps all of the name and value characters, together with a
+    compact index, in one growable block of memory obtained from the
+    allocator. A typical header is stored with one or two allocations.
+
+    Lookups scan the index linearly, comparing the @ref field enumeration
+    when the name is known. For the small headers seen in practice this
+    is faster than maintaining a search tree. Containers which hold many
+    hundreds of fields are better served by @ref basic_fields.
+
+    Erased fields leave their characters behind in the block until the
+    next time it grows, when the remaining fields are packed together.
+    Inserting or erasing fields invalidates all iterators and references.
+
+    Field names are stored as-is, but comparisons are case-insensitive.
+    When the container is iterated the fields are presented in the order
+    of insertion, with fields having the same name following each other
+    consecutively.
+
+    Meets the requirements of <em>Fields</em>, and may be used with
+    @ref message, @ref serializer, and as the third template argument
+    of @ref parser.
+
+    @tparam Allocator The allocator to use.
+*/
+template<class Allocator>
+class basic_arena_fields
+#if ! BOOST_BEAST_DOXYGEN
+    : private boost::empty_value<Allocator>
+#endif
+{
+    // Fancy pointers are not supported
+    static_assert(std::is_pointer<typename
+        std::allocator_traits<Allocator>::pointer>::value,
+        "Allocator must use regular pointers");
+
+    using off_t = std::uint16_t;
+
+public:
+    /// The type of allocator used.
+    using allocator_type = Allocator;
+
+    /// The type of element used to represent a field
+    class value_type
+    {
+#ifndef BOOST_BEAST_DOXYGEN
+        template<class OtherAlloc>
+        friend class basic_arena_fields;
+#endif
+
+        // Points to "<name>: <value>\r\n" in the block
+        char const* p_;
+        off_t nlen_;
+        off_t vlen_;
+        field f_;
+
+        value_type(char const* p,
+            std::size_t nlen, std::size_t vlen, field f);
+
+        std::size_t
+        size() const;
+
+    public:
+        /// Returns the field enum, which can be @ref boost::beast::http::field::unknown
+        field
+        name() const;
+
+        /// Returns the field name as a string
+        string_view const
+        name_string() const;
+
+        /// Returns the value of the field
+        string_view const
+        value() const;
+    };
+
+    /// The algorithm used to serialize the header
+#if BOOST_BEAST_DOXYGEN
+    using writer = __implementation_defined__;
+#else
+    class writer;
+#endif
+
+private:
+    using align_type = typename
+        boost::type_with_alignment<alignof(value_type)>::type;
+
+    using rebind_type = typename
+        beast::detail::allocator_traits<Allocator>::
+            template rebind_alloc<align_type>;
+
+    using alloc_traits =
+        beast::detail::allocator_traits<rebind_type>;
+
+    using pocma = typename
+        alloc_traits::propagate_on_container_move_assignment;
+
+    using pocca = typename
+        alloc_traits::propagate_on_container_copy_assignment;
+
+    using pocs = typename
+        alloc_traits::propagate_on_container_swap;
+
+    class block;
+
+public:
+    /// Maximum field name size
+    static std::size_t constexpr max_name_size =
+        (std::numeric_limits<std::uint16_t>::max)() - 2;
+
+    /// Maximum field value size
+    static std::size_t constexpr max_value_size =
+        (std::numeric_limits<std::uint16_t>::max)() - 2;
+
+    /// Destructor
+    ~basic_arena_fields();
+
+    /// Constructor.
+    basic_arena_fields() = default;
+
+    /** Constructor.
+
+        @param alloc The allocator to use.
+    */
+    explicit
+    basic_arena_fields(Allocator const& alloc) noexcept;
+
+    /** Move constructor.
+
+        The state of the moved-from object is
+        as if constructed using the same allocator.
+    */
+    basic_arena_fields(basic_arena_fields&&) noexcept;
+
+    /** Move constructor.
+
+        The state of the moved-from object is
+        as if constructed using the same allocator.
+
+        @param alloc The allocator to use.
+    */
+    basic_arena_fields(basic_arena_fields&&, Allocator const& alloc);
+
+    /// Copy constructor.
+    basic_arena_fields(basic_arena_fields const&);
+
+    /** Copy constructor.
+
+        @param alloc The allocator to use.
+    */
+    basic_arena_fields(basic_arena_fields const&, Allocator const& alloc);
+
+    /// Copy constructor.
+    template<class OtherAlloc>
+    basic_arena_fields(basic_arena_fields<OtherAlloc> const&);
+
+    /** Copy constructor.
+
+        @param alloc The allocator to use.
+    */
+    template<class OtherAlloc>
+    basic_arena_fields(basic_arena_fields<OtherAlloc> const&,
+        Allocator const& alloc);
+
+    /** Move assignment.
+
+        The state of the moved-from object is
+        as if constructed using the same allocator.
+    */
+    basic_arena_fields& operator=(basic_arena_fields&&) noexcept(
+        pocma::value && std::is_nothrow_move_assignable<Allocator>::value);
+
+    /// Copy assignment.
+    basic_arena_fields& operator=(basic_arena_fields const&);
+
+    /// Copy assignment.
+    template<class OtherAlloc>
+    basic_arena_fields& operator=(basic_arena_fields<OtherAlloc> const&);
+
+public:
+    /// A constant iterator to the field sequence.
+#if BOOST_BEAST_DOXYGEN
+    using const_iterator = __implementation_defined__;
+#else
+    using const_iterator = value_type const*;
+#endif
+
+    /// A constant iterator to the field sequence.
+    using iterator = const_iterator;
+
+    /// Return a copy of the allocator associated with the container.
+    allocator_type
+    get_allocator() const
+    {
+        return this->get();
+    }
+
+    //--------------------------------------------------------------------------
+    //
+    // Element access
+    //
+    //--------------------------------------------------------------------------
+
+    /** Returns the value for a field, or throws an exception.
+
+        If more than one field with the specified name exists, the
+        first field defined by insertion order is returned.
+
+        @param name The name of the field.
+
+        @return The field value.
+
+        @throws std::out_of_range if the field is not found.
+    */
+    string_view const
+    at(field name) const;
+
+    /** Returns the value for a field, or throws an exception.
+
+        If more than one field with the specified name exists, the
+        first field defined by insertion order is returned.
+
+        @param name The name of the field. It is interpreted as a case-insensitive string.
+
+        @return The field value.
+
+        @throws std::out_of_range if the field is not found.
+    */
+    string_view const
+    at(string_view name) const;
+
+    /** Returns the value for a field, or `""` if it does not exist.
+
+        If more than one field with the specified name exists, the
+        first field defined by insertion order is returned.
+
+        @param name The name of the field.
+    */
+    string_view const
+    operator[](field name) const;
+
+    /** Returns the value for a case-insensitive matching header, or `""` if it does not exist.
+
+        If more than one field with the specified name exists, the
+        first field defined by insertion order is returned.
+
+        @param name The name of the field. It is interpreted as a case-insensitive string.
+    */
+    string_view const
+    operator[](string_view name) const;
+
+    //--------------------------------------------------------------------------
+    //
+    // Iterators
+    //
+    //--------------------------------------------------------------------------
+
+    /// Return a const iterator to the beginning of the field sequence.
+    const_iterator
+    begin() const
+    {
+        return list_;
+    }
+
+    /// Return a const iterator to the end of the field sequence.
+    const_iterator
+    end() const
+    {
+        return list_ + size_;
+    }
+
+    /// Return a const iterator to the beginning of the field sequence.
+    const_iterator
+    cbegin() const
+    {
+        return begin();
+    }
+
+    /// Return a const iterator to the end of the field sequence.
+    const_iterator
+    cend() const
+    {
+        return end();
+    }
+
+    //--------------------------------------------------------------------------
+    //
+    // Capacity
+    //
+    //--------------------------------------------------------------------------
+
+    /** Reserve storage for fields.
+
+        After this call the container can hold at least `n` fields
+        whose names, values, and separators add up to `bytes`
+        characters without allocating. The request-target, method,
+        and reason-phrase strings are also kept in this storage.
+
+        @param n The number of fields.
+
+        @param bytes The number of characters. Each field uses the
+        size of its name plus the size of its value plus four.
+    */
+    void
+    reserve(std::size_t n, std::size_t bytes);
+
+    //--------------------------------------------------------------------------
+    //
+    // Modifiers
+    //
+    //--------------------------------------------------------------------------
+
+    /** Remove all fields from the container
+
+        All references, pointers, or iterators referring to contained
+        elements are invalidated. All past-the-end iterators are also
+        invalidated. The storage is kept for use by new fields.
+
+        @par Postconditions:
+        @code
+            std::distance(this->begin(), this->end()) == 0
+        @endcode
+    */
+    void
+    clear();
+
+    /** Insert a field.
+
+        If one or more fields with the same name already exist,
+        the new field will be inserted after the last field with
+        the matching name, in serialization order.
+        The value can be an empty string.
+
+        @param name The field name.
+
+        @param value The field value.
+
+        @throws boost::system::system_error Thrown if an error occurs:
+            @li If the size of @c value exceeds @ref max_value_size, the
+            error code will be @ref error::header_field_value_too_large.
+    */
+    void
+    insert(field name, string_view value);
+
+    void
+    insert(field, std::nullptr_t) = delete;
+
+    /** Insert a field.
+
+        If one or more fields with the same name already exist,
+        the new field will be inserted after the last field with
+        the matching name, in serialization order.
+        The value can be an empty string.
+
+        @param name The field name. It is interpreted as a case-insensitive string.
+
+        @param value The field value.
+
+        @throws boost::system::system_error Thrown if an error occurs:
+            @li If the size of @c name exceeds @ref max_name_size, the
+            error code will be @ref error::header_field_name_too_large.
+            @li If the size of @c value exceeds @ref max_value_size, the
+            error code will be @ref error::header_field_value_too_large.
+    */
+    void
+    insert(string_view name, string_view value);
+
+    void
+    insert(string_view, std::nullptr_t) = delete;
+
+    /** Insert a field.
+
+        If one or more fields with the same name already exist,
+        the new field will be inserted after the last field with
+        the matching name, in serialization order.
+        The value can be an empty string.
+
+        @param name The field name.
+
+        @param name_string The literal text corresponding to the
+        field name. If `name != field::unknown`, then this value
+        must be equal to `to_string(name)` using a case-insensitive
+        comparison, otherwise the behavior is undefined.
+
+        @param value The field value.
+
+        @throws boost::system::system_error Thrown if an error occurs:
+            @li If the size of @c name_string exceeds @ref max_name_size,
+            the error code will be @ref error::header_field_name_too_large.
+            @li If the size of @c value exceeds @ref max_value_size, the
+            error code will be @ref error::header_field_value_too_large.
+    */
+    void
+    insert(field name, string_view name_string,
+        string_view value);
+
+    void
+    insert(field, string_view, std::nullptr_t) = delete;
+
+    /** Insert a field.
+
+        If one or more fields with the same name already exist,
+        the new field will be inserted after the last field with
+        the matching name, in serialization order.
+        The value can be an empty string.
+
+        @param name The field name.
+
+        @param name_string The literal text corresponding to the
+        field name. If `name != field::unknown`, then this value
+        must be equal to `to_string(name)` using a case-insensitive
+        comparison, otherwise the behavior is undefined.
+
+        @param value The field value.
+
+        @param ec Set to indicate what error occurred:
+            @li If the size of @c name_string exceeds @ref max_name_size,
+            the error code will be @ref error::header_field_name_too_large.
+            @li If the size of @c value exceeds @ref max_value_size, the
+            error code will be @ref error::header_field_value_too_large.
+    */
+    void
+    insert(field name, string_view name_string,
+        string_view value, error_code& ec);
+
+    void
+    insert(field, string_view, std::nullptr_t, error_code& ec) = delete;
+
+    /** Set a field value, removing any other instances of that field.
+
+        First removes any values with matching field names, then
+        inserts the new field value. The value may be an empty string.
+
+        @param name The field name.
+
+        @param value The field value.
+
+        @throws boost::system::system_error Thrown if an error occurs:
+            @li If the size of @c value exceeds @ref max_value_size, the
+            error code will be @ref error::header_field_value_too_large.
+    */
+    void
+    set(field name, string_view value);
+
+    void
+    set(field, std::nullptr_t) = delete;
+
+    /** Set a field value, removing any other instances of that field.
+
+        First removes any values with matching field names, then
+        inserts the new field value. The value can be an empty string.
+
+        @param name The field name. It is interpreted as a case-insensitive string.
+
+        @param value The field value.
+
+        @throws boost::system::system_error Thrown if an error occurs:
+            @li If the size of @c name exceeds @ref max_name_size, the
+            error code will be @ref error::header_field_name_too_large.
+            @li If the size of @c value exceeds @ref max_value_size, the
+            error code will be @ref error::header_field_value_too_large.
+    */
+    void
+    set(string_view name, string_view value);
+
+    void
+    set(string_view, std::nullptr_t) = delete;
+
+    /** Remove a field.
+
+        All references and iterators are invalidated.
+
+        @param pos An iterator to the element to remove.
+
+        @return An iterator following the removed element.
+        If the iterator refers to the last element, the end()
+        iterator is returned.
+    */
+    const_iterator
+    erase(const_iterator pos);
+
+    /** Remove all fields with the specified name.
+
+        All fields with the same field name are erased from the
+        container. All references and iterators are invalidated.
+
+        @param name The field name.
+
+        @return The number of fields removed.
+    */
+    std::size_t
+    erase(field name);
+
+    /** Remove all fields with the specified name.
+
+        All fields with the same field name are erased from the
+        container. All references and iterators are invalidated.
+
+        @param name The field name. It is interpreted as a case-insensitive string.
+
+        @return The number of fields removed.
+    */
+    std::size_t
+    erase(string_view name);
+
+    /// Swap this container with another
+    void
+    swap(basic_arena_fields& other);
+
+    /// Swap two field containers
+    template<class Alloc>
+    friend
+    void
+    swap(basic_arena_fields<Alloc>& lhs, basic_arena_fields<Alloc>& rhs);
+
+    //--------------------------------------------------------------------------
+    //
+    // Lookup
+    //
+    //--------------------------------------------------------------------------
+
+    /** Returns `true` if there is a field with the specified name.
+
+        @param name The field name.
+    */
+    bool
+    contains(field name) const;
+
+    /** Returns `true` if there is a field with the specified name.
+
+        @param name The field name. It is interpreted as a case-insensitive string.
+    */
+    bool
+    contains(string_view name) const;
+
+    /** Return the number of fields with the specified name.
+
+        @param name The field name.
+    */
+    std::size_t
+    count(field name) const;
+
+    /** Return the number of fields with the specified name.
+
+        @param name The field name. It is interpreted as a case-insensitive string.
+    */
+    std::size_t
+    count(string_view name) const;
+
+    /** Returns an iterator to the case-insensitive matching field.
+
+        If more than one field with the specified name exists, the
+        first field defined by insertion order is returned.
+
+        @param name The field name.
+
+        @return An iterator to the matching field, or `end()` if
+        no match was found.
+    */
+    const_iterator
+    find(field name) const;
+
+    /** Returns an iterator to the case-insensitive matching field name.
+
+        If more than one field with the specified name exists, the
+        first field defined by insertion order is returned.
+
+        @param name The field name. It is interpreted as a case-insensitive string.
+
+        @return An iterator to the matching field, or `end()` if
+        no match was found.
+    */
+    const_iterator
+    find(string_view name) const;
+
+    /** Returns a range of iterators to the fields with the specified name.
+
+        Fields with the same name are always stored consecutively,
+        in the order they were inserted.
+
+        @param name The field name.
+
+        @return A range of iterators to fields with the same name,
+        otherwise an empty range.
+    */
+    std::pair<const_iterator, const_iterator>
+    equal_range(field name) const;
+
+    /// @copydoc boost::beast::http::basic_arena_fields::equal_range(boost::beast::http::field) const
+    std::pair<const_iterator, const_iterator>
+    equal_range(string_view name) const;
+
+protected:
+    /** Returns the request-method string.
+
+        @note Only called for requests.
+    */
+    string_view
+    get_method_impl() const;
+
+    /** Returns the request-target string.
+
+        @note Only called for requests.
+    */
+    string_view
+    get_target_impl() const;
+
+    /** Returns the response reason-phrase string.
+
+        @note Only called for responses.
+    */
+    string_view
+    get_reason_impl() const;
+
+    /** Returns the chunked Transfer-Encoding setting
+    */
+    bool
+    get_chunked_impl() const;
+
+    /** Returns the keep-alive setting
+    */
+    bool
+    get_keep_alive_impl(unsigned version) const;
+
+    /** Returns `true` if the Content-Length field is present.
+    */
+    bool
+    has_content_length_impl() const;
+
+    /** Set or clear the method string.
+
+        @note Only called for requests.
+    */
+    void
+    set_method_impl(string_view s);
+
+    /** Set or clear the target string.
+
+        @note Only called for requests.
+    */
+    void
+    set_target_impl(string_view s);
+
+    /** Set or clear the reason string.
+
+        @note Only called for responses.
+    */
+    void
+    set_reason_impl(string_view s);
+
+    /** Adjusts the chunked Transfer-Encoding value
+    */
+    void
+    set_chunked_impl(bool value);
+
+    /** Sets or clears the Content-Length field
+    */
+    void
+    set_content_length_impl(
+        boost::optional<std::uint64_t> const& value);
+
+    /** Adjusts the Connection field
+    */
+    void
+    set_keep_alive_impl(
+        unsigned version, bool keep_alive);
+
+private:
+    template<class OtherAlloc>
+    friend class basic_arena_fields;
+
+    static
+    bool
+    matches(
+        value_type const& e,
+        field name,
+        string_view sname) noexcept;
+
+    const_iterator
+    find_impl(field name, string_view sname) const;
+
+    std::size_t
+    erase_impl(field name, string_view sname);
+
+    void
+    insert_impl(
+        field name,
+        string_view sname,
+        string_view value,
+        bool replace,
+        error_code& ec);
+
+    void
+    set_string(string_view& dest,
+        string_view s, bool space);
+
+    void
+    prepare(std::size_t n,
+        std::size_t bytes, block& old);
+
+    void
+    reallocate(std::size_t n,
+        std::size_t bytes, block& old);
+
+    template<class OtherAlloc>
+    void
+    copy_all(basic_arena_fields<OtherAlloc> const&);
+
+    void
+    clear_all();
+
+    void
+    steal(basic_arena_fields& other) noexcept;
+
+    void
+    move_assign(basic_arena_fields&, std::true_type);
+
+    void
+    move_assign(basic_arena_fields&, std::false_type);
+
+    void
+    copy_assign(basic_arena_fields const&, std::true_type);
+
+    void
+    copy_assign(basic_arena_fields const&, std::false_type);
+
+    void
+    swap(basic_arena_fields& other, std::true_type);
+
+    void
+    swap(basic_arena_fields& other, std::false_type);
+
+    void
+    swap_storage(basic_arena_fields& other) noexcept;
+
+    // The block holds the index followed by the characters
+    value_type* list_ = nullptr;
+    char* buf_ = nullptr;
+    std::size_t size_ = 0;      // number of fields
+    std::size_t capacity_ = 0;  // size of the index
+    std::size_t used_ = 0;      // characters used, including erased fields
+    std::size_t buf_size_ = 0;  // size of the character storage
+    std::size_t units_ = 0;     // size of the block, in align_type
+    string_view method_;
+    string_view target_or_reason_;
+};
+
+#if BOOST_BEAST_DOXYGEN
+/// A fields container storing all fields in a single block
+using arena_fields = basic_arena_fields<std::allocator<char>>;
+#endif
+
+} // http
+} // beast
+} // boost
+
+#include <boost/beast/http/impl/arena_fields.hpp>
+
+#endif
@@ -0,0 +1,30 @@
+//
+// Copyright (c) 2016-2019 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/beast
+//
+
+#ifndef BOOST_BEAST_HTTP_ARENA_FIELDS_FWD_HPP
+#define BOOST_BEAST_HTTP_ARENA_FIELDS_FWD_HPP
+
+#include <memory>
+
+namespace boost {
+namespace beast {
+namespace http {
+
+template<class Allocator>
+class basic_arena_fields;
+
+#ifndef BOOST_BEAST_DOXYGEN
+using arena_fields = basic_arena_fields<std::allocator<char>>;
+#endif
+
+} // http
+} // beast
+} // boost
+
+#endif
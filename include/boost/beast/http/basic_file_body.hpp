@@ -27,6 +27,10 @@ namespace boost {
 namespace beast {
 namespace http {
 
+namespace detail {
+struct file_body_access;
+} // detail
+
 //[example_http_file_body_1
 
 /** A message body represented by a file on the filesystem.
@@ -324,6 +328,12 @@ public:
     // or not there may be additional buffers.
     boost::optional<std::pair<const_buffers_type, bool>>
     get(error_code& ec);
+    //<-
+
+#ifndef BOOST_BEAST_DOXYGEN
+    friend struct detail::file_body_access;
+#endif
+    //->
 };
 
 //]
@@ -431,6 +441,35 @@ get(error_code& ec) ->
 
 //]
 
+namespace detail {
+
+// Lets an algorithm send the rest of a file body straight
+// from the file, for example with sendfile. The file is
+// positioned at the first byte not yet returned by `get`,
+// and the remaining count must be lowered by the number
+// of bytes sent that way.
+struct file_body_access
+{
+    template<class Writer>
+    static
+    auto
+    file(Writer& w) noexcept ->
+        decltype(w.body_.file())
+    {
+        return w.body_.file();
+    }
+
+    template<class Writer>
+    static
+    std::uint64_t&
+    remain(Writer& w) noexcept
+    {
+        return w.remain_;
+    }
+};
+
+} // detail
+
 //[example_http_file_body_5
 
 /** Algorithm for storing buffers when parsing.
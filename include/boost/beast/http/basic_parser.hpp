@@ -17,6 +17,7 @@
 #include <boost/beast/http/verb.hpp>
 #include <boost/beast/http/detail/basic_parser.hpp>
 #include <boost/asio/buffer.hpp>
+#include <boost/core/ignore_unused.hpp>
 #include <boost/optional.hpp>
 #include <boost/assert.hpp>
 #include <cstdint>
@@ -74,12 +75,15 @@ class basic_parser
         body_limit_ =
             boost::optional<std::uint64_t>(
                 default_body_limit(is_request{}));   // max payload body
+    boost::optional<std::uint64_t>
+        body_limit0_ = body_limit_;         // configured body limit
     std::uint64_t len_ = 0;                 // size of chunk or body
     std::uint64_t len0_ = 0;                // content length if known
     std::unique_ptr<char[]> buf_;           // temp storage
     std::size_t buf_len_ = 0;               // size of buf_
     std::size_t skip_ = 0;                  // resume search here
     std::uint32_t header_limit_ = 8192;     // max header size
+    std::uint32_t header_limit0_ = 8192;    // configured header limit
     unsigned short status_ = 0;             // response status
     state state_ = state::nothing_yet;      // initial state
     unsigned f_ = 0;                        // flags
@@ -112,6 +116,9 @@ class basic_parser
     static unsigned constexpr flagUpgrade               = 1<< 12;
     static unsigned constexpr flagTransferEncoding      = 1<< 13;
 
+    // Consume nothing until the complete header is present
+    static unsigned constexpr flagWholeHeader           = 1<< 14;
+
     static constexpr
     std::uint64_t
     default_body_limit(std::true_type)
@@ -151,6 +158,62 @@ protected:
     /// Move assignment
     basic_parser& operator=(basic_parser &&) = default;
 
+    /** Prepare the parser for a new message.
+
+        This returns the parser to the state it had upon
+        construction, so that it may parse the next message
+        on the same connection. The body limit, header limit,
+        eager, and whole header options are kept, while the
+        skip option is cleared since it applies to a single
+        message. Storage used to flatten buffer sequences is
+        kept for the next message.
+
+        Derived classes which offer reuse call this function
+        after resetting their own state.
+    */
+    void
+    reset() noexcept;
+
+    /// Returns `true` if the whole header option is set.
+    bool
+    whole_header() const
+    {
+        return (f_ & flagWholeHeader) != 0;
+    }
+
+    /** Set the whole header option.
+
+        Normally the parser consumes the start-line and each field as
+        soon as it is received, so the strings passed to the callbacks
+        for a single header may come from different calls to @ref put.
+        When this option is set, no input is consumed until the
+        complete header is present, and every string passed to
+        @ref on_request_impl, @ref on_response_impl, and
+        @ref on_field_impl refers to the buffer presented in one call
+        to @ref put, except for field values containing obs-fold,
+        which are rewritten. Derived classes use this to refer to the
+        header in place instead of copying it.
+
+        When the buffer sequence presented to @ref put contains more
+        than one buffer, the strings refer to storage owned by the
+        parser which remains valid until the next call to @ref put.
+
+        The default setting is `false`.
+
+        @param v `true` to set the whole header option or `false` to disable it.
+
+        @note This function must called before any bytes are processed.
+    */
+    void
+    whole_header(bool v)
+    {
+        BOOST_ASSERT(! got_some());
+        if(v)
+            f_ |= flagWholeHeader;
+        else
+            f_ &= ~flagWholeHeader;
+    }
+
 public:
     /// `true` if this parser parses requests, `false` for responses.
     using is_request =
@@ -301,6 +364,7 @@ public:
     body_limit(boost::optional<std::uint64_t> v)
     {
         body_limit_ = v;
+        body_limit0_ = v;
     }
 
     /** Set a limit on the total size of the header.
@@ -319,6 +383,7 @@ public:
     header_limit(std::uint32_t v)
     {
         header_limit_ = v;
+        header_limit0_ = v;
     }
 
     /// Returns `true` if the eager parse option is set.
@@ -402,7 +467,10 @@ public:
         message data. If the length of this buffer sequence is
         one, the implementation will not allocate additional memory.
         The class @ref beast::basic_flat_buffer is provided as one way to
-        meet this requirement
+        meet this requirement. Longer sequences are parsed one buffer
+        at a time, copying only a structured element which spans two
+        buffers, unless the input is small or the whole header option
+        is set, in which case it is first copied into a single buffer.
 
         @param ec Set to the error, if any occurred.
 
@@ -439,6 +507,46 @@ public:
     void
     put_eof(error_code& ec);
 
+    /** Return a buffer for receiving body octets directly.
+
+        When the header is complete and the body has a known
+        Content-Length, this function asks the derived class for
+        storage in which up to `size` octets of the body, and no more
+        than the remaining content length, may be placed without
+        first passing through an input buffer. The octets placed in
+        the returned buffer must then be reported by calling
+        @ref commit_body.
+
+        An empty buffer is returned when the message is not in this
+        state, or when the derived class does not provide storage.
+        In this case the body is delivered through @ref put as usual.
+
+        @param size The maximum number of octets wanted.
+
+        @param ec Set to the error, if any occurred.
+
+        @see on_body_prepare_impl
+    */
+    net::mutable_buffer
+    prepare_body(std::size_t size, error_code& ec);
+
+    /** Deliver octets placed in the buffer returned by @ref prepare_body.
+
+        This function must be called once after each successful call
+        to @ref prepare_body which returned a non-empty buffer, before
+        calling any other member function which parses input. This
+        includes the case where no octets were received, so that the
+        derived class may release the storage.
+
+        @param n The number of octets placed at the beginning of the
+        buffer, which may be zero. This may not be greater than the
+        size of the buffer.
+
+        @param ec Set to the error, if any occurred.
+    */
+    void
+    commit_body(std::size_t n, error_code& ec);
+
 protected:
     /** Called after receiving the request-line.
 
@@ -592,6 +700,52 @@ protected:
         string_view body,
         error_code& ec) = 0;
 
+    /** Called to obtain storage for receiving the content body in place.
+
+        This virtual function is invoked by @ref prepare_body when the
+        message has a known Content-Length. The default implementation
+        returns an empty buffer, which causes the body to be delivered
+        through @ref on_body_impl.
+
+        @param size The maximum number of octets to provide storage for.
+        This will not exceed the remaining content length.
+
+        @param ec An output parameter which the function may set to indicate
+        an error. The error will be clear before this function is invoked.
+
+        @return A buffer of at most `size` octets, which may be empty.
+    */
+    virtual
+    net::mutable_buffer
+    on_body_prepare_impl(
+        std::size_t size,
+        error_code& ec)
+    {
+        boost::ignore_unused(size, ec);
+        return {};
+    }
+
+    /** Called when octets are placed in storage from @ref on_body_prepare_impl.
+
+        This virtual function is invoked by @ref commit_body with the
+        number of octets which were placed at the beginning of the
+        buffer last returned by @ref on_body_prepare_impl. The default
+        implementation does nothing.
+
+        @param n The number of octets received.
+
+        @param ec An output parameter which the function may set to indicate
+        an error. The error will be clear before this function is invoked.
+    */
+    virtual
+    void
+    on_body_commit_impl(
+        std::size_t n,
+        error_code& ec)
+    {
+        boost::ignore_unused(n, ec);
+    }
+
     /** Called each time a new chunk header of a chunk encoded body is received.
 
         This function is invoked each time a new chunk header is received.
@@ -665,6 +819,29 @@ private:
         ConstBufferSequence const& buffers,
         error_code& ec);
 
+    template<class ConstBufferSequence>
+    std::size_t
+    put_flat(
+        ConstBufferSequence const& buffers,
+        error_code& ec);
+
+    template<class Iterator>
+    static
+    void
+    copy_joined(
+        char* dest,
+        std::size_t size,
+        net::const_buffer tail,
+        Iterator it);
+
+    template<class Iterator>
+    std::size_t
+    put_joined(
+        std::size_t size,
+        net::const_buffer tail,
+        Iterator it,
+        error_code& ec);
+
     void
     inner_parse_start_line(
         char const*& p, char const* last,
@@ -675,6 +852,11 @@ private:
         char const*& p, char const* last,
             error_code& ec, std::false_type);
 
+    void
+    find_header(
+        char const* p, std::size_t n,
+            error_code& ec);
+
     void
     parse_start_line(
         char const*& p, std::size_t n,
@@ -18,6 +18,7 @@
 #include <boost/beast/http/message.hpp>
 #include <boost/beast/http/type_traits.hpp>
 #include <boost/optional.hpp>
+#include <algorithm>
 #include <cstdint>
 #include <utility>
 
@@ -144,6 +145,31 @@ struct buffer_body
             return bytes_transferred;
         }
 
+        net::mutable_buffer
+        prepare(std::size_t n, error_code& ec)
+        {
+            if(! body_.data)
+            {
+                ec = {};
+                return {};
+            }
+            if(body_.size == 0)
+            {
+                BOOST_BEAST_ASSIGN_EC(ec, error::need_buffer);
+                return {};
+            }
+            ec = {};
+            return net::buffer(body_.data, (std::min)(n, body_.size));
+        }
+
+        void
+        commit(std::size_t n, error_code& ec)
+        {
+            body_.data = static_cast<char*>(body_.data) + n;
+            body_.size -= n;
+            ec = {};
+        }
+
         void
         finish(error_code& ec)
         {
@@ -0,0 +1,57 @@
+//
+// Copyright (c) 2016-2019 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/beast
+//
+
+#ifndef BOOST_BEAST_HTTP_DATE_HPP
+#define BOOST_BEAST_HTTP_DATE_HPP
+
+#include <boost/beast/core/detail/config.hpp>
+#include <boost/beast/core/string.hpp>
+#include <boost/asio/execution_context.hpp>
+
+namespace boost {
+namespace beast {
+namespace http {
+
+/** Return the current date, formatted for the Date field.
+
+    This function returns the current time as an IMF-fixdate
+    (rfc7231), for example `"Sun, 06 Nov 1994 08:49:37 GMT"`.
+    The string is formatted at most once per second for each
+    execution context, and is shared by every caller using the
+    same context, so that servers may set the Date field of each
+    response without formatting the time or allocating memory:
+
+    @code
+    res.set(field::date, current_date(ioc));
+    @endcode
+
+    With @ref prepared_header, where Date is a slot, setting the
+    field copies the characters directly into the rendered header.
+
+    This function may be called concurrently from any thread.
+
+    @param ctx The execution context whose string is returned.
+
+    @return The current date. The string remains valid and
+    unchanged for at least one second, and should be copied
+    into the fields of a message right away.
+*/
+BOOST_BEAST_DECL
+string_view
+current_date(net::execution_context& ctx);
+
+} // http
+} // beast
+} // boost
+
+#ifdef BOOST_BEAST_HEADER_ONLY
+#include <boost/beast/http/impl/date.ipp>
+#endif
+
+#endif
@@ -109,6 +109,12 @@ struct basic_parser_base
         char const* it, char const* last,
             error_code& ec);
 
+    // Returns one past the first empty line, or nullptr
+    BOOST_BEAST_DECL
+    static
+    char const*
+    find_eom(char const* p, char const* last);
+
     //--------------------------------------------------------------------------
 
     BOOST_BEAST_DECL
@@ -11,6 +11,8 @@
 #define BOOST_BEAST_HTTP_DETAIL_BASIC_PARSER_IPP
 
 #include <boost/beast/http/detail/basic_parser.hpp>
+#include <boost/beast/core/detail/char_scan.hpp>
+#include <cstring>
 #include <limits>
 
 namespace boost {
@@ -112,44 +114,51 @@ find_fast(
     char const* ranges,
     size_t ranges_size)
 {
-    bool found = false;
-    boost::ignore_unused(buf_end, ranges, ranges_size);
-    return {buf, found};
+    if(buf >= buf_end)
+        return {buf, false};
+    auto const p = beast::detail::char_scan::find_ranges(
+        buf, buf_end, ranges, ranges_size);
+    return {p, p != buf_end};
 }
 
-// VFALCO Can SIMD help this?
 char const*
 basic_parser_base::
 find_eol(
     char const* it, char const* last,
         error_code& ec)
 {
-    for(;;)
+    // VFALCO Should we handle the legacy case
+    // for lines terminated with a single '\n'?
+    if(it < last)
+        it = static_cast<char const*>(std::memchr(
+            it, '\r', static_cast<std::size_t>(last - it)));
+    else
+        it = nullptr;
+    if(! it || ++it == last)
     {
-        if(it == last)
-        {
-            ec = {};
-            return nullptr;
-        }
-        if(*it == '\r')
-        {
-            if(++it == last)
-            {
-                ec = {};
-                return nullptr;
-            }
-            if(*it != '\n')
-            {
-                BOOST_BEAST_ASSIGN_EC(ec, error::bad_line_ending);
-                return nullptr;
-            }
-            ec = {};
-            return ++it;
-        }
-        // VFALCO Should we handle the legacy case
-        // for lines terminated with a single '\n'?
-        ++it;
+        ec = {};
+        return nullptr;
+    }
+    if(*it != '\n')
+    {
+        BOOST_BEAST_ASSIGN_EC(ec, error::bad_line_ending);
+        return nullptr;
     }
+    ec = {};
+    return ++it;
+}
+
+char const*
+basic_parser_base::
+find_eom(char const* p, char const* last)
+{
+    if(p >= last)
+        return nullptr;
+    auto const it =
+        beast::detail::char_scan::find_crlfcrlf(p, last);
+    if(it == last)
+        return nullptr;
+    return it + 4;
 }
 
 bool
@@ -211,6 +220,12 @@ parse_token_to_eol(
     char const*& token_last,
     error_code& ec)
 {
+    // CTL except HTAB
+    BOOST_ALIGNMENT(16) static const char ranges[] =
+        "\x00\x08"  /* control chars before HTAB */
+        "\x0a\x1f"  /* control chars after HTAB */
+        "\x7f\x7f"; /* DEL */
+    p = find_fast(p, last, ranges, sizeof(ranges)-1).first;
     for(;; ++p)
     {
         if(p >= last)
@@ -311,7 +326,11 @@ parse_target(
     string_view& result, error_code& ec)
 {
     // parse target SP
+    BOOST_ALIGNMENT(16) static const char ranges[] =
+        "\x00 "     /* control chars and up to SP */
+        "\x7f\x7f"; /* DEL */
     auto const first = it;
+    it = find_fast(it, last, ranges, sizeof(ranges)-1).first;
     for(;; ++it)
     {
         if(it + 1 > last)
@@ -0,0 +1,73 @@
+//
+// Copyright (c) 2016-2019 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/beast
+//
+
+#ifndef BOOST_BEAST_HTTP_DETAIL_DATE_SERVICE_HPP
+#define BOOST_BEAST_HTTP_DETAIL_DATE_SERVICE_HPP
+
+#include <boost/beast/core/string.hpp>
+#include <boost/beast/core/detail/service_base.hpp>
+#include <boost/asio/execution_context.hpp>
+#include <atomic>
+#include <cstdint>
+#include <ctime>
+#include <mutex>
+
+namespace boost {
+namespace beast {
+namespace http {
+namespace detail {
+
+/*  Write `t` as an IMF-fixdate (rfc7231), for example
+    "Sun, 06 Nov 1994 08:49:37 GMT", to the 29 characters
+    at `dest`. The result does not depend on the locale
+    or time zone, and nothing is allocated.
+*/
+BOOST_BEAST_DECL
+void
+format_date(char* dest, std::time_t t) noexcept;
+
+/*  Holds the Date field value for the current second,
+    shared by everything using the execution context.
+
+    The string for a second is formatted once, by the first
+    caller to ask for it. Strings alternate between two
+    buffers, so a string returned for one second is not
+    overwritten until the second after next.
+*/
+class date_service
+    : public beast::detail::service_base<date_service>
+{
+    std::mutex m_;
+    std::atomic<std::int64_t> now_;
+    char buf_[2][29];
+
+    BOOST_BEAST_DECL
+    void
+    shutdown() override;
+
+public:
+    BOOST_BEAST_DECL
+    explicit
+    date_service(net::execution_context& ctx);
+
+    BOOST_BEAST_DECL
+    string_view
+    get(std::time_t now);
+};
+
+} // detail
+} // http
+} // beast
+} // boost
+
+#if BOOST_BEAST_HEADER_ONLY
+#include <boost/beast/http/detail/date_service.ipp>
+#endif
+
+#endif
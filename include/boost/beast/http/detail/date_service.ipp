@@ -0,0 +1,120 @@
+//
+// Copyright (c) 2016-2019 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/beast
+//
+
+#ifndef BOOST_BEAST_HTTP_DETAIL_DATE_SERVICE_IPP
+#define BOOST_BEAST_HTTP_DETAIL_DATE_SERVICE_IPP
+
+#include <boost/beast/http/detail/date_service.hpp>
+#include <cstring>
+#include <limits>
+
+namespace boost {
+namespace beast {
+namespace http {
+namespace detail {
+
+void
+format_date(char* dest, std::time_t t) noexcept
+{
+    static char const days[] = "ThuFriSatSunMonTueWed";
+    static char const months[] = "MarAprMayJunJulAugSepOctNovDecJanFeb";
+
+    auto const digits2 =
+        [](char* p, std::int64_t v)
+        {
+            p[0] = '0' + static_cast<char>(v / 10);
+            p[1] = '0' + static_cast<char>(v % 10);
+        };
+
+    // Days since 1970-01-01, which was a Thursday
+    auto const secs = static_cast<std::int64_t>(t);
+    auto z = secs / 86400;
+    auto sod = secs % 86400;
+    if(sod < 0)
+    {
+        sod += 86400;
+        --z;
+    }
+    auto wd = z % 7;
+    if(wd < 0)
+        wd += 7;
+
+    // Civil date from the day count, with years starting in March
+    z += 719468;
+    auto const era = (z >= 0 ? z : z - 146096) / 146097;
+    auto const doe = z - era * 146097;
+    auto const yoe =
+        (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    auto const doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    auto const mp = (5 * doy + 2) / 153;
+    auto const d = doy - (153 * mp + 2) / 5 + 1;
+    auto y = yoe + era * 400 + (mp >= 10 ? 1 : 0);
+    if(y < 0)
+        y = 0;
+    else if(y > 9999)
+        y = 9999;
+
+    // "Sun, 06 Nov 1994 08:49:37 GMT"
+    std::memcpy(dest, days + 3 * wd, 3);
+    dest[3] = ',';
+    dest[4] = ' ';
+    digits2(dest + 5, d);
+    dest[7] = ' ';
+    std::memcpy(dest + 8, months + 3 * mp, 3);
+    dest[11] = ' ';
+    digits2(dest + 12, y / 100);
+    digits2(dest + 14, y % 100);
+    dest[16] = ' ';
+    digits2(dest + 17, sod / 3600);
+    dest[19] = ':';
+    digits2(dest + 20, (sod / 60) % 60);
+    dest[22] = ':';
+    digits2(dest + 23, sod % 60);
+    std::memcpy(dest + 25, " GMT", 4);
+}
+
+date_service::
+date_service(net::execution_context& ctx)
+    : beast::detail::service_base<date_service>(ctx)
+    , now_((std::numeric_limits<std::int64_t>::min)())
+{
+}
+
+void
+date_service::
+shutdown()
+{
+}
+
+string_view
+date_service::
+get(std::time_t now)
+{
+    auto const t = static_cast<std::int64_t>(now);
+    auto s = now_.load(std::memory_order_acquire);
+    if(s < t)
+    {
+        std::lock_guard<std::mutex> g(m_);
+        s = now_.load(std::memory_order_relaxed);
+        if(s < t)
+        {
+            format_date(buf_[static_cast<std::uint64_t>(t) & 1], now);
+            now_.store(t, std::memory_order_release);
+            s = t;
+        }
+    }
+    return {buf_[static_cast<std::uint64_t>(s) & 1], 29};
+}
+
+} // detail
+} // http
+} // beast
+} // boost
+
+#endif
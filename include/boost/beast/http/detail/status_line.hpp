@@ -0,0 +1,52 @@
+//
+// Copyright (c) 2016-2019 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/beast
+//
+
+#ifndef BOOST_BEAST_HTTP_DETAIL_STATUS_LINE_HPP
+#define BOOST_BEAST_HTTP_DETAIL_STATUS_LINE_HPP
+
+#include <boost/beast/core/string.hpp>
+
+namespace boost {
+namespace beast {
+namespace http {
+namespace detail {
+
+/*  Return a pre-rendered status line.
+
+    The returned string has the form "HTTP/1.1 200 OK\r\n",
+    using the reason phrase from `obsolete_reason`. Lines
+    exist for HTTP/1.0 and HTTP/1.1 and every status code
+    known to `int_to_status`; for any other combination
+    an empty string is returned and the caller is expected
+    to format the line itself. The strings have static
+    storage duration.
+*/
+BOOST_BEAST_DECL
+string_view
+status_line(unsigned version, unsigned code) noexcept;
+
+/*  Return a pre-rendered request line suffix.
+
+    The returned string is " HTTP/1.1\r\n" or " HTTP/1.0\r\n",
+    or empty if the version is neither.
+*/
+BOOST_BEAST_DECL
+string_view
+request_line_suffix(unsigned version) noexcept;
+
+} // detail
+} // http
+} // beast
+} // boost
+
+#if BOOST_BEAST_HEADER_ONLY
+#include <boost/beast/http/detail/status_line.ipp>
+#endif
+
+#endif
@@ -0,0 +1,124 @@
+//
+// Copyright (c) 2016-2019 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/beast
+//
+
+#ifndef BOOST_BEAST_HTTP_DETAIL_STATUS_LINE_IPP
+#define BOOST_BEAST_HTTP_DETAIL_STATUS_LINE_IPP
+
+#include <boost/beast/http/detail/status_line.hpp>
+#include <boost/beast/http/status.hpp>
+#include <boost/assert.hpp>
+#include <cstdint>
+#include <cstring>
+
+namespace boost {
+namespace beast {
+namespace http {
+namespace detail {
+
+// Every line is rendered into one block of storage
+// when the table is first used, which keeps the lines
+// for the common codes close together in memory.
+class status_line_table
+{
+    static unsigned constexpr first_code = 100;
+    static unsigned constexpr last_code = 599;
+    static std::size_t constexpr max_size = 8192;
+
+    struct entry
+    {
+        std::uint16_t offset = 0;
+        std::uint16_t size = 0;
+    };
+
+    entry lines_[2][last_code - first_code + 1];
+    char buf_[max_size];
+
+    static
+    char*
+    render(
+        char* p,
+        unsigned version,
+        unsigned code,
+        string_view reason) noexcept
+    {
+        std::memcpy(p, "HTTP/1.", 7);
+        p[7] = static_cast<char>('0' + version % 10);
+        p[8] = ' ';
+        p[9] = static_cast<char>('0' + code / 100);
+        p[10]= static_cast<char>('0' + (code / 10) % 10);
+        p[11]= static_cast<char>('0' + code % 10);
+        p[12]= ' ';
+        p += 13;
+        std::memcpy(p, reason.data(), reason.size());
+        p += reason.size();
+        p[0] = '\r';
+        p[1] = '\n';
+        return p + 2;
+    }
+
+public:
+    status_line_table() noexcept
+    {
+        std::size_t n = 0;
+        for(unsigned code = first_code; code <= last_code; ++code)
+        {
+            auto const s = int_to_status(code);
+            if(s == status::unknown)
+                continue;
+            auto const reason = obsolete_reason(s);
+            for(unsigned v = 0; v < 2; ++v)
+            {
+                auto const size = 15 + reason.size();
+                BOOST_ASSERT(n + size <= max_size);
+                render(buf_ + n, 10 + v, code, reason);
+                auto& e = lines_[v][code - first_code];
+                e.offset = static_cast<std::uint16_t>(n);
+                e.size = static_cast<std::uint16_t>(size);
+                n += size;
+            }
+        }
+    }
+
+    string_view
+    get(unsigned version, unsigned code) const noexcept
+    {
+        if( (version != 10 && version != 11) ||
+            code < first_code || code > last_code)
+            return {};
+        auto const& e = lines_[version - 10][code - first_code];
+        return { buf_ + e.offset, e.size };
+    }
+};
+
+string_view
+status_line(unsigned version, unsigned code) noexcept
+{
+    static status_line_table const tab;
+    return tab.get(version, code);
+}
+
+string_view
+request_line_suffix(unsigned version) noexcept
+{
+    switch(version)
+    {
+    case 10: return { " HTTP/1.0\r\n", 11 };
+    case 11: return { " HTTP/1.1\r\n", 11 };
+    default:
+        break;
+    }
+    return {};
+}
+
+} // detail
+} // http
+} // beast
+} // boost
+
+#endif
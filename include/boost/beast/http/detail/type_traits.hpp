@@ -10,9 +10,12 @@
 #ifndef BOOST_BEAST_HTTP_DETAIL_TYPE_TRAITS_HPP
 #define BOOST_BEAST_HTTP_DETAIL_TYPE_TRAITS_HPP
 
+#include <boost/beast/core/error.hpp>
 #include <boost/beast/core/detail/type_traits.hpp>
+#include <boost/beast/http/fields_fwd.hpp>
 #include <boost/beast/http/message_fwd.hpp>
 #include <boost/beast/http/parser_fwd.hpp>
+#include <boost/asio/buffer.hpp>
 #include <boost/optional.hpp>
 #include <cstdint>
 
@@ -88,6 +91,50 @@ struct is_body_sized<T, beast::detail::void_t<
         T::size(std::declval<typename T::value_type const&>())
     )>> : std::true_type {};
 
+// The fields container used by parser. A Fields type,
+// recognized by its nested writer, is used as-is while
+// anything else is the allocator for basic_fields.
+template<class T, class = void>
+struct parser_fields
+{
+    using type = basic_fields<T>;
+};
+
+template<class T>
+struct parser_fields<T, beast::detail::void_t<
+    typename T::writer>>
+{
+    using type = T;
+};
+
+// `true` if the body value has a `clear` member,
+// which empties it without releasing storage.
+template<class T, class = void>
+struct is_body_clearable : std::false_type {};
+
+template<class T>
+struct is_body_clearable<T, beast::detail::void_t<
+    decltype(std::declval<T&>().clear())
+        >> : std::true_type {};
+
+// `true` if the body reader has `prepare` and `commit`
+// members, through which body octets are received
+// directly into the body.
+template<class T, class = void>
+struct is_body_reader_preparable : std::false_type {};
+
+template<class T>
+struct is_body_reader_preparable<T, beast::detail::void_t<
+    decltype(
+        std::declval<net::mutable_buffer&>() =
+            std::declval<T&>().prepare(
+                std::declval<std::size_t>(),
+                std::declval<error_code&>()),
+        std::declval<T&>().commit(
+            std::declval<std::size_t>(),
+            std::declval<error_code&>())
+    )>> : std::true_type {};
+
 template<class T>
 struct is_fields_helper : T
 {
@@ -737,6 +737,38 @@ public:
         return key_compare{};
     }
 
+    /// Returns `true` if the contiguous header option is set.
+    bool
+    contiguous_header() const noexcept
+    {
+        return contiguous_;
+    }
+
+    /** Set the contiguous header option.
+
+        Normally the @ref writer presents the serialized header as a
+        buffer sequence referring to the start-line and to each field
+        in place, so that writing a header with many fields passes
+        many small buffers to the stream. When this option is set,
+        the writer renders the start-line and all of the fields into
+        one buffer owned by the container and allocated with its
+        allocator. The rendering is reused by subsequent writers until
+        the fields, method, target, or reason are modified, or the
+        start-line is rendered with a different version, method, or
+        status.
+
+        Since creating a writer may update the rendering, a container
+        with this option set must not be serialized concurrently,
+        even through a `const` reference.
+
+        The default setting is `false`.
+
+        @param v `true` to set the option or `false` to clear it and
+        release the rendering.
+    */
+    void
+    contiguous_header(bool v);
+
 protected:
     /** Returns the request-method string.
 
@@ -873,10 +905,46 @@ private:
     void
     swap(basic_fields& other, std::false_type);
 
+    bool
+    is_rendered(unsigned version, unsigned line) const noexcept
+    {
+        return rendered_size_ != 0 &&
+            rendered_version_ == version &&
+            rendered_line_ == line;
+    }
+
+    template<class ConstBufferSequence>
+    void
+    render(ConstBufferSequence const& buffers,
+        unsigned version, unsigned line) const;
+
+    void
+    invalidate() noexcept
+    {
+        rendered_size_ = 0;
+    }
+
+    void
+    release_rendered() noexcept;
+
+    void
+    take_rendered(basic_fields& other) noexcept;
+
     set_t set_;
     list_t list_;
     string_view method_;
     string_view target_or_reason_;
+
+    // The header rendered by the writer when the contiguous
+    // header option is set. A size of zero means the rendering
+    // is stale. The line identifies the method or status which
+    // was rendered.
+    mutable char* rendered_ = nullptr;
+    mutable std::size_t rendered_size_ = 0;
+    mutable std::size_t rendered_capacity_ = 0;
+    mutable unsigned rendered_version_ = 0;
+    mutable unsigned rendered_line_ = 0;
+    bool contiguous_ = false;
 };
 
 #if BOOST_BEAST_DOXYGEN
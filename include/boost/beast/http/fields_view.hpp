@@ -0,0 +1,381 @@
+//
+// Copyright (c) 2016-2019 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/beast
+//
+
+#ifndef BOOST_BEAST_HTTP_FIELDS_VIEW_HPP
+#define BOOST_BEAST_HTTP_FIELDS_VIEW_HPP
+
+#include <boost/beast/http/fields_view_fwd.hpp>
+
+#include <boost/beast/core/detail/allocator.hpp>
+#include <boost/beast/core/detail/config.hpp>
+#include <boost/beast/core/string.hpp>
+#include <boost/beast/http/field.hpp>
+#include <forward_list>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace boost {
+namespace beast {
+namespace http {
+
+/** A read-only view of the fields in a parsed HTTP header.
+
+    This container offers the same interface as @ref basic_fields for
+    looking up and iterating fields, but it does not own the characters
+    of the field names and values. Each element refers directly to the
+    bytes of the header in the buffer it was parsed from, so the view
+    is only valid for as long as those bytes are neither modified,
+    moved, nor freed. The only characters owned by the container are
+    the values of fields which were folded across lines using the
+    obsolete line folding syntax, which must be rewritten.
+
+    A view is filled in by @ref header_view_parser. Copies of a view
+    refer to the same characters as the original.
+
+    Field names are stored as-is, but comparisons are case-insensitive.
+    When the container is iterated the fields are presented in the order
+    they appeared in the header, with fields having the same name
+    following each other consecutively.
+
+    @tparam Allocator The allocator used for the index of fields.
+*/
+template<class Allocator>
+class basic_fields_view
+{
+public:
+    /// The type of allocator used.
+    using allocator_type = Allocator;
+
+    /// The type of element used to represent a field
+    class value_type
+    {
+#ifndef BOOST_BEAST_DOXYGEN
+        template<class OtherAlloc>
+        friend class basic_fields_view;
+#endif
+
+        string_view name_;
+        string_view value_;
+        field f_;
+
+        value_type(field f,
+            string_view name, string_view value);
+
+    public:
+        /// Returns the field enum, which can be @ref boost::beast::http::field::unknown
+        field
+        name() const;
+
+        /// Returns the field name as a string
+        string_view const
+        name_string() const;
+
+        /// Returns the value of the field
+        string_view const
+        value() const;
+    };
+
+private:
+    using list_alloc_type = typename
+        beast::detail::allocator_traits<Allocator>::
+            template rebind_alloc<value_type>;
+
+    using char_alloc_type = typename
+        beast::detail::allocator_traits<Allocator>::
+            template rebind_alloc<char>;
+
+    using string_type = std::basic_string<
+        char, std::char_traits<char>, char_alloc_type>;
+
+    using spill_alloc_type = typename
+        beast::detail::allocator_traits<Allocator>::
+            template rebind_alloc<string_type>;
+
+    template<bool, class>
+    friend class header_view_parser;
+
+    std::vector<value_type, list_alloc_type> list_;
+    std::forward_list<string_type, spill_alloc_type> spill_;
+
+public:
+    /// A constant iterator to the field sequence.
+#if BOOST_BEAST_DOXYGEN
+    using const_iterator = __implementation_defined__;
+#else
+    using const_iterator = value_type const*;
+#endif
+
+    /// A constant iterator to the field sequence.
+    using iterator = const_iterator;
+
+    /// Constructor.
+    basic_fields_view() = default;
+
+    /** Constructor.
+
+        @param alloc The allocator to use.
+    */
+    explicit
+    basic_fields_view(Allocator const& alloc);
+
+    /// Copy constructor.
+    basic_fields_view(basic_fields_view const&) = default;
+
+    /// Move constructor.
+    basic_fields_view(basic_fields_view&&) = default;
+
+    /// Copy assignment.
+    basic_fields_view& operator=(basic_fields_view const&) = default;
+
+    /// Move assignment.
+    basic_fields_view& operator=(basic_fields_view&&) = default;
+
+    /// Return a copy of the allocator associated with the container.
+    allocator_type
+    get_allocator() const
+    {
+        return allocator_type(list_.get_allocator());
+    }
+
+    //--------------------------------------------------------------------------
+    //
+    // Element access
+    //
+    //--------------------------------------------------------------------------
+
+    /** Returns the value for a field, or throws an exception.
+
+        If more than one field with the specified name exists, the
+        first field in the header is returned.
+
+        @param name The name of the field.
+
+        @return The field value.
+
+        @throws std::out_of_range if the field is not found.
+    */
+    string_view const
+    at(field name) const;
+
+    /** Returns the value for a field, or throws an exception.
+
+        If more than one field with the specified name exists, the
+        first field in the header is returned.
+
+        @param name The name of the field. It is interpreted as a case-insensitive string.
+
+        @return The field value.
+
+        @throws std::out_of_range if the field is not found.
+    */
+    string_view const
+    at(string_view name) const;
+
+    /** Returns the value for a field, or `""` if it does not exist.
+
+        If more than one field with the specified name exists, the
+        first field in the header is returned.
+
+        @param name The name of the field.
+    */
+    string_view const
+    operator[](field name) const;
+
+    /** Returns the value for a case-insensitive matching header, or `""` if it does not exist.
+
+        If more than one field with the specified name exists, the
+        first field in the header is returned.
+
+        @param name The name of the field. It is interpreted as a case-insensitive string.
+    */
+    string_view const
+    operator[](string_view name) const;
+
+    //--------------------------------------------------------------------------
+    //
+    // Iterators
+    //
+    //--------------------------------------------------------------------------
+
+    /// Return a const iterator to the beginning of the field sequence.
+    const_iterator
+    begin() const
+    {
+        return list_.data();
+    }
+
+    /// Return a const iterator to the end of the field sequence.
+    const_iterator
+    end() const
+    {
+        return list_.data() + list_.size();
+    }
+
+    /// Return a const iterator to the beginning of the field sequence.
+    const_iterator
+    cbegin() const
+    {
+        return begin();
+    }
+
+    /// Return a const iterator to the end of the field sequence.
+    const_iterator
+    cend() const
+    {
+        return end();
+    }
+
+    //--------------------------------------------------------------------------
+    //
+    // Capacity
+    //
+    //--------------------------------------------------------------------------
+
+    /// Returns `true` if there are no fields.
+    bool
+    empty() const noexcept
+    {
+        return list_.empty();
+    }
+
+    /// Returns the number of fields.
+    std::size_t
+    size() const noexcept
+    {
+        return list_.size();
+    }
+
+    //--------------------------------------------------------------------------
+    //
+    // Modifiers
+    //
+    //--------------------------------------------------------------------------
+
+    /** Remove all fields from the view.
+
+        Storage for the index is retained, so that a view
+        which is filled again does not need to allocate.
+    */
+    void
+    clear() noexcept;
+
+    /// Swap this view with another view.
+    void
+    swap(basic_fields_view& other);
+
+    /// Swap two views.
+    template<class Alloc>
+    friend
+    void
+    swap(basic_fields_view<Alloc>& lhs, basic_fields_view<Alloc>& rhs);
+
+    //--------------------------------------------------------------------------
+    //
+    // Lookup
+    //
+    //--------------------------------------------------------------------------
+
+    /** Return the number of fields with the specified name.
+
+        @param name The field name.
+    */
+    std::size_t
+    count(field name) const;
+
+    /** Return the number of fields with the specified name.
+
+        @param name The field name. It is interpreted as a case-insensitive string.
+    */
+    std::size_t
+    count(string_view name) const;
+
+    /** Returns `true` if the specified field exists.
+
+        @param name The field name.
+    */
+    bool
+    contains(field name) const;
+
+    /** Returns `true` if the specified field exists.
+
+        @param name The field name. It is interpreted as a case-insensitive string.
+    */
+    bool
+    contains(string_view name) const;
+
+    /** Returns an iterator to the case-insensitive matching field.
+
+        If more than one field with the specified name exists, the
+        first field in the header is returned.
+
+        @param name The field name.
+
+        @return An iterator to the matching field, or `end()` if
+        no match was found.
+    */
+    const_iterator
+    find(field name) const;
+
+    /** Returns an iterator to the case-insensitive matching field name.
+
+        If more than one field with the specified name exists, the
+        first field in the header is returned.
+
+        @param name The field name. It is interpreted as a case-insensitive string.
+
+        @return An iterator to the matching field, or `end()` if
+        no match was found.
+    */
+    const_iterator
+    find(string_view name) const;
+
+    /** Returns a range of iterators to the fields with the specified name.
+
+        Fields with the same name are always stored consecutively,
+        in the order they appeared in the header.
+
+        @param name The field name.
+
+        @return A range of iterators to fields with the same name,
+        otherwise an empty range.
+    */
+    std::pair<const_iterator, const_iterator>
+    equal_range(field name) const;
+
+    /// @copydoc boost::beast::http::basic_fields_view::equal_range(boost::beast::http::field) const
+    std::pair<const_iterator, const_iterator>
+    equal_range(string_view name) const;
+
+private:
+    static
+    bool
+    matches(
+        value_type const& e,
+        field name,
+        string_view sname) noexcept;
+
+    const_iterator
+    find_impl(field name, string_view sname) const;
+
+    void
+    insert(field name, string_view sname, string_view value);
+
+    void
+    insert_copy(field name, string_view sname, string_view value);
+};
+
+} // http
+} // beast
+} // boost
+
+#include <boost/beast/http/impl/fields_view.hpp>
+
+#endif
@@ -0,0 +1,323 @@
+//
+// Copyright (c) 2016-2019 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/beast
+//
+
+#ifndef BOOST_BEAST_HTTP_HEADER_VIEW_PARSER_HPP
+#define BOOST_BEAST_HTTP_HEADER_VIEW_PARSER_HPP
+
+#include <boost/beast/core/detail/config.hpp>
+#include <boost/beast/http/basic_parser.hpp>
+#include <boost/beast/http/fields_view.hpp>
+#include <boost/beast/http/status.hpp>
+#include <boost/beast/http/verb.hpp>
+#include <boost/assert.hpp>
+#include <boost/core/detail/static_assert.hpp>
+#include <cstdint>
+#include <memory>
+
+namespace boost {
+namespace beast {
+namespace http {
+
+/** An HTTP/1 parser which refers to the header in place.
+
+    This class uses the basic HTTP/1 wire format parser to parse a
+    header without copying it. The method, target, reason, and every
+    field name and value are presented as strings referring to the
+    bytes of the input, and the fields are made available through a
+    @ref basic_fields_view, which offers the same lookup and iteration
+    interface as @ref basic_fields.
+
+    The parser sets the whole header option of @ref basic_parser, so
+    no input is consumed until the complete header is present. The
+    strings refer to the buffer presented in the call to @ref put which
+    completed the header, and remain valid for as long as the caller
+    leaves those bytes in place. When reading with @ref read_header
+    into a @ref beast::basic_flat_buffer, this holds until the buffer
+    is next modified, including any read which prepares more space.
+    Field values using the obsolete line folding syntax are rewritten,
+    and stored by the view.
+
+    Body octets are not stored. Callers typically stop once the header
+    is done and forward or handle the body themselves; any body octets
+    which are parsed are discarded, as are the fields of a trailer.
+
+    @tparam isRequest Indicates whether a request or response
+    will be parsed.
+
+    @tparam Allocator The type of allocator used by the
+    @ref basic_fields_view for its index of fields.
+
+    @note To parse another message, call @ref reset
+    or construct a new instance of the parser.
+*/
+template<
+    bool isRequest,
+    class Allocator = std::allocator<char>>
+class header_view_parser
+    : public basic_parser<isRequest>
+{
+    basic_fields_view<Allocator> fields_;
+    string_view method_or_reason_;
+    string_view target_;
+    verb method_ = verb::unknown;
+    unsigned result_ = 0;
+    unsigned version_ = 0;
+
+public:
+    /// The type of the container used to view the fields
+    using fields_type = basic_fields_view<Allocator>;
+
+    /// Destructor
+    ~header_view_parser() = default;
+
+    /// Constructor (disallowed)
+    header_view_parser(header_view_parser const&) = delete;
+
+    /// Assignment (disallowed)
+    header_view_parser& operator=(header_view_parser const&) = delete;
+
+    /// Constructor
+    header_view_parser()
+    {
+        this->whole_header(true);
+    }
+
+    /** Constructor
+
+        @param alloc The allocator to use for the index of fields.
+    */
+    explicit
+    header_view_parser(Allocator const& alloc)
+        : fields_(alloc)
+    {
+        this->whole_header(true);
+    }
+
+    /** Prepare the parser for the next message.
+
+        The view of the fields is cleared, keeping its storage,
+        and the parser returns to its initial state. Strings
+        from the previous header are no longer available.
+    */
+    void
+    reset() noexcept
+    {
+        fields_.clear();
+        method_or_reason_ = {};
+        target_ = {};
+        method_ = verb::unknown;
+        result_ = 0;
+        version_ = 0;
+        basic_parser<isRequest>::reset();
+    }
+
+    /// Returns the fields of the parsed header.
+    fields_type const&
+    fields() const noexcept
+    {
+        return fields_;
+    }
+
+    /** Returns the HTTP-version.
+
+        The value is 10 for HTTP/1.0 and 11 for HTTP/1.1.
+    */
+    unsigned
+    version() const noexcept
+    {
+        return version_;
+    }
+
+    /** Returns the request-method verb.
+
+        If the request-method is not one of the recognized verbs,
+        @ref verb::unknown is returned. Callers may use
+        @ref method_string to retrieve the exact text.
+
+        @note This function is only available when `isRequest == true`.
+    */
+    verb
+    method() const noexcept
+    {
+        BOOST_CORE_STATIC_ASSERT(isRequest);
+        return method_;
+    }
+
+    /** Returns the request-method as a string.
+
+        @note This function is only available when `isRequest == true`.
+    */
+    string_view
+    method_string() const noexcept
+    {
+        BOOST_CORE_STATIC_ASSERT(isRequest);
+        return method_or_reason_;
+    }
+
+    /** Returns the request-target string.
+
+        @note This function is only available when `isRequest == true`.
+    */
+    string_view
+    target() const noexcept
+    {
+        BOOST_CORE_STATIC_ASSERT(isRequest);
+        return target_;
+    }
+
+    /** The response status-code result.
+
+        If the actual status code is not a known code, this
+        function returns @ref status::unknown. Use @ref result_int
+        to return the raw status code as a number.
+
+        @note This function is only available when `isRequest == false`.
+    */
+    status
+    result() const noexcept
+    {
+        BOOST_CORE_STATIC_ASSERT(! isRequest);
+        return int_to_status(result_);
+    }
+
+    /** The response status-code expressed as an integer.
+
+        @note This function is only available when `isRequest == false`.
+    */
+    unsigned
+    result_int() const noexcept
+    {
+        BOOST_CORE_STATIC_ASSERT(! isRequest);
+        return result_;
+    }
+
+    /** Returns the response reason-phrase.
+
+        @note This function is only available when `isRequest == false`.
+    */
+    string_view
+    reason() const noexcept
+    {
+        BOOST_CORE_STATIC_ASSERT(! isRequest);
+        return method_or_reason_;
+    }
+
+private:
+    // Returns `true` if `value` lies in the input right after the
+    // colon following `name`, which is the case unless it was
+    // rewritten from obs-fold. The scan stops at the first byte
+    // which is not whitespace, so it never leaves the field line.
+    static
+    bool
+    in_place(string_view name, string_view value) noexcept
+    {
+        auto p = name.data() + name.size();
+        BOOST_ASSERT(*p == ':');
+        ++p;
+        while(p != value.data() && (*p == ' ' || *p == '\t'))
+            ++p;
+        return p == value.data();
+    }
+
+    void
+    on_request_impl(
+        verb method,
+        string_view method_str,
+        string_view target,
+        int version,
+        error_code&) override
+    {
+        method_ = method;
+        method_or_reason_ = method_str;
+        target_ = target;
+        version_ = static_cast<unsigned>(version);
+    }
+
+    void
+    on_response_impl(
+        int code,
+        string_view reason,
+        int version,
+        error_code&) override
+    {
+        result_ = static_cast<unsigned>(code);
+        method_or_reason_ = reason;
+        version_ = static_cast<unsigned>(version);
+    }
+
+    void
+    on_field_impl(
+        field name,
+        string_view name_string,
+        string_view value,
+        error_code&) override
+    {
+        if(in_place(name_string, value))
+            fields_.insert(name, name_string, value);
+        else
+            fields_.insert_copy(name, name_string, value);
+    }
+
+    void
+    on_trailer_field_impl(
+        field,
+        string_view,
+        string_view,
+        error_code&) override
+    {
+    }
+
+    void
+    on_header_impl(error_code&) override
+    {
+    }
+
+    void
+    on_body_init_impl(
+        boost::optional<std::uint64_t> const&,
+        error_code&) override
+    {
+    }
+
+    std::size_t
+    on_body_impl(
+        string_view body,
+        error_code&) override
+    {
+        return body.size();
+    }
+
+    void
+    on_chunk_header_impl(
+        std::uint64_t,
+        string_view,
+        error_code&) override
+    {
+    }
+
+    std::size_t
+    on_chunk_body_impl(
+        std::uint64_t,
+        string_view body,
+        error_code&) override
+    {
+        return body.size();
+    }
+
+    void
+    on_finish_impl(error_code&) override
+    {
+    }
+};
+
+} // http
+} // beast
+} // boost
+
+#endif
@@ -0,0 +1,1359 @@
+//
+// Copyright (c) 2016-2019 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/beast
+//
+
+#ifndef BOOST_BEAST_HTTP_IMPL_ARENA_FIELDS_HPP
+#define BOOST_BEAST_HTTP_IMPL_ARENA_FIELDS_HPP
+
+#include <boost/beast/core/buffers_cat.hpp>
+#include <boost/beast/core/string.hpp>
+#include <boost/beast/core/detail/buffers_ref.hpp>
+#include <boost/beast/core/detail/temporary_buffer.hpp>
+#include <boost/beast/core/static_string.hpp>
+#include <boost/beast/http/chunk_encode.hpp>
+#include <boost/beast/http/error.hpp>
+#include <boost/beast/http/fields.hpp>
+#include <boost/beast/http/rfc7230.hpp>
+#include <boost/beast/http/status.hpp>
+#include <boost/beast/http/verb.hpp>
+#include <boost/beast/http/detail/rfc7230.hpp>
+#include <boost/beast/http/detail/status_line.hpp>
+#include <boost/assert.hpp>
+#include <boost/core/exchange.hpp>
+#include <boost/throw_exception.hpp>
+#include <algorithm>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+
+namespace boost {
+namespace beast {
+namespace http {
+
+template<class Allocator>
+class basic_arena_fields<Allocator>::writer
+{
+public:
+    using entry = typename basic_arena_fields::value_type;
+
+    // Adjacent fields whose characters are also adjacent
+    // in the block are presented as a single buffer, so a
+    // header which was built in order is one buffer.
+    struct field_iterator
+    {
+        entry const* first_ = nullptr;
+        entry const* last_ = nullptr;
+        entry const* it_ = nullptr;
+
+        using value_type = net::const_buffer;
+        using pointer = value_type const*;
+        using reference = value_type const;
+        using difference_type = std::ptrdiff_t;
+        using iterator_category =
+            std::bidirectional_iterator_tag;
+
+        field_iterator() = default;
+
+        field_iterator(
+            entry const* first,
+            entry const* last,
+            entry const* it)
+            : first_(first)
+            , last_(last)
+            , it_(it)
+        {
+        }
+
+        bool
+        operator==(field_iterator const& other) const
+        {
+            return it_ == other.it_;
+        }
+
+        bool
+        operator!=(field_iterator const& other) const
+        {
+            return !(*this == other);
+        }
+
+        reference
+        operator*() const
+        {
+            auto const p = it_->p_;
+            auto n = it_->size();
+            for(auto e = it_ + 1; e != last_ && e->p_ == p + n; ++e)
+                n += e->size();
+            return {p, n};
+        }
+
+        field_iterator&
+        operator++()
+        {
+            auto end = it_->p_ + it_->size();
+            for(++it_; it_ != last_ && it_->p_ == end; ++it_)
+                end += it_->size();
+            return *this;
+        }
+
+        field_iterator
+        operator++(int)
+        {
+            auto temp = *this;
+            ++(*this);
+            return temp;
+        }
+
+        field_iterator&
+        operator--()
+        {
+            --it_;
+            while(it_ != first_ &&
+                (it_ - 1)->p_ + (it_ - 1)->size() == it_->p_)
+                --it_;
+            return *this;
+        }
+
+        field_iterator
+        operator--(int)
+        {
+            auto temp = *this;
+            --(*this);
+            return temp;
+        }
+    };
+
+    class field_range
+    {
+        field_iterator first_;
+        field_iterator last_;
+
+    public:
+        using const_iterator =
+            field_iterator;
+
+        using value_type =
+            typename const_iterator::value_type;
+
+        explicit
+        field_range(basic_arena_fields const& f)
+            : first_(f.begin(), f.end(), f.begin())
+            , last_(f.begin(), f.end(), f.end())
+        {
+        }
+
+        const_iterator
+        begin() const
+        {
+            return first_;
+        }
+
+        const_iterator
+        end() const
+        {
+            return last_;
+        }
+    };
+
+    using view_type = buffers_cat_view<
+        net::const_buffer,
+        net::const_buffer,
+        net::const_buffer,
+        field_range,
+        chunk_crlf>;
+
+    basic_arena_fields const& f_;
+    boost::optional<view_type> view_;
+    char buf_[13];
+
+public:
+    using const_buffers_type =
+        beast::detail::buffers_ref<view_type>;
+
+    writer(basic_arena_fields const& f,
+        unsigned version, verb v);
+
+    writer(basic_arena_fields const& f,
+        unsigned version, unsigned code);
+
+    writer(basic_arena_fields const& f);
+
+    const_buffers_type
+    get() const
+    {
+        return const_buffers_type(*view_);
+    }
+};
+
+template<class Allocator>
+basic_arena_fields<Allocator>::writer::
+writer(basic_arena_fields const& f)
+    : f_(f)
+{
+    view_.emplace(
+        net::const_buffer{nullptr, 0},
+        net::const_buffer{nullptr, 0},
+        net::const_buffer{nullptr, 0},
+        field_range(f_),
+        chunk_crlf());
+}
+
+template<class Allocator>
+basic_arena_fields<Allocator>::writer::
+writer(basic_arena_fields const& f,
+        unsigned version, verb v)
+    : f_(f)
+{
+/*
+    request
+        "<method>"
+        " <target>"
+        " HTTP/X.Y\r\n" (11 chars)
+*/
+    string_view sv;
+    if(v == verb::unknown)
+        sv = f_.get_method_impl();
+    else
+        sv = to_string(v);
+
+    // target_or_reason_ has a leading SP
+
+    string_view suffix =
+        detail::request_line_suffix(version);
+    if(suffix.empty())
+    {
+        buf_[0] = ' ';
+        buf_[1] = 'H';
+        buf_[2] = 'T';
+        buf_[3] = 'T';
+        buf_[4] = 'P';
+        buf_[5] = '/';
+        buf_[6] = '0' + static_cast<char>(version / 10);
+        buf_[7] = '.';
+        buf_[8] = '0' + static_cast<char>(version % 10);
+        buf_[9] = '\r';
+        buf_[10]= '\n';
+        suffix = {buf_, 11};
+    }
+
+    view_.emplace(
+        net::const_buffer{sv.data(), sv.size()},
+        net::const_buffer{
+            f_.target_or_reason_.data(),
+            f_.target_or_reason_.size()},
+        net::const_buffer{suffix.data(), suffix.size()},
+        field_range(f_),
+        chunk_crlf());
+}
+
+template<class Allocator>
+basic_arena_fields<Allocator>::writer::
+writer(basic_arena_fields const& f,
+        unsigned version, unsigned code)
+    : f_(f)
+{
+/*
+    response
+        "HTTP/X.Y ### " (13 chars)
+        "<reason>"
+        "\r\n"
+*/
+    if(f_.target_or_reason_.empty())
+    {
+        auto const line = detail::status_line(version, code);
+        if(! line.empty())
+        {
+            view_.emplace(
+                net::const_buffer{line.data(), line.size()},
+                net::const_buffer{nullptr, 0},
+                net::const_buffer{nullptr, 0},
+                field_range(f_),
+                chunk_crlf{});
+            return;
+        }
+    }
+
+    buf_[0] = 'H';
+    buf_[1] = 'T';
+    buf_[2] = 'T';
+    buf_[3] = 'P';
+    buf_[4] = '/';
+    buf_[5] = '0' + static_cast<char>(version / 10);
+    buf_[6] = '.';
+    buf_[7] = '0' + static_cast<char>(version % 10);
+    buf_[8] = ' ';
+    buf_[9] = '0' + static_cast<char>(code / 100);
+    buf_[10]= '0' + static_cast<char>((code / 10) % 10);
+    buf_[11]= '0' + static_cast<char>(code % 10);
+    buf_[12]= ' ';
+
+    string_view sv;
+    if(! f_.target_or_reason_.empty())
+        sv = f_.target_or_reason_;
+    else
+        sv = obsolete_reason(static_cast<status>(code));
+
+    view_.emplace(
+        net::const_buffer{buf_, 13},
+        net::const_buffer{sv.data(), sv.size()},
+        net::const_buffer{"\r\n", 2},
+        field_range(f_),
+        chunk_crlf{});
+}
+
+//------------------------------------------------------------------------------
+
+// A block of storage released when the
+// object is destroyed. Replaced blocks are
+// kept alive until the end of the operation,
+// since the strings being inserted may
+// refer to them.
+template<class Allocator>
+class basic_arena_fields<Allocator>::block
+{
+    rebind_type a_;
+    align_type* p_ = nullptr;
+    std::size_t n_ = 0;
+
+public:
+    explicit
+    block(Allocator const& alloc)
+        : a_(alloc)
+    {
+    }
+
+    block(block const&) = delete;
+    block& operator=(block const&) = delete;
+
+    ~block()
+    {
+        if(p_)
+            alloc_traits::deallocate(a_, p_, n_);
+    }
+
+    void
+    reset(align_type* p, std::size_t n) noexcept
+    {
+        BOOST_ASSERT(! p_);
+        p_ = p;
+        n_ = n;
+    }
+};
+
+template<class Allocator>
+basic_arena_fields<Allocator>::
+value_type::
+value_type(char const* p,
+    std::size_t nlen, std::size_t vlen, field f)
+    : p_(p)
+    , nlen_(static_cast<off_t>(nlen))
+    , vlen_(static_cast<off_t>(vlen))
+    , f_(f)
+{
+}
+
+template<class Allocator>
+std::size_t
+basic_arena_fields<Allocator>::
+value_type::
+size() const
+{
+    return static_cast<std::size_t>(nlen_) + vlen_ + 4;
+}
+
+template<class Allocator>
+field
+basic_arena_fields<Allocator>::
+value_type::
+name() const
+{
+    return f_;
+}
+
+template<class Allocator>
+string_view const
+basic_arena_fields<Allocator>::
+value_type::
+name_string() const
+{
+    return {p_, nlen_};
+}
+
+template<class Allocator>
+string_view const
+basic_arena_fields<Allocator>::
+value_type::
+value() const
+{
+    return {p_ + nlen_ + 2, vlen_};
+}
+
+//------------------------------------------------------------------------------
+
+template<class Allocator>
+basic_arena_fields<Allocator>::
+~basic_arena_fields()
+{
+    if(list_)
+    {
+        rebind_type a(this->get());
+        alloc_traits::deallocate(a,
+            reinterpret_cast<align_type*>(list_), units_);
+    }
+}
+
+template<class Allocator>
+basic_arena_fields<Allocator>::
+basic_arena_fields(Allocator const& alloc) noexcept
+    : boost::empty_value<Allocator>(boost::empty_init_t(), alloc)
+{
+}
+
+template<class Allocator>
+basic_arena_fields<Allocator>::
+basic_arena_fields(basic_arena_fields&& other) noexcept
+    : boost::empty_value<Allocator>(boost::empty_init_t(),
+        std::move(other.get()))
+{
+    steal(other);
+}
+
+template<class Allocator>
+basic_arena_fields<Allocator>::
+basic_arena_fields(basic_arena_fields&& other, Allocator const& alloc)
+    : boost::empty_value<Allocator>(boost::empty_init_t(), alloc)
+{
+    if(this->get() != other.get())
+        copy_all(other);
+    else
+        steal(other);
+}
+
+template<class Allocator>
+basic_arena_fields<Allocator>::
+basic_arena_fields(basic_arena_fields const& other)
+    : boost::empty_value<Allocator>(boost::empty_init_t(), alloc_traits::
+        select_on_container_copy_construction(other.get()))
+{
+    copy_all(other);
+}
+
+template<class Allocator>
+basic_arena_fields<Allocator>::
+basic_arena_fields(basic_arena_fields const& other,
+        Allocator const& alloc)
+    : boost::empty_value<Allocator>(boost::empty_init_t(), alloc)
+{
+    copy_all(other);
+}
+
+template<class Allocator>
+template<class OtherAlloc>
+basic_arena_fields<Allocator>::
+basic_arena_fields(basic_arena_fields<OtherAlloc> const& other)
+{
+    copy_all(other);
+}
+
+template<class Allocator>
+template<class OtherAlloc>
+basic_arena_fields<Allocator>::
+basic_arena_fields(basic_arena_fields<OtherAlloc> const& other,
+        Allocator const& alloc)
+    : boost::empty_value<Allocator>(boost::empty_init_t(), alloc)
+{
+    copy_all(other);
+}
+
+template<class Allocator>
+auto
+basic_arena_fields<Allocator>::
+operator=(basic_arena_fields&& other) noexcept(
+    pocma::value && std::is_nothrow_move_assignable<Allocator>::value)
+    -> basic_arena_fields&
+{
+    if(this == &other)
+        return *this;
+    move_assign(other, pocma{});
+    return *this;
+}
+
+template<class Allocator>
+auto
+basic_arena_fields<Allocator>::
+operator=(basic_arena_fields const& other) ->
+    basic_arena_fields&
+{
+    if(this == &other)
+        return *this;
+    copy_assign(other, pocca{});
+    return *this;
+}
+
+template<class Allocator>
+template<class OtherAlloc>
+auto
+basic_arena_fields<Allocator>::
+operator=(basic_arena_fields<OtherAlloc> const& other) ->
+    basic_arena_fields&
+{
+    clear_all();
+    copy_all(other);
+    return *this;
+}
+
+//------------------------------------------------------------------------------
+//
+// Element access
+//
+//------------------------------------------------------------------------------
+
+template<class Allocator>
+string_view const
+basic_arena_fields<Allocator>::
+at(field name) const
+{
+    BOOST_ASSERT(name != field::unknown);
+    auto const it = find(name);
+    if(it == end())
+        BOOST_THROW_EXCEPTION(std::out_of_range{
+            "field not found"});
+    return it->value();
+}
+
+template<class Allocator>
+string_view const
+basic_arena_fields<Allocator>::
+at(string_view name) const
+{
+    auto const it = find(name);
+    if(it == end())
+        BOOST_THROW_EXCEPTION(std::out_of_range{
+            "field not found"});
+    return it->value();
+}
+
+template<class Allocator>
+string_view const
+basic_arena_fields<Allocator>::
+operator[](field name) const
+{
+    BOOST_ASSERT(name != field::unknown);
+    auto const it = find(name);
+    if(it == end())
+        return {};
+    return it->value();
+}
+
+template<class Allocator>
+string_view const
+basic_arena_fields<Allocator>::
+operator[](string_view name) const
+{
+    auto const it = find(name);
+    if(it == end())
+        return {};
+    return it->value();
+}
+
+//------------------------------------------------------------------------------
+//
+// Capacity
+//
+//------------------------------------------------------------------------------
+
+template<class Allocator>
+void
+basic_arena_fields<Allocator>::
+reserve(std::size_t n, std::size_t bytes)
+{
+    if(n <= capacity_ && bytes <= buf_size_)
+        return;
+    block old(this->get());
+    reallocate(
+        (std::max)(n, capacity_),
+        (std::max)(bytes, buf_size_),
+        old);
+}
+
+//------------------------------------------------------------------------------
+//
+// Modifiers
+//
+//------------------------------------------------------------------------------
+
+template<class Allocator>
+void
+basic_arena_fields<Allocator>::
+clear()
+{
+    size_ = 0;
+
+    // Move the strings which remain to the front
+    // of the storage so that it may be reused.
+    auto* lo = &method_;
+    auto* hi = &target_or_reason_;
+    if(hi->data() < lo->data())
+        std::swap(lo, hi);
+    used_ = 0;
+    for(auto* s : { lo, hi })
+    {
+        if(s->empty())
+            continue;
+        std::memmove(buf_ + used_, s->data(), s->size());
+        *s = { buf_ + used_, s->size() };
+        used_ += s->size();
+    }
+}
+
+template<class Allocator>
+inline
+void
+basic_arena_fields<Allocator>::
+insert(field name, string_view value)
+{
+    BOOST_ASSERT(name != field::unknown);
+    insert(name, to_string(name), value);
+}
+
+template<class Allocator>
+void
+basic_arena_fields<Allocator>::
+insert(string_view sname, string_view value)
+{
+    insert(field::unknown, sname, value);
+}
+
+template<class Allocator>
+void
+basic_arena_fields<Allocator>::
+insert(
+    field name,
+    string_view sname,
+    string_view value,
+    error_code& ec)
+{
+    insert_impl(name, sname, value, false, ec);
+}
+
+template<class Allocator>
+void
+basic_arena_fields<Allocator>::
+insert(field name,
+    string_view sname, string_view value)
+{
+    error_code ec;
+    insert_impl(name, sname, value, false, ec);
+    if(ec.failed())
+        BOOST_THROW_EXCEPTION(system_error{ec});
+}
+
+template<class Allocator>
+void
+basic_arena_fields<Allocator>::
+set(field name, string_view value)
+{
+    BOOST_ASSERT(name != field::unknown);
+    error_code ec;
+    insert_impl(name, to_string(name), value, true, ec);
+    if(ec.failed())
+        BOOST_THROW_EXCEPTION(system_error{ec});
+}
+
+template<class Allocator>
+void
+basic_arena_fields<Allocator>::
+set(string_view sname, string_view value)
+{
+    error_code ec;
+    insert_impl(field::unknown, sname, value, true, ec);
+    if(ec.failed())
+        BOOST_THROW_EXCEPTION(system_error{ec});
+}
+
+template<class Allocator>
+auto
+basic_arena_fields<Allocator>::
+erase(const_iterator pos) ->
+    const_iterator
+{
+    BOOST_ASSERT(pos >= begin() && pos < end());
+    auto const i = static_cast<std::size_t>(pos - list_);
+    std::memmove(list_ + i, list_ + i + 1,
+        (size_ - i - 1) * sizeof(value_type));
+    --size_;
+    return list_ + i;
+}
+
+template<class Allocator>
+std::size_t
+basic_arena_fields<Allocator>::
+erase(field name)
+{
+    BOOST_ASSERT(name != field::unknown);
+    return erase_impl(name, {});
+}
+
+template<class Allocator>
+std::size_t
+basic_arena_fields<Allocator>::
+erase(string_view name)
+{
+    return erase_impl(string_to_field(name), name);
+}
+
+template<class Allocator>
+void
+basic_arena_fields<Allocator>::
+swap(basic_arena_fields<Allocator>& other)
+{
+    swap(other, pocs{});
+}
+
+template<class Allocator>
+void
+swap(
+    basic_arena_fields<Allocator>& lhs,
+    basic_arena_fields<Allocator>& rhs)
+{
+    lhs.swap(rhs);
+}
+
+//------------------------------------------------------------------------------
+//
+// Lookup
+//
+//------------------------------------------------------------------------------
+
+template<class Allocator>
+inline
+bool
+basic_arena_fields<Allocator>::
+contains(field name) const
+{
+    BOOST_ASSERT(name != field::unknown);
+    return find(name) != end();
+}
+
+template<class Allocator>
+bool
+basic_arena_fields<Allocator>::
+contains(string_view name) const
+{
+    return find(name) != end();
+}
+
+template<class Allocator>
+inline
+std::size_t
+basic_arena_fields<Allocator>::
+count(field name) const
+{
+    BOOST_ASSERT(name != field::unknown);
+    auto const r = equal_range(name);
+    return static_cast<std::size_t>(r.second - r.first);
+}
+
+template<class Allocator>
+std::size_t
+basic_arena_fields<Allocator>::
+count(string_view name) const
+{
+    auto const r = equal_range(name);
+    return static_cast<std::size_t>(r.second - r.first);
+}
+
+template<class Allocator>
+inline
+auto
+basic_arena_fields<Allocator>::
+find(field name) const ->
+    const_iterator
+{
+    BOOST_ASSERT(name != field::unknown);
+    return find_impl(name, {});
+}
+
+template<class Allocator>
+auto
+basic_arena_fields<Allocator>::
+find(string_view name) const ->
+    const_iterator
+{
+    return find_impl(string_to_field(name), name);
+}
+
+template<class Allocator>
+inline
+auto
+basic_arena_fields<Allocator>::
+equal_range(field name) const ->
+    std::pair<const_iterator, const_iterator>
+{
+    BOOST_ASSERT(name != field::unknown);
+    auto first = find(name);
+    auto last = first;
+    while(last != end() && last->f_ == name)
+        ++last;
+    return {first, last};
+}
+
+template<class Allocator>
+auto
+basic_arena_fields<Allocator>::
+equal_range(string_view name) const ->
+    std::pair<const_iterator, const_iterator>
+{
+    auto const f = string_to_field(name);
+    auto first = find_impl(f, name);
+    auto last = first;
+    while(last != end() && matches(*last, f, name))
+        ++last;
+    return {first, last};
+}
+
+//------------------------------------------------------------------------------
+
+// Fields
+
+template<class Allocator>
+inline
+string_view
+basic_arena_fields<Allocator>::
+get_method_impl() const
+{
+    return method_;
+}
+
+template<class Allocator>
+inline
+string_view
+basic_arena_fields<Allocator>::
+get_target_impl() const
+{
+    if(target_or_reason_.empty())
+        return target_or_reason_;
+    return {
+        target_or_reason_.data() + 1,
+        target_or_reason_.size() - 1};
+}
+
+template<class Allocator>
+inline
+string_view
+basic_arena_fields<Allocator>::
+get_reason_impl() const
+{
+    return target_or_reason_;
+}
+
+template<class Allocator>
+bool
+basic_arena_fields<Allocator>::
+get_chunked_impl() const
+{
+    auto const te = token_list{
+        (*this)[field::transfer_encoding]};
+    for(auto it = te.begin(); it != te.end();)
+    {
+        auto const next = std::next(it);
+        if(next == te.end())
+            return beast::iequals(*it, "chunked");
+        it = next;
+    }
+    return false;
+}
+
+template<class Allocator>
+bool
+basic_arena_fields<Allocator>::
+get_keep_alive_impl(unsigned version) const
+{
+    auto const it = find(field::connection);
+    if(version < 11)
+    {
+        if(it == end())
+            return false;
+        return token_list{
+            it->value()}.exists("keep-alive");
+    }
+    if(it == end())
+        return true;
+    return ! token_list{
+        it->value()}.exists("close");
+}
+
+template<class Allocator>
+bool
+basic_arena_fields<Allocator>::
+has_content_length_impl() const
+{
+    return contains(field::content_length);
+}
+
+template<class Allocator>
+inline
+void
+basic_arena_fields<Allocator>::
+set_method_impl(string_view s)
+{
+    set_string(method_, s, false);
+}
+
+template<class Allocator>
+inline
+void
+basic_arena_fields<Allocator>::
+set_target_impl(string_view s)
+{
+    // The target string is stored with an
+    // extra space at the beginning to help
+    // the writer class.
+    set_string(target_or_reason_, s, true);
+}
+
+template<class Allocator>
+inline
+void
+basic_arena_fields<Allocator>::
+set_reason_impl(string_view s)
+{
+    set_string(target_or_reason_, s, false);
+}
+
+template<class Allocator>
+void
+basic_arena_fields<Allocator>::
+set_chunked_impl(bool value)
+{
+    beast::detail::temporary_buffer buf;
+    auto it = find(field::transfer_encoding);
+    if(value)
+    {
+        // append "chunked"
+        if(it == end())
+        {
+            set(field::transfer_encoding, "chunked");
+            return;
+        }
+        auto const te = token_list{it->value()};
+        for(auto itt = te.begin();;)
+        {
+            auto const next = std::next(itt);
+            if(next == te.end())
+            {
+                if(beast::iequals(*itt, "chunked"))
+                    return; // already set
+                break;
+            }
+            itt = next;
+        }
+
+        buf.append(it->value(), ", chunked");
+        set(field::transfer_encoding, buf.view());
+        return;
+    }
+    // filter "chunked"
+    if(it == end())
+        return;
+
+    detail::filter_token_list_last(buf, it->value(), {"chunked", {}});
+    if(! buf.empty())
+        set(field::transfer_encoding, buf.view());
+    else
+        erase(field::transfer_encoding);
+}
+
+template<class Allocator>
+void
+basic_arena_fields<Allocator>::
+set_content_length_impl(
+    boost::optional<std::uint64_t> const& value)
+{
+    if(! value)
+        erase(field::content_length);
+    else
+    {
+        auto s = to_static_string(*value);
+        set(field::content_length,
+            to_string_view(s));
+    }
+}
+
+template<class Allocator>
+void
+basic_arena_fields<Allocator>::
+set_keep_alive_impl(
+    unsigned version, bool keep_alive)
+{
+    auto const value = (*this)[field::connection];
+    beast::detail::temporary_buffer buf;
+    detail::keep_alive_impl(buf, value, version, keep_alive);
+    if(buf.empty())
+        erase(field::connection);
+    else
+        set(field::connection, buf.view());
+}
+
+//------------------------------------------------------------------------------
+
+// Every stored field has the correct enumeration,
+// so a known name is matched on the enumeration alone.
+template<class Allocator>
+bool
+basic_arena_fields<Allocator>::
+matches(
+    value_type const& e,
+    field name,
+    string_view sname) noexcept
+{
+    if(name != field::unknown)
+        return e.f_ == name;
+    return
+        e.f_ == field::unknown &&
+        e.nlen_ == sname.size() &&
+        beast::iequals(e.name_string(), sname);
+}
+
+template<class Allocator>
+auto
+basic_arena_fields<Allocator>::
+find_impl(field name, string_view sname) const ->
+    const_iterator
+{
+    auto it = begin();
+    auto const last = end();
+    for(; it != last; ++it)
+        if(matches(*it, name, sname))
+            break;
+    return it;
+}
+
+template<class Allocator>
+std::size_t
+basic_arena_fields<Allocator>::
+erase_impl(field name, string_view sname)
+{
+    std::size_t n = 0;
+    for(std::size_t i = 0; i < size_; ++i)
+    {
+        if(matches(list_[i], name, sname))
+            continue;
+        if(n != i)
+            list_[n] = list_[i];
+        ++n;
+    }
+    auto const count = size_ - n;
+    size_ = n;
+    return count;
+}
+
+template<class Allocator>
+void
+basic_arena_fields<Allocator>::
+insert_impl(
+    field name,
+    string_view sname,
+    string_view value,
+    bool replace,
+    error_code& ec)
+{
+    ec = {};
+    if(sname.size() > max_name_size)
+    {
+        BOOST_BEAST_ASSIGN_EC(ec, error::header_field_name_too_large);
+        return;
+    }
+    if(value.size() > max_value_size)
+    {
+        BOOST_BEAST_ASSIGN_EC(ec, error::header_field_value_too_large);
+        return;
+    }
+    value = detail::trim(value);
+    if(name == field::unknown)
+        name = string_to_field(sname);
+    auto const n = sname.size() + value.size() + 4;
+
+    // The strings may refer to the old
+    // block, which stays alive until we return.
+    block old(this->get());
+    prepare(1, n, old);
+
+    std::size_t pos = size_;
+    if(replace)
+    {
+        erase_impl(name, sname);
+        pos = size_;
+    }
+    else
+    {
+        // keep duplicate fields together
+        for(auto i = size_; i-- > 0;)
+        {
+            if(matches(list_[i], name, sname))
+            {
+                pos = i + 1;
+                break;
+            }
+        }
+    }
+
+    char* const p = buf_ + used_;
+    sname.copy(p, sname.size());
+    p[sname.size()] = ':';
+    p[sname.size() + 1] = ' ';
+    value.copy(p + sname.size() + 2, value.size());
+    p[n - 2] = '\r';
+    p[n - 1] = '\n';
+    used_ += n;
+
+    std::memmove(list_ + pos + 1, list_ + pos,
+        (size_ - pos) * sizeof(value_type));
+    ::new(list_ + pos) value_type(
+        p, sname.size(), value.size(), name);
+    ++size_;
+}
+
+template<class Allocator>
+void
+basic_arena_fields<Allocator>::
+set_string(string_view& dest,
+    string_view s, bool space)
+{
+    if(s.empty())
+    {
+        dest = {};
+        return;
+    }
+    auto const n = s.size() + (space ? 1 : 0);
+    block old(this->get());
+    prepare(0, n, old);
+    char* p = buf_ + used_;
+    if(space)
+        p[0] = ' ';
+    s.copy(p + (space ? 1 : 0), s.size());
+    used_ += n;
+    dest = {p, n};
+}
+
+// Make room for n more fields and the given number of
+// characters, packing the remaining fields together
+// into a new block when the current one is full.
+template<class Allocator>
+void
+basic_arena_fields<Allocator>::
+prepare(std::size_t n,
+    std::size_t bytes, block& old)
+{
+    if( n <= capacity_ - size_ &&
+        bytes <= buf_size_ - used_)
+        return;
+    std::size_t live =
+        method_.size() + target_or_reason_.size();
+    for(auto const& e : *this)
+        live += e.size();
+    auto const need = live + bytes;
+    std::size_t cap = capacity_ ? capacity_ : 16;
+    while(cap < size_ + n)
+        cap *= 2;
+    std::size_t size = buf_size_ ? buf_size_ : 512;
+    while(size < need + need / 2)
+        size *= 2;
+    reallocate(cap, size, old);
+}
+
+template<class Allocator>
+void
+basic_arena_fields<Allocator>::
+reallocate(std::size_t n,
+    std::size_t bytes, block& old)
+{
+    BOOST_ASSERT(n >= size_);
+    auto const units =
+        (n * sizeof(value_type) + bytes +
+            sizeof(align_type) - 1) / sizeof(align_type);
+    rebind_type a(this->get());
+    auto const p = alloc_traits::allocate(a, units);
+    auto const list = reinterpret_cast<value_type*>(p);
+    auto const buf = reinterpret_cast<char*>(list + n);
+
+    std::size_t used = 0;
+    for(std::size_t i = 0; i < size_; ++i)
+    {
+        auto const& e = list_[i];
+        std::memcpy(buf + used, e.p_, e.size());
+        ::new(list + i) value_type(
+            buf + used, e.nlen_, e.vlen_, e.f_);
+        used += e.size();
+    }
+    for(auto* s : { &method_, &target_or_reason_ })
+    {
+        if(s->empty())
+            continue;
+        std::memcpy(buf + used, s->data(), s->size());
+        *s = { buf + used, s->size() };
+        used += s->size();
+    }
+
+    if(list_)
+        old.reset(reinterpret_cast<align_type*>(list_), units_);
+    list_ = list;
+    buf_ = buf;
+    capacity_ = n;
+    used_ = used;
+    buf_size_ = units * sizeof(align_type) - n * sizeof(value_type);
+    units_ = units;
+}
+
+template<class Allocator>
+template<class OtherAlloc>
+void
+basic_arena_fields<Allocator>::
+copy_all(basic_arena_fields<OtherAlloc> const& other)
+{
+    BOOST_ASSERT(size_ == 0 && used_ == 0);
+    std::size_t bytes =
+        other.method_.size() + other.target_or_reason_.size();
+    for(auto const& e : other)
+        bytes += e.size();
+    reserve(other.size_, bytes);
+    for(auto const& e : other)
+    {
+        char* const p = buf_ + used_;
+        std::memcpy(p, e.p_, e.size());
+        ::new(list_ + size_) value_type(
+            p, e.nlen_, e.vlen_, e.f_);
+        used_ += e.size();
+        ++size_;
+    }
+    set_string(method_, other.method_, false);
+    set_string(target_or_reason_, other.target_or_reason_, false);
+}
+
+template<class Allocator>
+void
+basic_arena_fields<Allocator>::
+clear_all()
+{
+    method_ = {};
+    target_or_reason_ = {};
+    clear();
+}
+
+template<class Allocator>
+void
+basic_arena_fields<Allocator>::
+steal(basic_arena_fields& other) noexcept
+{
+    list_ = boost::exchange(other.list_, nullptr);
+    buf_ = boost::exchange(other.buf_, nullptr);
+    size_ = boost::exchange(other.size_, 0);
+    capacity_ = boost::exchange(other.capacity_, 0);
+    used_ = boost::exchange(other.used_, 0);
+    buf_size_ = boost::exchange(other.buf_size_, 0);
+    units_ = boost::exchange(other.units_, 0);
+    method_ = boost::exchange(other.method_, {});
+    target_or_reason_ = boost::exchange(other.target_or_reason_, {});
+}
+
+template<class Allocator>
+inline
+void
+basic_arena_fields<Allocator>::
+move_assign(basic_arena_fields& other, std::true_type)
+{
+    basic_arena_fields(this->get()).swap_storage(*this);
+    this->get() = std::move(other.get());
+    steal(other);
+}
+
+template<class Allocator>
+inline
+void
+basic_arena_fields<Allocator>::
+move_assign(basic_arena_fields& other, std::false_type)
+{
+    if(this->get() != other.get())
+    {
+        clear_all();
+        copy_all(other);
+    }
+    else
+    {
+        basic_arena_fields(this->get()).swap_storage(*this);
+        steal(other);
+    }
+}
+
+template<class Allocator>
+inline
+void
+basic_arena_fields<Allocator>::
+copy_assign(basic_arena_fields const& other, std::true_type)
+{
+    if(this->get() != other.get())
+        basic_arena_fields(this->get()).swap_storage(*this);
+    else
+        clear_all();
+    this->get() = other.get();
+    copy_all(other);
+}
+
+template<class Allocator>
+inline
+void
+basic_arena_fields<Allocator>::
+copy_assign(basic_arena_fields const& other, std::false_type)
+{
+    clear_all();
+    copy_all(other);
+}
+
+template<class Allocator>
+inline
+void
+basic_arena_fields<Allocator>::
+swap(basic_arena_fields& other, std::true_type)
+{
+    using std::swap;
+    swap(this->get(), other.get());
+    swap_storage(other);
+}
+
+template<class Allocator>
+inline
+void
+basic_arena_fields<Allocator>::
+swap(basic_arena_fields& other, std::false_type)
+{
+    BOOST_ASSERT(this->get() == other.get());
+    swap_storage(other);
+}
+
+template<class Allocator>
+void
+basic_arena_fields<Allocator>::
+swap_storage(basic_arena_fields& other) noexcept
+{
+    using std::swap;
+    swap(list_, other.list_);
+    swap(buf_, other.buf_);
+    swap(size_, other.size_);
+    swap(capacity_, other.capacity_);
+    swap(used_, other.used_);
+    swap(buf_size_, other.buf_size_);
+    swap(units_, other.units_);
+    swap(method_, other.method_);
+    swap(target_or_reason_, other.target_or_reason_);
+}
+
+} // http
+} // beast
+} // boost
+
+#endif
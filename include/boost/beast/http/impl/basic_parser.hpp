@@ -13,6 +13,8 @@
 #include <boost/beast/core/buffer_traits.hpp>
 #include <boost/asio/buffer.hpp>
 #include <boost/make_unique.hpp>
+#include <algorithm>
+#include <cstring>
 
 namespace boost {
 namespace beast {
@@ -28,21 +30,121 @@ put(ConstBufferSequence const& buffers,
     static_assert(net::is_const_buffer_sequence<
         ConstBufferSequence>::value,
             "ConstBufferSequence type requirements not met");
-    auto const p = net::buffer_sequence_begin(buffers);
+    auto it = net::buffer_sequence_begin(buffers);
     auto const last = net::buffer_sequence_end(buffers);
-    if(p == last)
+    if(it == last)
     {
         ec = {};
         return 0;
     }
-    if(std::next(p) == last)
+    if(std::next(it) == last)
     {
         // single buffer
-        return put(net::const_buffer(*p), ec);
+        return put(net::const_buffer(*it), ec);
     }
+    if((f_ & flagWholeHeader) && ! is_header_done())
+        return put_flat(buffers, ec);
     auto const size = buffer_bytes(buffers);
     if(size <= max_stack_buffer)
+    {
+        // Copying a small input to the stack costs
+        // less than parsing it in several pieces.
         return put_from_stack(size, buffers, ec);
+    }
+
+    // Parse each buffer in place. Only an element which
+    // straddles two buffers is copied, together with enough
+    // of the following bytes to complete it, after which
+    // parsing resumes in place.
+    std::size_t total = 0;
+    std::size_t pos = 0; // offset into *it
+    for(;;)
+    {
+        while(it != last && net::const_buffer(*it).size() == pos)
+        {
+            ++it;
+            pos = 0;
+        }
+        if(it == last)
+            return total;
+        auto const b = net::const_buffer(*it) + pos;
+        auto const skip0 = skip_;
+        auto const n = put(b, ec);
+        total += n;
+        pos += n;
+        if(! ec)
+        {
+            if(n < b.size() || is_done() || ! eager())
+                return total;
+            continue;
+        }
+        if(ec != error::need_more)
+            return total;
+        if(n == b.size())
+            continue;
+
+        // The element at `pos` continues in the next buffer
+        auto const tail = net::const_buffer(*it) + pos;
+        std::size_t rest = 0;
+        for(auto it2 = std::next(it); it2 != last; ++it2)
+            rest += net::const_buffer(*it2).size();
+        if(rest == 0)
+            return total;
+        // Each attempt starts from the position the search
+        // had when the element began, as if it were flat.
+        auto const skip = n > 0 ? 0 : skip0;
+        std::size_t extra = 256;
+        std::size_t used;
+        for(;;)
+        {
+            if(extra > rest)
+                extra = rest;
+            skip_ = skip;
+            used = put_joined(
+                tail.size() + extra, tail, std::next(it), ec);
+            if(used > 0 || ec != error::need_more || extra == rest)
+                break;
+            extra *= 2;
+        }
+        if(used == 0)
+            return total;
+        total += used;
+        if(used < tail.size())
+        {
+            pos += used;
+        }
+        else
+        {
+            // skip the bytes consumed past the tail
+            pos = used - tail.size();
+            ++it;
+            while(pos > 0 && pos >= net::const_buffer(*it).size())
+            {
+                pos -= net::const_buffer(*it).size();
+                ++it;
+            }
+        }
+        if(ec)
+        {
+            if(ec != error::need_more)
+                return total;
+            continue;
+        }
+        if(is_done() || ! eager())
+            return total;
+    }
+}
+
+template<bool isRequest>
+template<class ConstBufferSequence>
+std::size_t
+basic_parser<isRequest>::
+put_flat(ConstBufferSequence const& buffers,
+    error_code& ec)
+{
+    // The strings passed to the callbacks must remain
+    // valid after returning, so the stack is not used.
+    auto const size = buffer_bytes(buffers);
     if(size > buf_len_)
     {
         // reallocate
@@ -56,6 +158,58 @@ put(ConstBufferSequence const& buffers,
         buf_.get(), size}, ec);
 }
 
+template<bool isRequest>
+template<class Iterator>
+void
+basic_parser<isRequest>::
+copy_joined(
+    char* dest,
+    std::size_t size,
+    net::const_buffer tail,
+    Iterator it)
+{
+    std::memcpy(dest, tail.data(), tail.size());
+    dest += tail.size();
+    size -= tail.size();
+    while(size > 0)
+    {
+        net::const_buffer const b(*it++);
+        auto const n = (std::min)(size, b.size());
+        if(n > 0)
+            std::memcpy(dest, b.data(), n);
+        dest += n;
+        size -= n;
+    }
+}
+
+template<bool isRequest>
+template<class Iterator>
+std::size_t
+basic_parser<isRequest>::
+put_joined(
+    std::size_t size,
+    net::const_buffer tail,
+    Iterator it,
+    error_code& ec)
+{
+    if(size <= max_stack_buffer)
+    {
+        char buf[max_stack_buffer];
+        copy_joined(buf, size, tail, it);
+        return put(net::const_buffer{
+            buf, size}, ec);
+    }
+    if(size > buf_len_)
+    {
+        // reallocate
+        buf_ = boost::make_unique_noinit<char[]>(size);
+        buf_len_ = size;
+    }
+    copy_joined(buf_.get(), size, tail, it);
+    return put(net::const_buffer{
+        buf_.get(), size}, ec);
+}
+
 template<bool isRequest>
 boost::optional<std::uint64_t>
 basic_parser<isRequest>::
@@ -64,6 +64,21 @@ content_length_remaining() const
     return len_;
 }
 
+template<bool isRequest>
+void
+basic_parser<isRequest>::
+reset() noexcept
+{
+    body_limit_ = body_limit0_;
+    header_limit_ = header_limit0_;
+    len_ = 0;
+    len0_ = 0;
+    skip_ = 0;
+    status_ = 0;
+    state_ = state::nothing_yet;
+    f_ &= flagEager | flagWholeHeader;
+}
+
 template<bool isRequest>
 void
 basic_parser<isRequest>::
@@ -83,10 +98,9 @@ put(net::const_buffer buffer,
     error_code& ec)
 {
     // If this goes off you have tried to parse more data after the parser
-    // has completed. A common cause of this is re-using a parser, which is
-    // not supported. If you need to re-use a parser, consider storing it
-    // in an optional. Then reset() and emplace() prior to parsing each new
-    // message.
+    // has completed. A common cause of this is re-using a parser without
+    // first calling reset(), or emplace() when it is stored in an optional,
+    // prior to parsing each new message.
     BOOST_ASSERT(!is_done());
     if (is_done())
     {
@@ -111,6 +125,12 @@ loop:
         BOOST_FALLTHROUGH;
 
     case state::start_line:
+        if(f_ & flagWholeHeader)
+        {
+            find_header(p, n, ec);
+            if(ec)
+                goto done;
+        }
         parse_start_line(p, n, ec);
         if(ec)
             goto done;
@@ -224,6 +244,45 @@ put_eof(error_code& ec)
     this->on_finish_impl(ec);
 }
 
+template<bool isRequest>
+net::mutable_buffer
+basic_parser<isRequest>::
+prepare_body(std::size_t size, error_code& ec)
+{
+    ec = {};
+    if(state_ == state::body0)
+    {
+        this->on_body_init_impl(content_length(), ec);
+        if(ec)
+            return {};
+        state_ = state::body;
+    }
+    if(state_ != state::body || size == 0)
+        return {};
+    auto const mb = this->on_body_prepare_impl(
+        beast::detail::clamp(len_, size), ec);
+    BOOST_ASSERT(mb.size() <= len_);
+    return mb;
+}
+
+template<bool isRequest>
+void
+basic_parser<isRequest>::
+commit_body(std::size_t n, error_code& ec)
+{
+    BOOST_ASSERT(state_ == state::body);
+    BOOST_ASSERT(n <= len_);
+    ec = {};
+    this->on_body_commit_impl(n, ec);
+    len_ -= n;
+    if(ec)
+        return;
+    if(len_ > 0)
+        return;
+    state_ = state::complete;
+    this->on_finish_impl(ec);
+}
+
 template<bool isRequest>
 void
 basic_parser<isRequest>::
@@ -339,6 +398,31 @@ inner_parse_start_line(
     state_ = state::fields;
 }
 
+template<bool isRequest>
+void
+basic_parser<isRequest>::
+find_header(
+    char const* p, std::size_t n, error_code& ec)
+{
+    auto const last = p + (std::min<std::size_t>)
+        (n, header_limit_);
+    if(find_eom(p + (std::min<std::size_t>)(skip_,
+            static_cast<std::size_t>(last - p)), last))
+    {
+        skip_ = 0;
+        return;
+    }
+    // Resume the search before a partial empty line at the end
+    auto const left = static_cast<std::size_t>(last - p);
+    skip_ = left > 3 ? left - 3 : 0;
+    if(n >= header_limit_)
+    {
+        BOOST_BEAST_ASSIGN_EC(ec, error::header_limit);
+        return;
+    }
+    BOOST_BEAST_ASSIGN_EC(ec, error::need_more);
+}
+
 template<bool isRequest>
 void
 basic_parser<isRequest>::
@@ -367,6 +451,14 @@ inner_parse_fields(char const*& in,
     // https://stackoverflow.com/questions/686217/maximum-on-http-header-values
     beast::detail::char_buffer<max_obs_fold> buf;
     auto p = in;
+
+    // No field extends past the first empty line, so when the
+    // whole block is present the work is bounded by its end.
+    // The search resumes where an earlier call left off.
+    if(auto const eom = find_eom(p + (std::min<std::size_t>)(
+            skip_, static_cast<std::size_t>(last - p)), last))
+        last = eom;
+
     for(;;)
     {
         if(p + 2 > last)
@@ -414,12 +506,24 @@ basic_parser<isRequest>::
 parse_fields(char const*& in, std::size_t n, error_code& ec)
 {
     auto const p0 = in;
+    auto const last = in + (std::min<std::size_t>)
+        (n, header_limit_);
 
-    inner_parse_fields(in, in + (std::min<std::size_t>)
-        (n, header_limit_), ec);
-    if(ec == error::need_more && n >= header_limit_)
+    inner_parse_fields(in, last, ec);
+    if(ec == error::need_more)
     {
-        BOOST_BEAST_ASSIGN_EC(ec, error::header_limit);
+        // The empty line was not found in the bytes which remain
+        // unconsumed, except possibly for a partial one at the end.
+        auto const left = static_cast<std::size_t>(last - in);
+        skip_ = left > 3 ? left - 3 : 0;
+        if(n >= header_limit_)
+        {
+            BOOST_BEAST_ASSIGN_EC(ec, error::header_limit);
+        }
+    }
+    else
+    {
+        skip_ = 0;
     }
     header_limit_ -= static_cast<std::uint32_t>(in - p0);
 }
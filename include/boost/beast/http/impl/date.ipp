@@ -0,0 +1,32 @@
+//
+// Copyright (c) 2016-2019 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/beast
+//
+
+#ifndef BOOST_BEAST_HTTP_IMPL_DATE_IPP
+#define BOOST_BEAST_HTTP_IMPL_DATE_IPP
+
+#include <boost/beast/http/date.hpp>
+#include <boost/beast/http/detail/date_service.hpp>
+#include <ctime>
+
+namespace boost {
+namespace beast {
+namespace http {
+
+string_view
+current_date(net::execution_context& ctx)
+{
+    return net::use_service<
+        detail::date_service>(ctx).get(std::time(nullptr));
+}
+
+} // http
+} // beast
+} // boost
+
+#endif
@@ -12,6 +12,7 @@
 
 #include <boost/beast/http/field.hpp>
 #include <boost/assert.hpp>
+#include <algorithm>
 #include <array>
 #include <cstdint>
 #include <cstring>
@@ -25,52 +26,70 @@ namespace detail {
 
 struct field_table
 {
+    using array_type =
+        std::array<string_view, 130>;
+
+    // Number of known fields
+    static std::size_t constexpr N = 129;
+
+    // Number of buckets in the first level of the hash
+    static std::size_t constexpr B = 64;
+
+    /*  The key of a name is its length and four of its
+        characters, converted to lowercase together.
+        It is unique for every known field and it is
+        mixed with a single multiplication.
+    */
     static
-    std::uint32_t
-    get_chars(
-        unsigned char const* p) noexcept
+    std::uint64_t
+    hash(string_view s) noexcept
     {
-        // VFALCO memcpy is endian-dependent
-        //std::memcpy(&v, p, 4);
-        // Compiler should be smart enough to
-        // optimize this down to one instruction.
-        return
-             p[0] |
-            (p[1] <<  8) |
-            (p[2] << 16) |
-            (p[3] << 24);
+        auto const n = s.size();
+        BOOST_ASSERT(n >= 2);
+        auto const p = reinterpret_cast<
+            unsigned char const*>(s.data());
+        std::uint32_t const v =
+             static_cast<std::uint32_t>(p[0]) |
+            (static_cast<std::uint32_t>(p[n / 2]) <<  8) |
+            (static_cast<std::uint32_t>(p[n - 2]) << 16) |
+            (static_cast<std::uint32_t>(p[n - 1]) << 24);
+        std::uint64_t const k =
+            (v | 0x20202020) | // convert to lower
+            (static_cast<std::uint64_t>(n) << 32);
+        return k * 0x9e3779b97f4a7c15;
     }
 
-    using array_type =
-        std::array<string_view, 130>;
+    static
+    std::size_t
+    bucket(std::uint64_t h) noexcept
+    {
+        return static_cast<std::size_t>(h >> 58);
+    }
 
-    // Strings are converted to lowercase
+    // Position of a name in the second level, given
+    // the displacement of its bucket as a pair of
+    // residues. Every position is reachable.
     static
-    std::uint32_t
-    digest(string_view s)
+    std::size_t
+    slot(
+        std::uint64_t h,
+        std::uint32_t d0,
+        std::uint32_t d1) noexcept
     {
-        std::uint32_t r = 0;
-        std::size_t n = s.size();
-        auto p = reinterpret_cast<
-            unsigned char const*>(s.data());
-        // consume N characters at a time
-        // VFALCO Can we do 8 on 64-bit systems?
-        while(n >= 4)
-        {
-            auto const v = get_chars(p);
-            r = (r * 5 + (
-                v | 0x20202020 )); // convert to lower
-            p += 4;
-            n -= 4;
-        }
-        // handle remaining characters
-        while( n > 0 )
-        {
-            r = r * 5 + ( *p | 0x20 );
-            ++p;
-            --n;
-        }
-        return r;
+        auto const g1 = static_cast<std::uint32_t>(h >> 20) & 0xffff;
+        auto const g2 = static_cast<std::uint32_t>(h >> 36) & 0xffff;
+        return (g1 + g2 * d0 + d1) % N;
+    }
+
+    static
+    std::uint64_t
+    get_chars(
+        unsigned char const* p) noexcept
+    {
+        // The byte order does not matter for equality
+        std::uint64_t v;
+        std::memcpy(&v, p, sizeof(v));
+        return v;
     }
 
     // This comparison is case-insensitive, and the
@@ -79,7 +98,6 @@ struct field_table
     bool
     equals(string_view lhs, string_view rhs)
     {
-        using Int = std::uint32_t; // VFALCO std::size_t?
         auto n = lhs.size();
         if(n != rhs.size())
             return false;
@@ -87,15 +105,15 @@ struct field_table
             unsigned char const*>(lhs.data());
         auto p2 = reinterpret_cast<
             unsigned char const*>(rhs.data());
-        auto constexpr S = sizeof(Int);
-        auto constexpr Mask = static_cast<Int>(
-            0xDFDFDFDFDFDFDFDF & ~Int{0});
-        for(; n >= S; p1 += S, p2 += S, n -= S)
+        auto constexpr Mask = 0xDFDFDFDFDFDFDFDFULL;
+        if(n >= 8)
         {
-            Int const v1 = get_chars(p1);
-            Int const v2 = get_chars(p2);
-            if((v1 ^ v2) & Mask)
-                return false;
+            for(; n > 8; p1 += 8, p2 += 8, n -= 8)
+                if((get_chars(p1) ^ get_chars(p2)) & Mask)
+                    return false;
+            // The last word may overlap the previous one
+            return ((get_chars(p1 + n - 8) ^
+                get_chars(p2 + n - 8)) & Mask) == 0;
         }
         for(; n; ++p1, ++p2, --n)
             if(( *p1 ^ *p2) & 0xDF)
@@ -105,7 +123,10 @@ struct field_table
 
     array_type by_name_;
 
-    enum { N = 1367 };
+    // A minimal perfect hash over the known fields: the
+    // displacement for each bucket, and the field at each
+    // position of the second level.
+    unsigned char disp_[ B ][ 2 ] = {};
     unsigned char map_[ N ] = {};
 
     /*
@@ -247,23 +268,70 @@ struct field_table
             "X-XSS-Protection"
         }})
     {
-        for(std::size_t i = 1; i < by_name_.size(); ++i)
+        BOOST_ASSERT(by_name_.size() == N + 1);
+
+        // Place the largest buckets first, each with the
+        // smallest displacement which puts all of its
+        // names into unused, distinct positions.
+        std::uint64_t h[N];
+        std::size_t count[B] = {};
+        std::size_t largest = 0;
+        for(std::size_t i = 0; i < N; ++i)
+        {
+            h[i] = hash(by_name_[i + 1]);
+            auto const n = ++count[bucket(h[i])];
+            if(largest < n)
+                largest = n;
+        }
+        bool used[N] = {};
+        for(auto size = largest; size > 0; --size)
         {
-            auto sv = by_name_[ i ];
-            auto h = digest(sv);
-            auto j = h % N;
-            BOOST_ASSERT(map_[j] == 0);
-            map_[j] = static_cast<unsigned char>(i);
+            for(std::size_t b = 0; b < B; ++b)
+            {
+                if(count[b] != size)
+                    continue;
+                std::size_t pos[N];
+                std::uint32_t d = 0;
+                for(; d < N * N; ++d)
+                {
+                    std::size_t n = 0;
+                    for(std::size_t i = 0; i < N; ++i)
+                    {
+                        if(bucket(h[i]) != b)
+                            continue;
+                        auto const j = slot(h[i], d % N, d / N);
+                        if(used[j] || std::find(
+                                pos, pos + n, j) != pos + n)
+                            break;
+                        pos[n++] = j;
+                    }
+                    if(n == size)
+                        break;
+                }
+                BOOST_ASSERT(d < N * N);
+                disp_[b][0] = static_cast<unsigned char>(d % N);
+                disp_[b][1] = static_cast<unsigned char>(d / N);
+                for(std::size_t i = 0; i < N; ++i)
+                {
+                    if(bucket(h[i]) != b)
+                        continue;
+                    auto const j = slot(h[i], d % N, d / N);
+                    used[j] = true;
+                    map_[j] = static_cast<unsigned char>(i + 1);
+                }
+            }
         }
     }
 
     field
     string_to_field(string_view s) const
     {
-        auto h = digest(s);
-        auto j = h % N;
-        int i = map_[j];
-        if(i != 0 && equals(s, by_name_[i]))
+        if(s.size() < 2)
+            return field::unknown;
+        auto const h = hash(s);
+        auto const d = disp_[bucket(h)];
+        int const i = map_[slot(h, d[0], d[1])];
+        if(equals(s, by_name_[i]))
             return static_cast<field>(i);
         return field::unknown;
     }
@@ -10,6 +10,7 @@
 #ifndef BOOST_BEAST_HTTP_IMPL_FIELDS_HPP
 #define BOOST_BEAST_HTTP_IMPL_FIELDS_HPP
 
+#include <boost/beast/core/buffer_traits.hpp>
 #include <boost/beast/core/buffers_cat.hpp>
 #include <boost/beast/core/string.hpp>
 #include <boost/beast/core/detail/buffers_ref.hpp>
@@ -19,6 +20,7 @@
 #include <boost/beast/core/static_string.hpp>
 #include <boost/beast/http/verb.hpp>
 #include <boost/beast/http/rfc7230.hpp>
+#include <boost/beast/http/detail/status_line.hpp>
 #include <boost/beast/http/status.hpp>
 #include <boost/beast/http/chunk_encode.hpp>
 #include <boost/core/exchange.hpp>
@@ -142,12 +144,21 @@ public:
         net::const_buffer,
         net::const_buffer,
         field_range,
-        chunk_crlf>;
+        net::const_buffer>;
 
     basic_fields const& f_;
     boost::optional<view_type> view_;
     char buf_[13];
 
+    void
+    init(unsigned version, verb v);
+
+    void
+    init(unsigned version, unsigned code);
+
+    void
+    init_rendered();
+
 public:
     using const_buffers_type =
         beast::detail::buffers_ref<view_type>;
@@ -177,7 +188,7 @@ writer(basic_fields const& f)
         net::const_buffer{nullptr, 0},
         net::const_buffer{nullptr, 0},
         field_range(f_.list_.begin(), f_.list_.end()),
-        chunk_crlf());
+        net::const_buffer{"\r\n", 2});
 }
 
 template<class Allocator>
@@ -185,6 +196,58 @@ basic_fields<Allocator>::writer::
 writer(basic_fields const& f,
         unsigned version, verb v)
     : f_(f)
+{
+    if(! f_.contiguous_)
+    {
+        init(version, v);
+        return;
+    }
+    auto const line = static_cast<unsigned>(v) << 1;
+    if(! f_.is_rendered(version, line))
+    {
+        init(version, v);
+        f_.render(*view_, version, line);
+    }
+    init_rendered();
+}
+
+template<class Allocator>
+basic_fields<Allocator>::writer::
+writer(basic_fields const& f,
+        unsigned version, unsigned code)
+    : f_(f)
+{
+    if(! f_.contiguous_)
+    {
+        init(version, code);
+        return;
+    }
+    auto const line = (code << 1) | 1;
+    if(! f_.is_rendered(version, line))
+    {
+        init(version, code);
+        f_.render(*view_, version, line);
+    }
+    init_rendered();
+}
+
+template<class Allocator>
+void
+basic_fields<Allocator>::writer::
+init_rendered()
+{
+    view_.emplace(
+        net::const_buffer{f_.rendered_, f_.rendered_size_},
+        net::const_buffer{nullptr, 0},
+        net::const_buffer{nullptr, 0},
+        field_range(f_.list_.end(), f_.list_.end()),
+        net::const_buffer{nullptr, 0});
+}
+
+template<class Allocator>
+void
+basic_fields<Allocator>::writer::
+init(unsigned version, verb v)
 {
 /*
     request
@@ -200,6 +263,21 @@ writer(basic_fields const& f,
 
     // target_or_reason_ has a leading SP
 
+    auto const suffix =
+        detail::request_line_suffix(version);
+    if(! suffix.empty())
+    {
+        view_.emplace(
+            net::const_buffer{sv.data(), sv.size()},
+            net::const_buffer{
+                f_.target_or_reason_.data(),
+                f_.target_or_reason_.size()},
+            net::const_buffer{suffix.data(), suffix.size()},
+            field_range(f_.list_.begin(), f_.list_.end()),
+            net::const_buffer{"\r\n", 2});
+        return;
+    }
+
     buf_[0] = ' ';
     buf_[1] = 'H';
     buf_[2] = 'T';
@@ -219,14 +297,13 @@ writer(basic_fields const& f,
             f_.target_or_reason_.size()},
         net::const_buffer{buf_, 11},
         field_range(f_.list_.begin(), f_.list_.end()),
-        chunk_crlf());
+        net::const_buffer{"\r\n", 2});
 }
 
 template<class Allocator>
+void
 basic_fields<Allocator>::writer::
-writer(basic_fields const& f,
-        unsigned version, unsigned code)
-    : f_(f)
+init(unsigned version, unsigned code)
 {
 /*
     response
@@ -234,6 +311,22 @@ writer(basic_fields const& f,
         "<reason>"
         "\r\n"
 */
+    if(f_.target_or_reason_.empty())
+    {
+        // the whole line is pre-rendered for the common cases
+        auto const line = detail::status_line(version, code);
+        if(! line.empty())
+        {
+            view_.emplace(
+                net::const_buffer{line.data(), line.size()},
+                net::const_buffer{nullptr, 0},
+                net::const_buffer{nullptr, 0},
+                field_range(f_.list_.begin(), f_.list_.end()),
+                net::const_buffer{"\r\n", 2});
+            return;
+        }
+    }
+
     buf_[0] = 'H';
     buf_[1] = 'T';
     buf_[2] = 'T';
@@ -259,7 +352,7 @@ writer(basic_fields const& f,
         net::const_buffer{sv.data(), sv.size()},
         net::const_buffer{"\r\n", 2},
         field_range(f_.list_.begin(), f_.list_.end()),
-        chunk_crlf{});
+        net::const_buffer{"\r\n", 2});
 }
 
 //------------------------------------------------------------------------------
@@ -353,6 +446,7 @@ basic_fields<Allocator>::
     realloc_string(method_, {});
     realloc_string(
         target_or_reason_, {});
+    release_rendered();
 }
 
 template<class Allocator>
@@ -372,6 +466,7 @@ basic_fields(basic_fields&& other) noexcept
     , method_(boost::exchange(other.method_, {}))
     , target_or_reason_(boost::exchange(other.target_or_reason_, {}))
 {
+    take_rendered(other);
 }
 
 template<class Allocator>
@@ -389,6 +484,7 @@ basic_fields(basic_fields&& other, Allocator const& alloc)
         list_ = std::move(other.list_);
         method_ = other.method_;
         target_or_reason_ = other.target_or_reason_;
+        take_rendered(other);
     }
 }
 
@@ -531,6 +627,7 @@ clear()
     delete_list();
     set_.clear();
     list_.clear();
+    invalidate();
 }
 
 template<class Allocator>
@@ -1013,6 +1110,7 @@ void
 basic_fields<Allocator>::
 insert_element(element& e)
 {
+    invalidate();
     auto const before =
         set_.upper_bound(e.name_string(), key_compare{});
     if(before == set_.begin())
@@ -1041,6 +1139,7 @@ void
 basic_fields<Allocator>::
 delete_element(element& e)
 {
+    invalidate();
     auto a = rebind_type{this->get()};
     auto const n =
         (sizeof(element) + e.off_ + e.len_ + 2 + sizeof(align_type) - 1) /
@@ -1055,6 +1154,7 @@ void
 basic_fields<Allocator>::
 set_element(element& e)
 {
+    invalidate();
     auto it = set_.lower_bound(
         e.name_string(), key_compare{});
     if(it == set_.end() || ! beast::iequals(
@@ -1087,6 +1187,7 @@ realloc_string(string_view& dest, string_view s)
 {
     if(dest.empty() && s.empty())
         return;
+    invalidate();
     auto a = typename beast::detail::allocator_traits<
         Allocator>::template rebind_alloc<
             char>(this->get());
@@ -1116,6 +1217,7 @@ realloc_target(
     // the writer class.
     if(dest.empty() && s.empty())
         return;
+    invalidate();
     auto a = typename beast::detail::allocator_traits<
         Allocator>::template rebind_alloc<
             char>(this->get());
@@ -1146,6 +1248,7 @@ copy_all(basic_fields<OtherAlloc> const& other)
     realloc_string(method_, other.method_);
     realloc_string(target_or_reason_,
         other.target_or_reason_);
+    contiguous_ = other.contiguous_;
 }
 
 template<class Allocator>
@@ -1156,6 +1259,7 @@ clear_all()
     clear();
     realloc_string(method_, {});
     realloc_string(target_or_reason_, {});
+    release_rendered();
 }
 
 template<class Allocator>
@@ -1183,6 +1287,7 @@ move_assign(basic_fields& other, std::true_type)
     target_or_reason_ = other.target_or_reason_;
     other.method_ = {};
     other.target_or_reason_ = {};
+    take_rendered(other);
 }
 
 template<class Allocator>
@@ -1204,6 +1309,7 @@ move_assign(basic_fields& other, std::false_type)
         target_or_reason_ = other.target_or_reason_;
         other.method_ = {};
         other.target_or_reason_ = {};
+        take_rendered(other);
     }
 }
 
@@ -1240,6 +1346,12 @@ swap(basic_fields& other, std::true_type)
     swap(list_, other.list_);
     swap(method_, other.method_);
     swap(target_or_reason_, other.target_or_reason_);
+    swap(rendered_, other.rendered_);
+    swap(rendered_size_, other.rendered_size_);
+    swap(rendered_capacity_, other.rendered_capacity_);
+    swap(rendered_version_, other.rendered_version_);
+    swap(rendered_line_, other.rendered_line_);
+    swap(contiguous_, other.contiguous_);
 }
 
 template<class Allocator>
@@ -1254,6 +1366,79 @@ swap(basic_fields& other, std::false_type)
     swap(list_, other.list_);
     swap(method_, other.method_);
     swap(target_or_reason_, other.target_or_reason_);
+    swap(rendered_, other.rendered_);
+    swap(rendered_size_, other.rendered_size_);
+    swap(rendered_capacity_, other.rendered_capacity_);
+    swap(rendered_version_, other.rendered_version_);
+    swap(rendered_line_, other.rendered_line_);
+    swap(contiguous_, other.contiguous_);
+}
+
+template<class Allocator>
+void
+basic_fields<Allocator>::
+contiguous_header(bool v)
+{
+    contiguous_ = v;
+    if(! v)
+        release_rendered();
+}
+
+template<class Allocator>
+template<class ConstBufferSequence>
+void
+basic_fields<Allocator>::
+render(ConstBufferSequence const& buffers,
+    unsigned version, unsigned line) const
+{
+    auto const size = buffer_bytes(buffers);
+    if(size > rendered_capacity_)
+    {
+        auto a = typename beast::detail::allocator_traits<
+            Allocator>::template rebind_alloc<
+                char>(this->get());
+        auto const p = a.allocate(size);
+        if(rendered_)
+            a.deallocate(rendered_, rendered_capacity_);
+        rendered_ = p;
+        rendered_capacity_ = size;
+    }
+    net::buffer_copy(
+        net::mutable_buffer(rendered_, size), buffers);
+    rendered_size_ = size;
+    rendered_version_ = version;
+    rendered_line_ = line;
+}
+
+template<class Allocator>
+void
+basic_fields<Allocator>::
+release_rendered() noexcept
+{
+    if(rendered_)
+    {
+        auto a = typename beast::detail::allocator_traits<
+            Allocator>::template rebind_alloc<
+                char>(this->get());
+        a.deallocate(rendered_, rendered_capacity_);
+    }
+    rendered_ = nullptr;
+    rendered_size_ = 0;
+    rendered_capacity_ = 0;
+}
+
+template<class Allocator>
+void
+basic_fields<Allocator>::
+take_rendered(basic_fields& other) noexcept
+{
+    release_rendered();
+    rendered_ = boost::exchange(other.rendered_, nullptr);
+    rendered_size_ = boost::exchange(other.rendered_size_, 0);
+    rendered_capacity_ = boost::exchange(other.rendered_capacity_, 0);
+    rendered_version_ = other.rendered_version_;
+    rendered_line_ = other.rendered_line_;
+    contiguous_ = boost::exchange(other.contiguous_, false);
 }
 
 } // http
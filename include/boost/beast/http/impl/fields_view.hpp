@@ -0,0 +1,321 @@
+//
+// Copyright (c) 2016-2019 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/beast
+//
+
+#ifndef BOOST_BEAST_HTTP_IMPL_FIELDS_VIEW_HPP
+#define BOOST_BEAST_HTTP_IMPL_FIELDS_VIEW_HPP
+
+#include <boost/beast/core/string.hpp>
+#include <boost/assert.hpp>
+#include <boost/throw_exception.hpp>
+#include <algorithm>
+#include <stdexcept>
+
+namespace boost {
+namespace beast {
+namespace http {
+
+template<class Allocator>
+basic_fields_view<Allocator>::
+value_type::
+value_type(
+    field f,
+    string_view name,
+    string_view value)
+    : name_(name)
+    , value_(value)
+    , f_(f)
+{
+}
+
+template<class Allocator>
+inline
+field
+basic_fields_view<Allocator>::
+value_type::
+name() const
+{
+    return f_;
+}
+
+template<class Allocator>
+inline
+string_view const
+basic_fields_view<Allocator>::
+value_type::
+name_string() const
+{
+    return name_;
+}
+
+template<class Allocator>
+inline
+string_view const
+basic_fields_view<Allocator>::
+value_type::
+value() const
+{
+    return value_;
+}
+
+//------------------------------------------------------------------------------
+
+template<class Allocator>
+basic_fields_view<Allocator>::
+basic_fields_view(Allocator const& alloc)
+    : list_(list_alloc_type(alloc))
+    , spill_(spill_alloc_type(alloc))
+{
+}
+
+//------------------------------------------------------------------------------
+//
+// Element access
+//
+//------------------------------------------------------------------------------
+
+template<class Allocator>
+string_view const
+basic_fields_view<Allocator>::
+at(field name) const
+{
+    BOOST_ASSERT(name != field::unknown);
+    auto const it = find(name);
+    if(it == end())
+        BOOST_THROW_EXCEPTION(std::out_of_range{
+            "field not found"});
+    return it->value();
+}
+
+template<class Allocator>
+string_view const
+basic_fields_view<Allocator>::
+at(string_view name) const
+{
+    auto const it = find(name);
+    if(it == end())
+        BOOST_THROW_EXCEPTION(std::out_of_range{
+            "field not found"});
+    return it->value();
+}
+
+template<class Allocator>
+string_view const
+basic_fields_view<Allocator>::
+operator[](field name) const
+{
+    BOOST_ASSERT(name != field::unknown);
+    auto const it = find(name);
+    if(it == end())
+        return {};
+    return it->value();
+}
+
+template<class Allocator>
+string_view const
+basic_fields_view<Allocator>::
+operator[](string_view name) const
+{
+    auto const it = find(name);
+    if(it == end())
+        return {};
+    return it->value();
+}
+
+//------------------------------------------------------------------------------
+//
+// Modifiers
+//
+//------------------------------------------------------------------------------
+
+template<class Allocator>
+void
+basic_fields_view<Allocator>::
+clear() noexcept
+{
+    list_.clear();
+    spill_.clear();
+}
+
+template<class Allocator>
+void
+basic_fields_view<Allocator>::
+swap(basic_fields_view& other)
+{
+    list_.swap(other.list_);
+    spill_.swap(other.spill_);
+}
+
+template<class Allocator>
+void
+swap(
+    basic_fields_view<Allocator>& lhs,
+    basic_fields_view<Allocator>& rhs)
+{
+    lhs.swap(rhs);
+}
+
+//------------------------------------------------------------------------------
+//
+// Lookup
+//
+//------------------------------------------------------------------------------
+
+template<class Allocator>
+std::size_t
+basic_fields_view<Allocator>::
+count(field name) const
+{
+    BOOST_ASSERT(name != field::unknown);
+    auto const r = equal_range(name);
+    return static_cast<std::size_t>(r.second - r.first);
+}
+
+template<class Allocator>
+std::size_t
+basic_fields_view<Allocator>::
+count(string_view name) const
+{
+    auto const r = equal_range(name);
+    return static_cast<std::size_t>(r.second - r.first);
+}
+
+template<class Allocator>
+bool
+basic_fields_view<Allocator>::
+contains(field name) const
+{
+    BOOST_ASSERT(name != field::unknown);
+    return find(name) != end();
+}
+
+template<class Allocator>
+bool
+basic_fields_view<Allocator>::
+contains(string_view name) const
+{
+    return find(name) != end();
+}
+
+template<class Allocator>
+inline
+auto
+basic_fields_view<Allocator>::
+find(field name) const ->
+    const_iterator
+{
+    BOOST_ASSERT(name != field::unknown);
+    return find_impl(name, {});
+}
+
+template<class Allocator>
+auto
+basic_fields_view<Allocator>::
+find(string_view name) const ->
+    const_iterator
+{
+    return find_impl(string_to_field(name), name);
+}
+
+template<class Allocator>
+auto
+basic_fields_view<Allocator>::
+equal_range(field name) const ->
+    std::pair<const_iterator, const_iterator>
+{
+    BOOST_ASSERT(name != field::unknown);
+    auto first = find(name);
+    auto last = first;
+    while(last != end() && last->f_ == name)
+        ++last;
+    return {first, last};
+}
+
+template<class Allocator>
+auto
+basic_fields_view<Allocator>::
+equal_range(string_view name) const ->
+    std::pair<const_iterator, const_iterator>
+{
+    auto const f = string_to_field(name);
+    auto first = find_impl(f, name);
+    auto last = first;
+    while(last != end() && matches(*last, f, name))
+        ++last;
+    return {first, last};
+}
+
+//------------------------------------------------------------------------------
+
+// Every field has the enumeration of its name,
+// so a known name is matched on the enumeration alone.
+template<class Allocator>
+bool
+basic_fields_view<Allocator>::
+matches(
+    value_type const& e,
+    field name,
+    string_view sname) noexcept
+{
+    if(name != field::unknown)
+        return e.f_ == name;
+    return
+        e.f_ == field::unknown &&
+        beast::iequals(e.name_, sname);
+}
+
+template<class Allocator>
+auto
+basic_fields_view<Allocator>::
+find_impl(field name, string_view sname) const ->
+    const_iterator
+{
+    auto it = begin();
+    auto const last = end();
+    for(; it != last; ++it)
+        if(matches(*it, name, sname))
+            break;
+    return it;
+}
+
+// Fields with the same name are kept together, so a repeated
+// name goes after the last field having it. Headers rarely
+// repeat a name, in which case this appends.
+template<class Allocator>
+void
+basic_fields_view<Allocator>::
+insert(field name, string_view sname, string_view value)
+{
+    auto const it = std::find_if(
+        list_.rbegin(), list_.rend(),
+        [&](value_type const& e)
+        {
+            return matches(e, name, sname);
+        });
+    if(it == list_.rend())
+        list_.push_back(value_type(name, sname, value));
+    else
+        list_.insert(it.base(), value_type(name, sname, value));
+}
+
+template<class Allocator>
+void
+basic_fields_view<Allocator>::
+insert_copy(field name, string_view sname, string_view value)
+{
+    spill_.emplace_front(value.data(), value.size(),
+        char_alloc_type(list_.get_allocator()));
+    auto const& s = spill_.front();
+    insert(name, sname, string_view(s.data(), s.size()));
+}
+
+} // http
+} // beast
+} // boost
+
+#endif
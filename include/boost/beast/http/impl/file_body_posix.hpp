@@ -0,0 +1,429 @@
+//
+// Copyright (c) 2016-2019 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/beast
+//
+
+#ifndef BOOST_BEAST_HTTP_IMPL_FILE_BODY_POSIX_HPP
+#define BOOST_BEAST_HTTP_IMPL_FILE_BODY_POSIX_HPP
+
+#include <boost/beast/core/file_posix.hpp>
+
+#if ! defined(BOOST_BEAST_USE_POSIX_SENDFILE)
+# if BOOST_BEAST_USE_POSIX_FILE && defined(__linux__) && \
+    ! defined(BOOST_BEAST_NO_POSIX_SENDFILE)
+#  define BOOST_BEAST_USE_POSIX_SENDFILE 1
+# else
+#  define BOOST_BEAST_USE_POSIX_SENDFILE 0
+# endif
+#endif
+
+#if BOOST_BEAST_USE_POSIX_SENDFILE
+
+#include <boost/beast/core/async_base.hpp>
+#include <boost/beast/core/basic_stream.hpp>
+#include <boost/beast/core/rate_policy.hpp>
+#include <boost/beast/core/stream_traits.hpp>
+#include <boost/beast/core/detail/is_invocable.hpp>
+#include <boost/beast/http/basic_file_body.hpp>
+#include <boost/beast/http/error.hpp>
+#include <boost/beast/http/write.hpp>
+#include <boost/beast/http/serializer.hpp>
+#include <boost/asio/async_result.hpp>
+#include <boost/asio/basic_stream_socket.hpp>
+#include <boost/asio/error.hpp>
+#include <boost/asio/socket_base.hpp>
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <type_traits>
+#include <sys/sendfile.h>
+
+namespace boost {
+namespace beast {
+namespace http {
+
+namespace detail {
+
+class null_posix_lambda
+{
+public:
+    template<class ConstBufferSequence>
+    void
+    operator()(error_code&,
+        ConstBufferSequence const&) const
+    {
+        BOOST_ASSERT(false);
+    }
+};
+
+// Send the next part of the body directly from the file
+// to the socket. The file position advances, so the
+// writer can continue from where sendfile stopped.
+template<bool isRequest, class Fields>
+std::size_t
+sendfile_some(
+    int fd,
+    serializer<isRequest,
+        basic_file_body<file_posix>, Fields>& sr,
+    error_code& ec)
+{
+    auto& w = sr.writer_impl();
+    auto& remain = file_body_access::remain(w);
+    if(remain > 0)
+    {
+        // Linux transfers at most 0x7ffff000 bytes per call
+        auto const amount = static_cast<std::size_t>(
+            (std::min<std::uint64_t>)(
+                (std::min<std::uint64_t>)(remain, sr.limit()),
+                0x7ffff000));
+        auto const n = ::sendfile(fd, file_body_access::file(
+            w).native_handle(), nullptr, amount);
+        if(n < 0)
+        {
+            ec.assign(errno, system_category());
+            return 0;
+        }
+        if(n == 0)
+        {
+            // the file is shorter than its cached size
+            BOOST_BEAST_ASSIGN_EC(ec, error::short_read);
+            return 0;
+        }
+        BOOST_ASSERT(static_cast<std::uint64_t>(n) <= remain);
+        remain -= static_cast<std::uint64_t>(n);
+        if(remain > 0)
+        {
+            ec = {};
+            return static_cast<std::size_t>(n);
+        }
+        sr.next(ec, null_posix_lambda{});
+        BOOST_ASSERT(! ec);
+        BOOST_ASSERT(sr.is_done());
+        return static_cast<std::size_t>(n);
+    }
+    sr.next(ec, null_posix_lambda{});
+    BOOST_ASSERT(! ec);
+    BOOST_ASSERT(sr.is_done());
+    return 0;
+}
+
+inline
+bool
+sendfile_would_block(error_code const& ec) noexcept
+{
+    return
+        ec == net::error::would_block ||
+        ec == net::error::try_again;
+}
+
+template<class Protocol, class Executor>
+net::basic_stream_socket<Protocol, Executor>&
+sendfile_socket(
+    net::basic_stream_socket<Protocol, Executor>& sock) noexcept
+{
+    return sock;
+}
+
+template<class Protocol, class Executor>
+net::basic_stream_socket<Protocol, Executor>&
+sendfile_socket(
+    basic_stream<Protocol, Executor,
+        unlimited_rate_policy>& stream) noexcept
+{
+    return stream.socket();
+}
+
+/*  When the socket cannot accept more data, a plain
+    socket waits until it is writable and tries again.
+    A basic_stream instead writes the next part of the
+    body through the stream, so that the timeout of the
+    stream applies whenever the operation has to wait.
+    That write may take only part of the buffer which
+    the serializer read from the file. The rest is
+    written the same way before the operation completes,
+    because sendfile continues from the file position.
+*/
+template<
+    class Stream,
+    bool isRequest, class Fields,
+    class Handler>
+class write_some_posix_op
+    : public beast::async_base<
+        Handler, beast::executor_type<Stream>>
+{
+    Stream& s_;
+    serializer<isRequest,
+        basic_file_body<file_posix>, Fields>& sr_;
+    std::uint64_t mark_ = 0;
+    std::uint64_t unsent_ = 0;
+    std::size_t bytes_transferred_ = 0;
+    bool drain_ = false;
+
+    std::uint64_t
+    remain() noexcept
+    {
+        return file_body_access::remain(sr_.writer_impl());
+    }
+
+    using is_socket = std::is_same<Stream,
+        typename std::decay<decltype(sendfile_socket(
+            std::declval<Stream&>()))>::type>;
+
+    void
+    wait(std::true_type)
+    {
+        s_.async_wait(
+            net::socket_base::wait_write,
+            std::move(*this));
+    }
+
+    void
+    wait(std::false_type)
+    {
+        mark_ = remain();
+        drain_ = true;
+        detail::async_write_some_impl(
+            s_, sr_, std::move(*this));
+    }
+
+public:
+    template<class Handler_>
+    write_some_posix_op(
+        Handler_&& h,
+        Stream& s,
+        serializer<isRequest,
+            basic_file_body<file_posix>, Fields>& sr)
+        : async_base<
+            Handler, beast::executor_type<Stream>>(
+                std::forward<Handler_>(h),
+                s.get_executor())
+        , s_(s)
+        , sr_(sr)
+    {
+        (*this)();
+    }
+
+    void
+    operator()()
+    {
+        if(! sr_.is_header_done())
+        {
+            sr_.split(true);
+            return detail::async_write_some_impl(
+                s_, sr_, std::move(*this));
+        }
+        if(sr_.get().chunked())
+        {
+            return detail::async_write_some_impl(
+                s_, sr_, std::move(*this));
+        }
+        auto& sock = sendfile_socket(s_);
+        error_code ec;
+        if(! sock.native_non_blocking())
+        {
+            sock.native_non_blocking(true, ec);
+            if(ec)
+                return this->complete(false, ec, 0);
+        }
+        auto const n = sendfile_some(
+            sock.native_handle(), sr_, ec);
+        if(sendfile_would_block(ec))
+            return wait(is_socket{});
+        this->complete(false, ec, n);
+    }
+
+    void
+    operator()(error_code ec)
+    {
+        std::size_t n = 0;
+        if(! ec)
+        {
+            n = sendfile_some(sendfile_socket(
+                s_).native_handle(), sr_, ec);
+            if(sendfile_would_block(ec))
+                return wait(is_socket{});
+        }
+        this->complete_now(ec, n);
+    }
+
+    void
+    operator()(
+        error_code ec,
+        std::size_t bytes_transferred)
+    {
+        bytes_transferred_ += bytes_transferred;
+        if(drain_ && ! ec)
+        {
+            // Count the bytes the serializer read
+            // from the file and did not write yet
+            unsent_ += mark_ - remain();
+            BOOST_ASSERT(bytes_transferred <= unsent_);
+            unsent_ -= bytes_transferred;
+            if(unsent_ > 0)
+            {
+                mark_ = remain();
+                return detail::async_write_some_impl(
+                    s_, sr_, std::move(*this));
+            }
+        }
+        this->complete_now(ec, bytes_transferred_);
+    }
+};
+
+template<class Stream>
+struct run_write_some_posix_op
+{
+    Stream* stream;
+
+    using executor_type = beast::executor_type<Stream>;
+
+    executor_type
+    get_executor() const noexcept
+    {
+        return stream->get_executor();
+    }
+
+    template<bool isRequest, class Fields, class WriteHandler>
+    void
+    operator()(
+        WriteHandler&& h,
+        serializer<isRequest,
+            basic_file_body<file_posix>, Fields>* sr)
+    {
+        // If you get an error on the following line it means
+        // that your handler does not meet the documented type
+        // requirements for the handler.
+
+        static_assert(
+            beast::detail::is_invocable<WriteHandler,
+            void(error_code, std::size_t)>::value,
+            "WriteHandler type requirements not met");
+
+        write_some_posix_op<
+            Stream, isRequest, Fields,
+            typename std::decay<WriteHandler>::type>(
+                std::forward<WriteHandler>(h), *stream, *sr);
+    }
+};
+
+template<
+    class Protocol, class Executor,
+    bool isRequest, class Fields>
+std::size_t
+write_some_posix(
+    net::basic_stream_socket<
+        Protocol, Executor>& sock,
+    serializer<isRequest,
+        basic_file_body<file_posix>, Fields>& sr,
+    error_code& ec)
+{
+    if(! sr.is_header_done())
+    {
+        sr.split(true);
+        return detail::write_some_impl(sock, sr, ec);
+    }
+    if(sr.get().chunked())
+        return detail::write_some_impl(sock, sr, ec);
+    for(;;)
+    {
+        auto const n = sendfile_some(
+            sock.native_handle(), sr, ec);
+        if(! sendfile_would_block(ec) || sock.non_blocking())
+            return n;
+
+        // The socket was made non-blocking by an
+        // asynchronous operation, so wait as a
+        // blocking write would.
+        sock.wait(net::socket_base::wait_write, ec);
+        if(ec)
+            return 0;
+    }
+}
+
+} // detail
+
+//------------------------------------------------------------------------------
+
+template<
+    class Protocol, class Executor,
+    bool isRequest, class Fields>
+std::size_t
+write_some(
+    net::basic_stream_socket<
+        Protocol, Executor>& sock,
+    serializer<isRequest,
+        basic_file_body<file_posix>, Fields>& sr,
+    error_code& ec)
+{
+    return detail::write_some_posix(sock, sr, ec);
+}
+
+template<
+    class Protocol, class Executor,
+    bool isRequest, class Fields>
+std::size_t
+write_some(
+    basic_stream<Protocol, Executor,
+        unlimited_rate_policy>& stream,
+    serializer<isRequest,
+        basic_file_body<file_posix>, Fields>& sr,
+    error_code& ec)
+{
+    return detail::write_some_posix(stream.socket(), sr, ec);
+}
+
+template<
+    class Protocol, class Executor,
+    bool isRequest, class Fields,
+    BOOST_BEAST_ASYNC_TPARAM2 WriteHandler>
+BOOST_BEAST_ASYNC_RESULT2(WriteHandler)
+async_write_some(
+    net::basic_stream_socket<
+        Protocol, Executor>& sock,
+    serializer<isRequest,
+        basic_file_body<file_posix>, Fields>& sr,
+    WriteHandler&& handler)
+{
+    return net::async_initiate<
+        WriteHandler,
+        void(error_code, std::size_t)>(
+            detail::run_write_some_posix_op<
+                net::basic_stream_socket<
+                    Protocol, Executor>>{&sock},
+            handler,
+            &sr);
+}
+
+template<
+    class Protocol, class Executor,
+    bool isRequest, class Fields,
+    BOOST_BEAST_ASYNC_TPARAM2 WriteHandler>
+BOOST_BEAST_ASYNC_RESULT2(WriteHandler)
+async_write_some(
+    basic_stream<Protocol, Executor,
+        unlimited_rate_policy>& stream,
+    serializer<isRequest,
+        basic_file_body<file_posix>, Fields>& sr,
+    WriteHandler&& handler)
+{
+    return net::async_initiate<
+        WriteHandler,
+        void(error_code, std::size_t)>(
+            detail::run_write_some_posix_op<
+                basic_stream<Protocol, Executor,
+                    unlimited_rate_policy>>{&stream},
+            handler,
+            &sr);
+}
+
+} // http
+} // beast
+} // boost
+
+#endif
+
+#endif
@@ -0,0 +1,328 @@
+//
+// Copyright (c) 2016-2019 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/beast
+//
+
+#ifndef BOOST_BEAST_HTTP_IMPL_MAPPED_FILE_BODY_IPP
+#define BOOST_BEAST_HTTP_IMPL_MAPPED_FILE_BODY_IPP
+
+#include <boost/beast/http/mapped_file_body.hpp>
+#include <boost/beast/core/file.hpp>
+#include <boost/beast/http/error.hpp>
+#include <boost/core/ignore_unused.hpp>
+#include <algorithm>
+#include <cerrno>
+#include <limits>
+
+#if BOOST_BEAST_USE_POSIX_FILE
+# include <sys/mman.h>
+# include <unistd.h>
+#elif BOOST_BEAST_USE_WIN32_FILE
+# include <boost/winapi/file_mapping.hpp>
+# include <boost/winapi/get_last_error.hpp>
+# include <boost/winapi/handles.hpp>
+# include <boost/winapi/page_protection_flags.hpp>
+# include <boost/winapi/system.hpp>
+#endif
+
+namespace boost {
+namespace beast {
+namespace http {
+
+struct mapped_file_body::mapping
+{
+    char const* data = nullptr; // the first byte of the range
+    std::size_t size = 0;       // the size of the range
+
+#if BOOST_BEAST_USE_POSIX_FILE || BOOST_BEAST_USE_WIN32_FILE
+    void* base = nullptr;       // the first mapped page
+    std::size_t length = 0;     // the size of the mapped pages
+#else
+    std::unique_ptr<char[]> buf;
+#endif
+
+    mapping() = default;
+    mapping(mapping const&) = delete;
+    mapping& operator=(mapping const&) = delete;
+
+    ~mapping()
+    {
+#if BOOST_BEAST_USE_POSIX_FILE
+        if(base)
+            ::munmap(base, length);
+#elif BOOST_BEAST_USE_WIN32_FILE
+        if(base)
+            boost::winapi::UnmapViewOfFile(base);
+#endif
+    }
+
+    void
+    map(file& f, std::uint64_t offset,
+        std::size_t n, error_code& ec)
+    {
+#if BOOST_BEAST_USE_POSIX_FILE
+        // mmap requires an offset which is a multiple of the page size
+        auto const page = static_cast<
+            std::uint64_t>(::sysconf(_SC_PAGESIZE));
+        auto const pad = offset % page;
+        if(n > (std::numeric_limits<std::size_t>::max)() - pad)
+        {
+            ec = make_error_code(errc::file_too_large);
+            return;
+        }
+        length = n + static_cast<std::size_t>(pad);
+        auto const p = ::mmap(nullptr, length, PROT_READ,
+            MAP_SHARED, f.native_handle(),
+            static_cast<::off_t>(offset - pad));
+        if(p == MAP_FAILED)
+        {
+            ec.assign(errno, system_category());
+            return;
+        }
+        base = p;
+        data = static_cast<char const*>(p) + pad;
+        size = n;
+        ec = {};
+#elif BOOST_BEAST_USE_WIN32_FILE
+        // views must start at a multiple of the allocation granularity
+        boost::winapi::SYSTEM_INFO_ si;
+        boost::winapi::GetSystemInfo(&si);
+        auto const pad = offset % si.dwAllocationGranularity;
+        if(n > (std::numeric_limits<std::size_t>::max)() - pad)
+        {
+            ec = make_error_code(errc::file_too_large);
+            return;
+        }
+        length = n + static_cast<std::size_t>(pad);
+        auto const h = boost::winapi::CreateFileMappingW(
+            f.native_handle(), nullptr,
+            boost::winapi::PAGE_READONLY_, 0, 0, nullptr);
+        if(! h)
+        {
+            ec.assign(boost::winapi::GetLastError(),
+                system_category());
+            return;
+        }
+        auto const start = offset - pad;
+        auto const p = boost::winapi::MapViewOfFile(h,
+            boost::winapi::FILE_MAP_READ_,
+            static_cast<boost::winapi::DWORD_>(start >> 32),
+            static_cast<boost::winapi::DWORD_>(start & 0xffffffff),
+            length);
+        if(! p)
+            ec.assign(boost::winapi::GetLastError(),
+                system_category());
+        // the view keeps the mapping object alive
+        boost::winapi::CloseHandle(h);
+        if(! p)
+            return;
+        base = p;
+        data = static_cast<char const*>(p) + pad;
+        size = n;
+        ec = {};
+#else
+        f.seek(offset, ec);
+        if(ec)
+            return;
+        buf.reset(new char[n]);
+        std::size_t nread = 0;
+        while(nread < n)
+        {
+            auto const bytes = f.read(
+                buf.get() + nread, n - nread, ec);
+            if(ec)
+                return;
+            if(bytes == 0)
+            {
+                BOOST_BEAST_ASSIGN_EC(ec, error::short_read);
+                return;
+            }
+            nread += bytes;
+        }
+        data = buf.get();
+        size = n;
+#endif
+    }
+};
+
+void
+mapped_file_body::
+value_type::
+open(char const* path, error_code& ec)
+{
+    open(path, 0, (std::numeric_limits<
+        std::uint64_t>::max)(), ec);
+}
+
+void
+mapped_file_body::
+value_type::
+open(
+    char const* path,
+    std::uint64_t offset,
+    std::uint64_t length,
+    error_code& ec)
+{
+    close();
+    file f;
+    f.open(path, file_mode::read, ec);
+    if(ec)
+        return;
+    auto const n = f.size(ec);
+    if(ec)
+        return;
+    if(offset > n)
+    {
+        ec = make_error_code(errc::invalid_argument);
+        return;
+    }
+    length = (std::min)(length, n - offset);
+    if(length > (std::numeric_limits<std::size_t>::max)())
+    {
+        ec = make_error_code(errc::file_too_large);
+        return;
+    }
+    auto m = std::make_shared<mapping>();
+    if(length > 0)
+    {
+        m->map(f, offset,
+            static_cast<std::size_t>(length), ec);
+        if(ec)
+            return;
+    }
+    assign(std::move(m));
+    ec = {};
+}
+
+void
+mapped_file_body::
+value_type::
+advise(advice hint, error_code& ec)
+{
+#if BOOST_BEAST_USE_POSIX_FILE
+    if(size_ > 0)
+    {
+        // madvise requires an address on a page boundary
+        auto const page = static_cast<
+            std::uintptr_t>(::sysconf(_SC_PAGESIZE));
+        auto const first = reinterpret_cast<
+            std::uintptr_t>(data_);
+        auto const pad = first % page;
+        int flag = MADV_NORMAL;
+        switch(hint)
+        {
+        case advice::normal:     flag = MADV_NORMAL; break;
+        case advice::sequential: flag = MADV_SEQUENTIAL; break;
+        case advice::willneed:   flag = MADV_WILLNEED; break;
+        }
+        if(::madvise(const_cast<char*>(data_ - pad),
+            size_ + pad, flag) != 0)
+        {
+            ec.assign(errno, system_category());
+            return;
+        }
+    }
+#else
+    boost::ignore_unused(hint);
+#endif
+    ec = {};
+}
+
+void
+mapped_file_body::
+value_type::
+assign(std::shared_ptr<mapping const> m) noexcept
+{
+    data_ = m->data;
+    size_ = m->size;
+    m_ = std::move(m);
+}
+
+//------------------------------------------------------------------------------
+
+mapped_file_body::value_type
+mapped_file_cache::
+open(string_view path, error_code& ec)
+{
+    mapped_file_body::value_type v;
+    {
+        std::lock_guard<std::mutex> lock(m_);
+        auto const it = map_.find(path);
+        if(it != map_.end())
+        {
+            list_.splice(list_.begin(), list_, it->second);
+            v.assign(it->second->second);
+            ec = {};
+            return v;
+        }
+    }
+
+    // Map the file without holding the lock
+    std::string s(path.data(), path.size());
+    v.open(s.c_str(), ec);
+    if(ec)
+        return v;
+    error_code ignored;
+    v.advise(hint_, ignored);
+
+    std::lock_guard<std::mutex> lock(m_);
+    auto const it = map_.find(path);
+    if(it != map_.end())
+    {
+        // Another thread mapped the file first
+        list_.splice(list_.begin(), list_, it->second);
+        v.assign(it->second->second);
+        return v;
+    }
+    if(capacity_ == 0)
+        return v;
+    list_.emplace_front(std::move(s), v.m_);
+    map_.emplace(list_.front().first, list_.begin());
+    if(list_.size() > capacity_)
+    {
+        map_.erase(list_.back().first);
+        list_.pop_back();
+    }
+    return v;
+}
+
+bool
+mapped_file_cache::
+erase(string_view path)
+{
+    std::lock_guard<std::mutex> lock(m_);
+    auto const it = map_.find(path);
+    if(it == map_.end())
+        return false;
+    auto const pos = it->second;
+    map_.erase(it);
+    list_.erase(pos);
+    return true;
+}
+
+void
+mapped_file_cache::
+clear()
+{
+    std::lock_guard<std::mutex> lock(m_);
+    map_.clear();
+    list_.clear();
+}
+
+std::size_t
+mapped_file_cache::
+size() const
+{
+    std::lock_guard<std::mutex> lock(m_);
+    return list_.size();
+}
+
+} // http
+} // beast
+} // boost
+
+#endif
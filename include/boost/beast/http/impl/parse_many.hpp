@@ -0,0 +1,84 @@
+//
+// Copyright (c) 2016-2019 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/beast
+//
+
+#ifndef BOOST_BEAST_HTTP_IMPL_PARSE_MANY_HPP
+#define BOOST_BEAST_HTTP_IMPL_PARSE_MANY_HPP
+
+#include <boost/beast/http/error.hpp>
+#include <boost/asio/buffer.hpp>
+#include <boost/system/system_error.hpp>
+#include <boost/throw_exception.hpp>
+
+namespace boost {
+namespace beast {
+namespace http {
+
+template<
+    class DynamicBuffer,
+    bool isRequest, class Body, class Allocator,
+    class Handler>
+std::size_t
+parse_many(
+    DynamicBuffer& buffer,
+    parser<isRequest, Body, Allocator>& parser,
+    Handler&& handler,
+    error_code& ec)
+{
+    static_assert(
+        net::is_dynamic_buffer<DynamicBuffer>::value,
+        "DynamicBuffer type requirements not met");
+    std::size_t count = 0;
+    ec = {};
+    parser.eager(true);
+    for(;;)
+    {
+        if(parser.is_done())
+        {
+            handler(parser.release());
+            parser.reset();
+            ++count;
+        }
+        if(buffer.size() == 0)
+            break;
+        auto const n = parser.put(buffer.data(), ec);
+        buffer.consume(n);
+        if(ec == error::need_more)
+        {
+            ec = {};
+            break;
+        }
+        if(ec || (n == 0 && ! parser.is_done()))
+            break;
+    }
+    return count;
+}
+
+template<
+    class DynamicBuffer,
+    bool isRequest, class Body, class Allocator,
+    class Handler>
+std::size_t
+parse_many(
+    DynamicBuffer& buffer,
+    parser<isRequest, Body, Allocator>& parser,
+    Handler&& handler)
+{
+    error_code ec;
+    auto const n = http::parse_many(
+        buffer, parser, handler, ec);
+    if(ec)
+        BOOST_THROW_EXCEPTION(system_error{ec});
+    return n;
+}
+
+} // http
+} // beast
+} // boost
+
+#endif
@@ -20,8 +20,8 @@ namespace http {
 template<bool isRequest, class Body, class Allocator>
 parser<isRequest, Body, Allocator>::
 parser()
-    : rd_(m_.base(), m_.body())
 {
+    rd_.emplace(m_.base(), m_.body());
 }
 
 template<bool isRequest, class Body, class Allocator>
@@ -31,8 +31,8 @@ parser(Arg1&& arg1, ArgN&&... argn)
     : m_(
         std::forward<Arg1>(arg1),
         std::forward<ArgN>(argn)...)
-    , rd_(m_.base(), m_.body())
 {
+    rd_.emplace(m_.base(), m_.body());
     m_.clear();
 }
 
@@ -44,11 +44,25 @@ parser(
     Args&&... args)
     : basic_parser<isRequest>(std::move(other))
     , m_(other.release(), std::forward<Args>(args)...)
-    , rd_(m_.base(), m_.body())
 {
     if(other.rd_inited_)
         BOOST_THROW_EXCEPTION(std::invalid_argument{
             "moved-from parser has a body"});
+    rd_.emplace(m_.base(), m_.body());
+}
+
+template<bool isRequest, class Body, class Allocator>
+void
+parser<isRequest, Body, Allocator>::
+reset()
+{
+    m_.clear();
+    clear_body(detail::is_body_clearable<
+        typename Body::value_type>{});
+    rd_.emplace(m_.base(), m_.body());
+    rd_inited_ = false;
+    used_ = false;
+    basic_parser<isRequest>::reset();
 }
 
 } // http
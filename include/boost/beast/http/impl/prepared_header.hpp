@@ -0,0 +1,67 @@
+//
+// Copyright (c) 2016-2019 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/beast
+//
+
+#ifndef BOOST_BEAST_HTTP_IMPL_PREPARED_HEADER_HPP
+#define BOOST_BEAST_HTTP_IMPL_PREPARED_HEADER_HPP
+
+#include <boost/beast/http/message.hpp>
+#include <boost/beast/http/status.hpp>
+#include <string>
+
+namespace boost {
+namespace beast {
+namespace http {
+
+struct prepared_header::part
+{
+    field name;
+    string_view name_string;
+    string_view value;
+};
+
+class prepared_header::writer
+{
+    std::string buf_;
+    net::const_buffer cb_;
+
+public:
+    using const_buffers_type = net::const_buffer;
+
+    BOOST_BEAST_DECL
+    writer(prepared_header const& f,
+        unsigned version, unsigned code);
+
+    const_buffers_type
+    get() const
+    {
+        return cb_;
+    }
+};
+
+template<class Fields>
+prepared_header::
+prepared_header(
+    header<false, Fields> const& h,
+    std::initializer_list<slot> slots)
+{
+    std::vector<part> v;
+    for(auto const& e : h)
+        v.push_back({e.name(), e.name_string(), e.value()});
+    auto reason = h.reason();
+    if(reason == obsolete_reason(
+        static_cast<status>(h.result_int())))
+        reason = {};
+    build(h.version(), h.result_int(), reason, v, slots);
+}
+
+} // http
+} // beast
+} // boost
+
+#endif
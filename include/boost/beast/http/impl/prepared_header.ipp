@@ -0,0 +1,505 @@
+//
+// Copyright (c) 2016-2019 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/beast
+//
+
+#ifndef BOOST_BEAST_HTTP_IMPL_PREPARED_HEADER_IPP
+#define BOOST_BEAST_HTTP_IMPL_PREPARED_HEADER_IPP
+
+#include <boost/beast/http/prepared_header.hpp>
+#include <boost/beast/core/static_string.hpp>
+#include <boost/beast/core/detail/temporary_buffer.hpp>
+#include <boost/beast/http/fields.hpp>
+#include <boost/beast/http/rfc7230.hpp>
+#include <boost/beast/http/status.hpp>
+#include <boost/beast/http/detail/status_line.hpp>
+#include <boost/throw_exception.hpp>
+#include <algorithm>
+#include <stdexcept>
+
+namespace boost {
+namespace beast {
+namespace http {
+
+/*  Each field is rendered as "<name>: <value>\r\n", with the
+    value padded by trailing spaces to the width of the entry.
+    The offsets refer to the rendered bytes, which are the same
+    in every copy of the header.
+*/
+struct prepared_header::impl
+{
+    struct entry
+    {
+        field f;
+        std::size_t pos;    // offset of the line
+        std::size_t nlen;   // size of the name
+        std::size_t width;  // characters reserved for the value
+        bool slot;
+
+        std::size_t
+        size() const
+        {
+            return nlen + width + 4;
+        }
+    };
+
+    std::vector<entry> list;
+    std::string s;
+    std::string reason;
+    std::size_t start;      // size of the status line
+    unsigned version;
+    unsigned code;
+};
+
+namespace detail {
+
+inline
+void
+append_status_line(
+    std::string& s,
+    unsigned version,
+    unsigned code,
+    string_view reason)
+{
+    if(reason.empty())
+    {
+        auto const line = status_line(version, code);
+        if(! line.empty())
+        {
+            s.append(line.data(), line.size());
+            return;
+        }
+        reason = obsolete_reason(static_cast<status>(code));
+    }
+    char buf[13];
+    buf[0] = 'H';
+    buf[1] = 'T';
+    buf[2] = 'T';
+    buf[3] = 'P';
+    buf[4] = '/';
+    buf[5] = '0' + static_cast<char>(version / 10);
+    buf[6] = '.';
+    buf[7] = '0' + static_cast<char>(version % 10);
+    buf[8] = ' ';
+    buf[9] = '0' + static_cast<char>(code / 100);
+    buf[10]= '0' + static_cast<char>((code / 10) % 10);
+    buf[11]= '0' + static_cast<char>(code % 10);
+    buf[12]= ' ';
+    s.append(buf, sizeof(buf));
+    s.append(reason.data(), reason.size());
+    s.append("\r\n", 2);
+}
+
+} // detail
+
+prepared_header::writer::
+writer(prepared_header const& f,
+    unsigned version, unsigned code)
+{
+    if(! f.impl_)
+    {
+        detail::append_status_line(buf_, version, code, {});
+        buf_.append("\r\n", 2);
+        cb_ = {buf_.data(), buf_.size()};
+        return;
+    }
+    auto const& m = *f.impl_;
+    auto fast =
+        version == m.version &&
+        code == m.code;
+    for(std::size_t i = 0; fast && i < m.list.size(); ++i)
+        if(m.list[i].slot && f.value(i).empty())
+            fast = false;
+    if(fast)
+    {
+        cb_ = {f.s_.data(), f.s_.size()};
+        return;
+    }
+
+    // Render a new status line and leave out
+    // the lines of slots which have no value.
+    buf_.reserve(f.s_.size());
+    detail::append_status_line(buf_, version, code, m.reason);
+    auto pos = m.start;
+    for(std::size_t i = 0; i < m.list.size(); ++i)
+    {
+        auto const& e = m.list[i];
+        if(! e.slot || ! f.value(i).empty())
+            continue;
+        buf_.append(f.s_.data() + pos, e.pos - pos);
+        pos = e.pos + e.size();
+    }
+    buf_.append(f.s_.data() + pos, f.s_.size() - pos);
+    cb_ = {buf_.data(), buf_.size()};
+}
+
+//------------------------------------------------------------------------------
+
+string_view
+prepared_header::
+operator[](field name) const
+{
+    auto const i = find(name, to_string(name));
+    if(i == std::size_t(-1))
+        return {};
+    return value(i);
+}
+
+string_view
+prepared_header::
+operator[](string_view name) const
+{
+    auto const i = find(string_to_field(name), name);
+    if(i == std::size_t(-1))
+        return {};
+    return value(i);
+}
+
+bool
+prepared_header::
+contains(field name) const
+{
+    auto const i = find(name, to_string(name));
+    return i != std::size_t(-1) && (
+        ! impl_->list[i].slot || ! value(i).empty());
+}
+
+bool
+prepared_header::
+contains(string_view name) const
+{
+    auto const i = find(string_to_field(name), name);
+    return i != std::size_t(-1) && (
+        ! impl_->list[i].slot || ! value(i).empty());
+}
+
+bool
+prepared_header::
+is_slot(field name) const
+{
+    auto const i = find(name, to_string(name));
+    return i != std::size_t(-1) && impl_->list[i].slot;
+}
+
+bool
+prepared_header::
+is_slot(string_view name) const
+{
+    auto const i = find(string_to_field(name), name);
+    return i != std::size_t(-1) && impl_->list[i].slot;
+}
+
+void
+prepared_header::
+set(field name, string_view value)
+{
+    auto const i = find(name, to_string(name));
+    if(i == std::size_t(-1) || ! impl_->list[i].slot)
+        BOOST_THROW_EXCEPTION(std::out_of_range{
+            "field is not a slot"});
+    assign(i, value);
+}
+
+void
+prepared_header::
+set(string_view name, string_view value)
+{
+    auto const i = find(string_to_field(name), name);
+    if(i == std::size_t(-1) || ! impl_->list[i].slot)
+        BOOST_THROW_EXCEPTION(std::out_of_range{
+            "field is not a slot"});
+    assign(i, value);
+}
+
+//------------------------------------------------------------------------------
+
+string_view
+prepared_header::
+get_method_impl() const
+{
+    return {};
+}
+
+string_view
+prepared_header::
+get_target_impl() const
+{
+    return {};
+}
+
+string_view
+prepared_header::
+get_reason_impl() const
+{
+    if(! impl_)
+        return {};
+    return impl_->reason;
+}
+
+bool
+prepared_header::
+get_chunked_impl() const
+{
+    auto const te = token_list{
+        (*this)[field::transfer_encoding]};
+    for(auto it = te.begin(); it != te.end();)
+    {
+        auto const next = std::next(it);
+        if(next == te.end())
+            return beast::iequals(*it, "chunked");
+        it = next;
+    }
+    return false;
+}
+
+bool
+prepared_header::
+get_keep_alive_impl(unsigned version) const
+{
+    if(version < 11)
+    {
+        if(! contains(field::connection))
+            return false;
+        return token_list{
+            (*this)[field::connection]}.exists("keep-alive");
+    }
+    if(! contains(field::connection))
+        return true;
+    return ! token_list{
+        (*this)[field::connection]}.exists("close");
+}
+
+bool
+prepared_header::
+has_content_length_impl() const
+{
+    return contains(field::content_length);
+}
+
+void
+prepared_header::
+set_method_impl(string_view s)
+{
+    if(! s.empty())
+        BOOST_THROW_EXCEPTION(std::invalid_argument{
+            "prepared_header is not a request"});
+}
+
+void
+prepared_header::
+set_target_impl(string_view s)
+{
+    if(! s.empty())
+        BOOST_THROW_EXCEPTION(std::invalid_argument{
+            "prepared_header is not a request"});
+}
+
+void
+prepared_header::
+set_reason_impl(string_view s)
+{
+    if(s != get_reason_impl())
+        BOOST_THROW_EXCEPTION(std::invalid_argument{
+            "reason-phrase is prepared"});
+}
+
+void
+prepared_header::
+set_chunked_impl(bool value)
+{
+    if(value == get_chunked_impl())
+        return;
+    auto const te = (*this)[field::transfer_encoding];
+    beast::detail::temporary_buffer buf;
+    if(! value)
+        detail::filter_token_list_last(buf, te, {"chunked", {}});
+    else if(te.empty())
+        buf.append("chunked");
+    else
+        buf.append(te, ", chunked");
+    update(field::transfer_encoding, buf.view());
+}
+
+void
+prepared_header::
+set_content_length_impl(
+    boost::optional<std::uint64_t> const& value)
+{
+    if(! value)
+        return update(field::content_length, {});
+    auto const s = to_static_string(*value);
+    update(field::content_length,
+        string_view(s.data(), s.size()));
+}
+
+void
+prepared_header::
+set_keep_alive_impl(
+    unsigned version, bool keep_alive)
+{
+    beast::detail::temporary_buffer buf;
+    detail::keep_alive_impl(buf,
+        (*this)[field::connection], version, keep_alive);
+    update(field::connection, buf.view());
+}
+
+//------------------------------------------------------------------------------
+
+void
+prepared_header::
+build(
+    unsigned version,
+    unsigned code,
+    string_view reason,
+    std::vector<part> const& fields,
+    std::initializer_list<slot> slots)
+{
+    auto sp = std::make_shared<impl>();
+    auto& m = *sp;
+    m.version = version;
+    m.code = code;
+    m.reason.assign(reason.data(), reason.size());
+    detail::append_status_line(m.s, version, code, reason);
+    m.start = m.s.size();
+
+    auto const width = [](slot const& sl, string_view v)
+    {
+        auto n = sl.width_;
+        if(n == 0)
+        {
+            if(sl.name_ == field::content_length)
+                n = 20; // digits in the largest std::uint64_t
+            else if(sl.name_ == field::date)
+                n = 29; // "Sun, 06 Nov 1994 08:49:37 GMT"
+            else if(sl.name_ == field::connection)
+                n = 10; // "keep-alive"
+        }
+        return (std::max)(n, v.size());
+    };
+
+    auto const add = [&m](
+        field f, string_view name, string_view value,
+        std::size_t width, bool is_slot)
+    {
+        m.list.push_back({f, m.s.size(), name.size(), width, is_slot});
+        m.s.append(name.data(), name.size());
+        m.s.append(": ", 2);
+        m.s.append(value.data(), value.size());
+        m.s.append(width - value.size(), ' ');
+        m.s.append("\r\n", 2);
+    };
+
+    std::vector<bool> used(slots.size());
+    for(auto const& p : fields)
+    {
+        std::size_t k = 0;
+        for(auto const& sl : slots)
+        {
+            if(! used[k] && (sl.name_ != field::unknown ?
+                sl.name_ == p.name : (p.name == field::unknown &&
+                    beast::iequals(sl.name_string_, p.name_string))))
+                break;
+            ++k;
+        }
+        if(k < slots.size())
+        {
+            used[k] = true;
+            add(p.name, p.name_string, p.value,
+                width(slots.begin()[k], p.value), true);
+        }
+        else
+        {
+            add(p.name, p.name_string, p.value,
+                p.value.size(), false);
+        }
+    }
+    std::size_t k = 0;
+    for(auto const& sl : slots)
+        if(! used[k++])
+            add(sl.name_, sl.name_string_, {},
+                width(sl, {}), true);
+    m.s.append("\r\n", 2);
+
+    s_ = m.s;
+    impl_ = std::move(sp);
+}
+
+std::size_t
+prepared_header::
+find(field name, string_view sname) const
+{
+    if(! impl_)
+        return std::size_t(-1);
+    auto const& list = impl_->list;
+    for(std::size_t i = 0; i < list.size(); ++i)
+    {
+        auto const& e = list[i];
+        if(name != field::unknown)
+        {
+            if(e.f == name)
+                return i;
+        }
+        else if(
+            e.f == field::unknown &&
+            e.nlen == sname.size() &&
+            beast::iequals(sname,
+                string_view(s_.data() + e.pos, e.nlen)))
+        {
+            return i;
+        }
+    }
+    return std::size_t(-1);
+}
+
+string_view
+prepared_header::
+value(std::size_t i) const
+{
+    auto const& e = impl_->list[i];
+    auto const p = s_.data() + e.pos + e.nlen + 2;
+    auto n = e.width;
+    if(e.slot)
+        while(n > 0 && p[n - 1] == ' ')
+            --n;
+    return {p, n};
+}
+
+void
+prepared_header::
+assign(std::size_t i, string_view value)
+{
+    auto const& e = impl_->list[i];
+    if(value.size() > e.width)
+        BOOST_THROW_EXCEPTION(std::length_error{
+            "value is wider than the slot"});
+    auto const p = &s_[e.pos + e.nlen + 2];
+    std::copy(value.begin(), value.end(), p);
+    std::fill(p + value.size(), p + e.width, ' ');
+}
+
+// Set the value of a field through the Fields interface,
+// which is only possible for a slot, or when the value
+// does not change.
+void
+prepared_header::
+update(field name, string_view value)
+{
+    auto const i = find(name, to_string(name));
+    if(i != std::size_t(-1) && impl_->list[i].slot)
+        return assign(i, value);
+    auto const current = i == std::size_t(-1) ?
+        string_view() : this->value(i);
+    if(current != value)
+        BOOST_THROW_EXCEPTION(std::invalid_argument{
+            "field is not a slot"});
+}
+
+} // http
+} // beast
+} // boost
+
+#endif
@@ -164,6 +164,7 @@ class read_some_op : asio::coroutine
     AsyncReadStream& s_;
     DynamicBuffer& b_;
     basic_parser<isRequest>& p_;
+    net::mutable_buffer body_;
     std::size_t bytes_transferred_;
     bool cont_;
 
@@ -202,9 +203,25 @@ public:
                     break;
 
             do_read:
+                if(b_.size() == 0 && p_.is_header_done())
+                {
+                    // receive the body in place if the parser can
+                    body_ = p_.prepare_body(65536, ec);
+                    if(ec)
+                        goto upcall;
+                }
                 BOOST_ASIO_CORO_YIELD
                 {
                     cont_ = true;
+                    if(body_.size() > 0)
+                    {
+                        BOOST_ASIO_HANDLER_LOCATION((
+                            __FILE__, __LINE__,
+                            "http::async_read_some"));
+
+                        s_.async_read_some(body_, std::move(self));
+                        return;
+                    }
                     // VFALCO This was read_size_or_throw
                     auto const size = read_size(b_, 65536);
                     if(size == 0)
@@ -224,7 +241,26 @@ public:
 
                     s_.async_read_some(*mb, std::move(self));
                 }
-                b_.commit(bytes_transferred);
+                if(body_.size() > 0)
+                {
+                    body_ = {};
+                    {
+                        // always commit, so the body
+                        // can give back unused storage
+                        error_code ec2;
+                        p_.commit_body(bytes_transferred, ec2);
+                        bytes_transferred_ += bytes_transferred;
+                        if(! ec)
+                        {
+                            ec = ec2;
+                            goto upcall;
+                        }
+                    }
+                }
+                else
+                {
+                    b_.commit(bytes_transferred);
+                }
                 if(ec == net::error::eof)
                 {
                     BOOST_ASSERT(bytes_transferred == 0);
@@ -351,6 +387,38 @@ read_some(SyncReadStream& s, DynamicBuffer& b, basic_parser<isRequest>& p, error
             break;
 
     do_read:
+        if(b.size() == 0 && p.is_header_done())
+        {
+            // receive the body in place if the parser can
+            auto const mb = p.prepare_body(65536, ec);
+            if(ec)
+                return total;
+            if(mb.size() > 0)
+            {
+                auto const bytes_transferred =
+                    s.read_some(mb, ec);
+                {
+                    // always commit, so the body
+                    // can give back unused storage
+                    error_code ec2;
+                    p.commit_body(bytes_transferred, ec2);
+                    total += bytes_transferred;
+                    if(! ec)
+                    {
+                        ec = ec2;
+                        return total;
+                    }
+                }
+                if(ec == net::error::eof)
+                {
+                    BOOST_ASSERT(bytes_transferred == 0);
+                    // the body is incomplete
+                    ec.assign(0, ec.category());
+                    p.put_eof(ec);
+                }
+                return total;
+            }
+        }
         // VFALCO This was read_size_or_throw
         auto const size = read_size(b, 65536);
         if(size == 0)
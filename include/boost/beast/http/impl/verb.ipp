@@ -11,7 +11,12 @@
 #define BOOST_BEAST_HTTP_IMPL_VERB_IPP
 
 #include <boost/beast/http/verb.hpp>
+#include <boost/assert.hpp>
+#include <boost/endian/conversion.hpp>
 #include <boost/throw_exception.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
 #include <stdexcept>
 
 namespace boost {
@@ -71,227 +76,156 @@ to_string(verb v)
     BOOST_THROW_EXCEPTION(std::invalid_argument{"unknown verb"});
 }
 
+namespace detail {
+
+// Packs up to eight characters into an integer, the
+// first character in the least significant byte.
+inline
+constexpr
+std::uint64_t
+verb_key(char const* s, std::size_t n)
+{
+    return n == 0 ? 0 : (verb_key(s + 1, n - 1) << 8) |
+        static_cast<unsigned char>(s[0]);
+}
+
+template<std::size_t N>
+constexpr
+std::uint64_t
+verb_key(char const(&s)[N])
+{
+    static_assert(N <= 9, "verb key too long");
+    return verb_key(s, N - 1);
+}
+
+// The run-time equivalent of verb_key for n <= 8
+inline
+std::uint64_t
+load_verb_key(char const* p, std::size_t n) noexcept
+{
+    BOOST_ASSERT(n <= 8);
+    std::uint64_t v = 0;
+    std::memcpy(&v, p, n);
+    return endian::little_to_native(v);
+}
+
+} // detail
+
 verb
 string_to_verb(string_view v)
 {
 /*
-    ACL
-    BIND
-    CHECKOUT
-    CONNECT
-    COPY
-    DELETE
-    GET
-    HEAD
-    LINK
-    LOCK
-    M-SEARCH
-    MERGE
+    Each method is recognized by comparing the length and
+    then at most two integers, whose values for the known
+    methods are computed at compile time. The methods which
+    are longer than eight characters are:
+
     MKACTIVITY
     MKCALENDAR
-    MKCOL
-    MOVE
-    NOTIFY
-    OPTIONS
-    PATCH
-    POST
-    PROPFIND
     PROPPATCH
-    PURGE
-    PUT
-    REBIND
-    REPORT
-    SEARCH
     SUBSCRIBE
-    TRACE
-    UNBIND
-    UNLINK
-    UNLOCK
     UNSUBSCRIBE
 */
-    using namespace beast::detail::string_literals;
-    if(v.size() < 3)
+    using detail::verb_key;
+    auto const n = v.size();
+    if(n < 3 || n > 11)
         return verb::unknown;
-    auto c = v[0];
-    v.remove_prefix(1);
-    switch(c)
+    auto const k = detail::load_verb_key(
+        v.data(), (std::min)(n, std::size_t{8}));
+    switch(n)
     {
-    case 'A':
-        if(v == "CL"_sv)
-            return verb::acl;
-        break;
-
-    case 'B':
-        if(v == "IND"_sv)
-            return verb::bind;
-        break;
-
-    case 'C':
-        c = v[0];
-        v.remove_prefix(1);
-        switch(c)
+    case 3:
+        switch(k)
         {
-        case 'H':
-            if(v == "ECKOUT"_sv)
-                return verb::checkout;
-            break;
-
-        case 'O':
-            if(v == "NNECT"_sv)
-                return verb::connect;
-            if(v == "PY"_sv)
-                return verb::copy;
-            BOOST_FALLTHROUGH;
-
-        default:
-            break;
+        case verb_key("ACL"):       return verb::acl;
+        case verb_key("GET"):       return verb::get;
+        case verb_key("PUT"):       return verb::put;
         }
         break;
 
-    case 'D':
-        if(v == "ELETE"_sv)
-            return verb::delete_;
-        break;
-
-    case 'G':
-        if(v == "ET"_sv)
-            return verb::get;
-        break;
-
-    case 'H':
-        if(v == "EAD"_sv)
-            return verb::head;
+    case 4:
+        switch(k)
+        {
+        case verb_key("BIND"):      return verb::bind;
+        case verb_key("COPY"):      return verb::copy;
+        case verb_key("HEAD"):      return verb::head;
+        case verb_key("LINK"):      return verb::link;
+        case verb_key("LOCK"):      return verb::lock;
+        case verb_key("MOVE"):      return verb::move;
+        case verb_key("POST"):      return verb::post;
+        }
         break;
 
-    case 'L':
-        if(v == "INK"_sv)
-            return verb::link;
-        if(v == "OCK"_sv)
-            return verb::lock;
+    case 5:
+        switch(k)
+        {
+        case verb_key("MERGE"):     return verb::merge;
+        case verb_key("MKCOL"):     return verb::mkcol;
+        case verb_key("PATCH"):     return verb::patch;
+        case verb_key("PURGE"):     return verb::purge;
+        case verb_key("TRACE"):     return verb::trace;
+        }
         break;
 
-    case 'M':
-        c = v[0];
-        v.remove_prefix(1);
-        switch(c)
+    case 6:
+        switch(k)
         {
-        case '-':
-            if(v == "SEARCH"_sv)
-                return verb::msearch;
-            break;
-
-        case 'E':
-            if(v == "RGE"_sv)
-                return verb::merge;
-            break;
-
-        case 'K':
-            if(v == "ACTIVITY"_sv)
-                return verb::mkactivity;
-            if(v[0] == 'C')
-            {
-                v.remove_prefix(1);
-                if(v == "ALENDAR"_sv)
-                    return verb::mkcalendar;
-                if(v == "OL"_sv)
-                    return verb::mkcol;
-                break;
-            }
-            break;
-
-        case 'O':
-            if(v == "VE"_sv)
-                return verb::move;
-            BOOST_FALLTHROUGH;
-
-        default:
-            break;
+        case verb_key("DELETE"):    return verb::delete_;
+        case verb_key("NOTIFY"):    return verb::notify;
+        case verb_key("REBIND"):    return verb::rebind;
+        case verb_key("REPORT"):    return verb::report;
+        case verb_key("SEARCH"):    return verb::search;
+        case verb_key("UNBIND"):    return verb::unbind;
+        case verb_key("UNLINK"):    return verb::unlink;
+        case verb_key("UNLOCK"):    return verb::unlock;
         }
         break;
 
-    case 'N':
-        if(v == "OTIFY"_sv)
-            return verb::notify;
+    case 7:
+        switch(k)
+        {
+        case verb_key("CONNECT"):   return verb::connect;
+        case verb_key("OPTIONS"):   return verb::options;
+        }
         break;
 
-    case 'O':
-        if(v == "PTIONS"_sv)
-            return verb::options;
+    case 8:
+        switch(k)
+        {
+        case verb_key("CHECKOUT"):  return verb::checkout;
+        case verb_key("M-SEARCH"):  return verb::msearch;
+        case verb_key("PROPFIND"):  return verb::propfind;
+        }
         break;
 
-    case 'P':
-        c = v[0];
-        v.remove_prefix(1);
-        switch(c)
+    default:
+    {
+        auto const t = detail::load_verb_key(
+            v.data() + 8, n - 8);
+        switch(n)
         {
-        case 'A':
-            if(v == "TCH"_sv)
-                return verb::patch;
-            break;
-
-        case 'O':
-            if(v == "ST"_sv)
-                return verb::post;
-            break;
-
-        case 'R':
-            if(v == "OPFIND"_sv)
-                return verb::propfind;
-            if(v == "OPPATCH"_sv)
+        case 9:
+            if(k == verb_key("PROPPATC") && t == verb_key("H"))
                 return verb::proppatch;
+            if(k == verb_key("SUBSCRIB") && t == verb_key("E"))
+                return verb::subscribe;
             break;
 
-        case 'U':
-            if(v == "RGE"_sv)
-                return verb::purge;
-            if(v == "T"_sv)
-                return verb::put;
-            BOOST_FALLTHROUGH;
-
-        default:
-            break;
-        }
-        break;
-
-    case 'R':
-        if(v[0] != 'E')
+        case 10:
+            if(k == verb_key("MKACTIVI") && t == verb_key("TY"))
+                return verb::mkactivity;
+            if(k == verb_key("MKCALEND") && t == verb_key("AR"))
+                return verb::mkcalendar;
             break;
-        v.remove_prefix(1);
-        if(v == "BIND"_sv)
-            return verb::rebind;
-        if(v == "PORT"_sv)
-            return verb::report;
-        break;
-
-    case 'S':
-        if(v == "EARCH"_sv)
-            return verb::search;
-        if(v == "UBSCRIBE"_sv)
-            return verb::subscribe;
-        break;
-
-    case 'T':
-        if(v == "RACE"_sv)
-            return verb::trace;
-        break;
 
-    case 'U':
-        if(v[0] != 'N')
+        case 11:
+            if(k == verb_key("UNSUBSCR") && t == verb_key("IBE"))
+                return verb::unsubscribe;
             break;
-        v.remove_prefix(1);
-        if(v == "BIND"_sv)
-            return verb::unbind;
-        if(v == "LINK"_sv)
-            return verb::unlink;
-        if(v == "LOCK"_sv)
-            return verb::unlock;
-        if(v == "SUBSCRIBE"_sv)
-            return verb::unsubscribe;
-        break;
-
-    default:
+        }
         break;
     }
+    }
 
     return verb::unknown;
 }
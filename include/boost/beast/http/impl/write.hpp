@@ -232,7 +232,9 @@ public:
                         __FILE__, __LINE__,
                         "http::async_write"));
 
-                    beast::http::async_write_some(
+                    // Unqualified, so that overloads for particular
+                    // streams and bodies declared later are found
+                    async_write_some(
                         s_, sr_, std::move(*this));
                 }
                 bytes_transferred_ += bytes_transferred;
@@ -0,0 +1,359 @@
+//
+// Copyright (c) 2016-2019 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/beast
+//
+
+#ifndef BOOST_BEAST_HTTP_MAPPED_FILE_BODY_HPP
+#define BOOST_BEAST_HTTP_MAPPED_FILE_BODY_HPP
+
+#include <boost/beast/http/mapped_file_body_fwd.hpp>
+
+#include <boost/beast/core/detail/config.hpp>
+#include <boost/beast/core/error.hpp>
+#include <boost/beast/core/string.hpp>
+#include <boost/beast/http/message.hpp>
+#include <boost/asio/buffer.hpp>
+#include <boost/container_hash/hash.hpp>
+#include <boost/optional.hpp>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace boost {
+namespace beast {
+namespace http {
+
+/** A message body represented by a file mapped into memory.
+
+    Messages with this type have bodies represented by a file,
+    or a range of bytes in a file, which is mapped into the
+    address space of the process. When serializing, the mapped
+    pages are presented directly as the body content in a single
+    buffer, without copying them through an intermediate buffer
+    as @ref basic_file_body does. This is suited to serving
+    files which do not change while they are mapped.
+
+    The body may only be serialized. Copies of the body share
+    the mapping, which is released when the last copy is
+    destroyed. Mappings of frequently served files may be shared
+    between messages using a @ref mapped_file_cache.
+
+    On platforms without a memory mapping facility, the file
+    is read into memory instead.
+
+    @par Example
+    @code
+    response<mapped_file_body> res{status::ok, 11};
+    error_code ec;
+    res.body().open("index.html", ec);
+    if(! ec)
+        res.body().advise(mapped_file_body::advice::sequential, ec);
+    res.prepare_payload();
+    @endcode
+
+    @note The behavior is undefined if a mapped file is
+    truncated while it is mapped.
+*/
+struct mapped_file_body
+{
+#ifndef BOOST_BEAST_DOXYGEN
+    struct mapping;
+#endif
+
+    /// Hints describing how the mapped bytes will be accessed.
+    enum class advice
+    {
+        /// No particular access pattern.
+        normal,
+
+        /// The bytes will be accessed in order, from the first.
+        sequential,
+
+        /// The bytes will be accessed soon, and may be read ahead.
+        willneed
+    };
+
+    /** The type of the @ref message::body member.
+
+        The body refers to a contiguous range of bytes in a
+        mapping, which may be empty.
+    */
+    class value_type
+    {
+        std::shared_ptr<mapping const> m_;
+        char const* data_ = nullptr;
+        std::size_t size_ = 0;
+
+    public:
+        /// Constructor
+        value_type() = default;
+
+        /// Constructor
+        value_type(value_type const&) = default;
+
+        /// Constructor
+        value_type(value_type&&) = default;
+
+        /// Assignment
+        value_type& operator=(value_type const&) = default;
+
+        /// Assignment
+        value_type& operator=(value_type&&) = default;
+
+        /// Returns `true` if a file is mapped
+        bool
+        is_open() const noexcept
+        {
+            return m_ != nullptr;
+        }
+
+        /// Returns a pointer to the first byte of the body
+        char const*
+        data() const noexcept
+        {
+            return data_;
+        }
+
+        /// Returns the size of the body
+        std::size_t
+        size() const noexcept
+        {
+            return size_;
+        }
+
+        /** Release the mapping.
+
+            The mapping is unmapped when no other body
+            refers to it.
+        */
+        void
+        close() noexcept
+        {
+            m_.reset();
+            data_ = nullptr;
+            size_ = 0;
+        }
+
+        /** Map a file.
+
+            The body refers to the entire file.
+
+            @param path The utf-8 encoded path to the file
+
+            @param ec Set to the error, if any occurred
+        */
+        BOOST_BEAST_DECL
+        void
+        open(char const* path, error_code& ec);
+
+        /** Map a range of bytes in a file.
+
+            The body refers to `length` bytes of the file,
+            starting at `offset`. Only the pages holding
+            the range are mapped.
+
+            @param path The utf-8 encoded path to the file
+
+            @param offset The offset of the first byte
+
+            @param length The number of bytes. This is reduced
+            to the number of bytes which follow `offset`.
+
+            @param ec Set to the error, if any occurred. If
+            `offset` is past the end of the file, the error is
+            `errc::invalid_argument`.
+        */
+        BOOST_BEAST_DECL
+        void
+        open(
+            char const* path,
+            std::uint64_t offset,
+            std::uint64_t length,
+            error_code& ec);
+
+        /** Advise the system how the body will be accessed.
+
+            This function applies the hint to the pages holding
+            the body. It has no effect on platforms which do not
+            support the hint, or when the file was read into
+            memory.
+
+            @param hint The expected access pattern
+
+            @param ec Set to the error, if any occurred
+        */
+        BOOST_BEAST_DECL
+        void
+        advise(advice hint, error_code& ec);
+
+    private:
+        friend class mapped_file_cache;
+
+        BOOST_BEAST_DECL
+        void
+        assign(std::shared_ptr<mapping const> m) noexcept;
+    };
+
+    /** Returns the payload size of the body
+
+        When this body is used with @ref message::prepare_payload,
+        the Content-Length will be set to the payload size, and
+        any chunked Transfer-Encoding will be removed.
+    */
+    static
+    std::uint64_t
+    size(value_type const& body) noexcept
+    {
+        return body.size();
+    }
+
+    /** The algorithm for serializing the body
+
+        Meets the requirements of <em>BodyWriter</em>.
+    */
+#if BOOST_BEAST_DOXYGEN
+    using writer = __implementation_defined__;
+#else
+    class writer
+    {
+        value_type const& body_;
+
+    public:
+        using const_buffers_type =
+            net::const_buffer;
+
+        template<bool isRequest, class Fields>
+        explicit
+        writer(header<isRequest, Fields> const&, value_type const& b)
+            : body_(b)
+        {
+        }
+
+        void
+        init(error_code& ec)
+        {
+            ec = {};
+        }
+
+        boost::optional<std::pair<const_buffers_type, bool>>
+        get(error_code& ec)
+        {
+            ec = {};
+            return {{
+                { body_.data(), body_.size() },
+                false}};
+        }
+    };
+#endif
+};
+
+/** A cache of memory mapped files.
+
+    This container holds the mappings of recently opened files,
+    so that a file which is served repeatedly is opened and
+    mapped only once. When the cache is full, the mapping used
+    least recently is removed. Bodies referring to a removed
+    mapping remain valid.
+
+    The cache does not detect changes to the files it holds.
+    Call @ref erase or @ref clear after a file is modified.
+
+    @par Thread Safety
+    @e Distinct @e objects: Safe.@n
+    @e Shared @e objects: Safe.
+*/
+class mapped_file_cache
+{
+    using list_type = std::list<std::pair<std::string,
+        std::shared_ptr<mapped_file_body::mapping const>>>;
+
+    struct hash
+    {
+        std::size_t
+        operator()(string_view s) const noexcept
+        {
+            return boost::hash_range(s.begin(), s.end());
+        }
+    };
+
+    std::mutex mutable m_;
+    list_type list_;   // most recently used first
+    std::unordered_map<string_view,
+        list_type::iterator, hash> map_;
+    std::size_t capacity_;
+    mapped_file_body::advice hint_;
+
+public:
+    /** Constructor
+
+        @param capacity The largest number of files held.
+
+        @param hint The hint applied to each file when
+        it is mapped.
+    */
+    explicit
+    mapped_file_cache(
+        std::size_t capacity = 1024,
+        mapped_file_body::advice hint =
+            mapped_file_body::advice::normal) noexcept
+        : capacity_(capacity)
+        , hint_(hint)
+    {
+    }
+
+    /// Constructor
+    mapped_file_cache(mapped_file_cache const&) = delete;
+
+    /// Assignment
+    mapped_file_cache& operator=(mapped_file_cache const&) = delete;
+
+    /** Return a body referring to an entire file.
+
+        If the file is not held in the cache, it is mapped
+        and added to the cache.
+
+        @param path The utf-8 encoded path to the file. It
+        is compared exactly to the paths of cached files.
+
+        @param ec Set to the error, if any occurred
+    */
+    BOOST_BEAST_DECL
+    mapped_file_body::value_type
+    open(string_view path, error_code& ec);
+
+    /** Remove a file from the cache.
+
+        @return `true` if the file was held in the cache
+    */
+    BOOST_BEAST_DECL
+    bool
+    erase(string_view path);
+
+    /// Remove all files from the cache.
+    BOOST_BEAST_DECL
+    void
+    clear();
+
+    /// Returns the number of files held in the cache.
+    BOOST_BEAST_DECL
+    std::size_t
+    size() const;
+};
+
+} // http
+} // beast
+} // boost
+
+#ifdef BOOST_BEAST_HEADER_ONLY
+#include <boost/beast/http/impl/mapped_file_body.ipp>
+#endif
+
+#endif
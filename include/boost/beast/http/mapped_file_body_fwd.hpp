@@ -0,0 +1,25 @@
+//
+// Copyright (c) 2016-2019 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/beast
+//
+
+#ifndef BOOST_BEAST_HTTP_MAPPED_FILE_BODY_FWD_HPP
+#define BOOST_BEAST_HTTP_MAPPED_FILE_BODY_FWD_HPP
+
+namespace boost {
+namespace beast {
+namespace http {
+
+struct mapped_file_body;
+
+class mapped_file_cache;
+
+} // http
+} // beast
+} // boost
+
+#endif
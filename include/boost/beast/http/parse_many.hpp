@@ -0,0 +1,124 @@
+//
+// Copyright (c) 2016-2019 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/beast
+//
+
+#ifndef BOOST_BEAST_HTTP_PARSE_MANY_HPP
+#define BOOST_BEAST_HTTP_PARSE_MANY_HPP
+
+#include <boost/beast/core/detail/config.hpp>
+#include <boost/beast/core/error.hpp>
+#include <boost/beast/http/parser.hpp>
+#include <cstddef>
+
+namespace boost {
+namespace beast {
+namespace http {
+
+/** Parse every complete message held in a buffer.
+
+    This function parses the messages already present in a dynamic
+    buffer, such as several pipelined requests delivered by a single
+    read, and hands each one to a handler as soon as it is complete.
+    The parser is reset after each message, so a single parser and
+    its allocations serve the whole batch. The bytes of every message
+    are removed from the buffer.
+
+    If the parser holds a complete message when this function is
+    called, typically because it was just used with @ref read or
+    @ref async_read, that message is delivered first.
+
+    The function returns when the buffer holds no more complete
+    messages. Any bytes of a partial message at the end of the buffer
+    are consumed into the parser, which may then be passed to
+    @ref read or @ref async_read to finish it. A message which ends
+    only at the end of the stream is never complete here.
+
+    @par Example
+    Parse a request with @ref async_read, then gather the requests
+    which arrived with it so that the responses may be written
+    together:
+    @code
+    http::async_read(stream, buffer, parser,
+        [&](error_code ec, std::size_t)
+        {
+            if(ec)
+                return fail(ec);
+            std::vector<http::request<http::string_body>> batch;
+            http::parse_many(buffer, parser,
+                [&](http::request<http::string_body>&& req)
+                {
+                    batch.push_back(std::move(req));
+                }, ec);
+            ...
+        });
+    @endcode
+
+    @param buffer A <em>DynamicBuffer</em> holding the input. The
+    parsed bytes are consumed from it.
+
+    @param parser The parser to use. The eager option is set.
+
+    @param handler The function to invoke with each message, which
+    must be invocable with this equivalent signature:
+    @code
+    void handler(
+        typename parser<isRequest, Body, Allocator>::value_type&& msg);
+    @endcode
+
+    @param ec Set to the error, if any occurred. When this happens
+    the parser is not reset, and may not be used further except by
+    calling @ref parser::reset.
+
+    @return The number of messages passed to the handler.
+*/
+template<
+    class DynamicBuffer,
+    bool isRequest, class Body, class Allocator,
+    class Handler>
+std::size_t
+parse_many(
+    DynamicBuffer& buffer,
+    parser<isRequest, Body, Allocator>& parser,
+    Handler&& handler,
+    error_code& ec);
+
+/** Parse every complete message held in a buffer.
+
+    This function parses the messages already present in a dynamic
+    buffer, and hands each one to a handler as soon as it is
+    complete. See the overload which takes an `error_code` for
+    details.
+
+    @param buffer A <em>DynamicBuffer</em> holding the input. The
+    parsed bytes are consumed from it.
+
+    @param parser The parser to use. The eager option is set.
+
+    @param handler The function to invoke with each message.
+
+    @return The number of messages passed to the handler.
+
+    @throws system_error Thrown on failure.
+*/
+template<
+    class DynamicBuffer,
+    bool isRequest, class Body, class Allocator,
+    class Handler>
+std::size_t
+parse_many(
+    DynamicBuffer& buffer,
+    parser<isRequest, Body, Allocator>& parser,
+    Handler&& handler);
+
+} // http
+} // beast
+} // boost
+
+#include <boost/beast/http/impl/parse_many.hpp>
+
+#endif
@@ -32,7 +32,8 @@ namespace http {
 
     This class uses the basic HTTP/1 wire format parser to convert
     a series of octets into a @ref message using the @ref basic_fields
-    container to represent the fields.
+    container, or another container meeting the requirements of
+    <em>Fields</em>, to represent the fields.
 
     @tparam isRequest Indicates whether a request or response
     will be parsed.
@@ -41,9 +42,13 @@ namespace http {
     meet the requirements of <em>Body</em>.
 
     @tparam Allocator The type of allocator used with the
-    @ref basic_fields container.
+    @ref basic_fields container. Alternatively this may be a
+    type meeting the requirements of <em>Fields</em> such as
+    @ref arena_fields, which is then used in place of
+    @ref basic_fields.
 
-    @note A new instance of the parser is required for each message.
+    @note To parse another message, call @ref reset
+    or construct a new instance of the parser.
 */
 #if BOOST_BEAST_DOXYGEN
 template<
@@ -68,8 +73,11 @@ class parser
     template<bool, class, class>
     friend class parser;
 
-    message<isRequest, Body, basic_fields<Allocator>> m_;
-    typename Body::reader rd_;
+    using fields_type = typename
+        detail::parser_fields<Allocator>::type;
+
+    message<isRequest, Body, fields_type> m_;
+    boost::optional<typename Body::reader> rd_;
     bool rd_inited_ = false;
     bool used_ = false;
     bool merge_all_trailers_ = false;
@@ -87,7 +95,7 @@ class parser
 public:
     /// The type of message returned by the parser
     using value_type =
-        message<isRequest, Body, basic_fields<Allocator>>;
+        message<isRequest, Body, fields_type>;
 
     /// Destructor
     ~parser() = default;
@@ -208,6 +216,33 @@ public:
         return std::move(m_);
     }
 
+    /** Prepare the parser for the next message.
+
+        This clears the parsed message and the state of the parser,
+        so that a single parser may be used for every message received
+        on a connection. Allocated storage is kept where possible: the
+        fields are cleared with `clear`, and the body is cleared with
+        `clear` when the body's `value_type` has one, or else assigned
+        a default-constructed value. Options set on the parser and
+        the callbacks set with @ref on_chunk_header and
+        @ref on_chunk_body are kept.
+
+        This function may also be called after @ref release.
+
+        @par Example
+        @code
+        request_parser<string_body> p;
+        for(;;)
+        {
+            read(stream, buffer, p);
+            handle_request(p.get());
+            p.reset();
+        }
+        @endcode
+    */
+    void
+    reset();
+
     /** Set a callback to be invoked on each chunk header.
 
         The callback will be invoked once for every chunk in the message
@@ -351,6 +386,18 @@ public:
     }
 
 private:
+    void
+    clear_body(std::true_type)
+    {
+        m_.body().clear();
+    }
+
+    void
+    clear_body(std::false_type)
+    {
+        m_.body() = typename Body::value_type{};
+    }
+
     parser(std::true_type);
     parser(std::false_type);
 
@@ -545,7 +592,7 @@ private:
         boost::optional<std::uint64_t> const& content_length,
         error_code& ec) override
     {
-        rd_.init(content_length, ec);
+        rd_->init(content_length, ec);
         rd_inited_ = true;
     }
 
@@ -554,10 +601,57 @@ private:
         string_view body,
         error_code& ec) override
     {
-        return rd_.put(net::buffer(
+        return rd_->put(net::buffer(
             body.data(), body.size()), ec);
     }
 
+    net::mutable_buffer
+    on_body_prepare_impl(
+        std::size_t, error_code&, std::false_type)
+    {
+        return {};
+    }
+
+    net::mutable_buffer
+    on_body_prepare_impl(
+        std::size_t size, error_code& ec, std::true_type)
+    {
+        return rd_->prepare(size, ec);
+    }
+
+    net::mutable_buffer
+    on_body_prepare_impl(
+        std::size_t size,
+        error_code& ec) override
+    {
+        return this->on_body_prepare_impl(size, ec,
+            detail::is_body_reader_preparable<
+                typename Body::reader>{});
+    }
+
+    void
+    on_body_commit_impl(
+        std::size_t, error_code&, std::false_type)
+    {
+    }
+
+    void
+    on_body_commit_impl(
+        std::size_t n, error_code& ec, std::true_type)
+    {
+        rd_->commit(n, ec);
+    }
+
+    void
+    on_body_commit_impl(
+        std::size_t n,
+        error_code& ec) override
+    {
+        this->on_body_commit_impl(n, ec,
+            detail::is_body_reader_preparable<
+                typename Body::reader>{});
+    }
+
     void
     on_chunk_header_impl(
         std::uint64_t size,
@@ -576,7 +670,7 @@ private:
     {
         if(cb_b_)
             return cb_b_(remain, body, ec);
-        return rd_.put(net::buffer(
+        return rd_->put(net::buffer(
             body.data(), body.size()), ec);
     }
 
@@ -584,7 +678,7 @@ private:
     on_finish_impl(
         error_code& ec) override
     {
-        rd_.finish(ec);
+        rd_->finish(ec);
     }
 };
 
@@ -0,0 +1,400 @@
+//
+// Copyright (c) 2016-2019 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/beast
+//
+
+#ifndef BOOST_BEAST_HTTP_PREPARED_HEADER_HPP
+#define BOOST_BEAST_HTTP_PREPARED_HEADER_HPP
+
+#include <boost/beast/http/prepared_header_fwd.hpp>
+
+#include <boost/beast/core/detail/config.hpp>
+#include <boost/beast/core/string.hpp>
+#include <boost/beast/http/field.hpp>
+#include <boost/beast/http/message_fwd.hpp>
+#include <boost/asio/buffer.hpp>
+#include <boost/optional.hpp>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace boost {
+namespace beast {
+namespace http {
+
+/** A response header rendered once, with fields which may be changed in place.
+
+    Responses produced by a server often share the same status and
+    fields, differing only in a few values such as Content-Length,
+    Date, or a request identifier. This container renders the status
+    line and fields of a response header into a single buffer when it
+    is constructed. The fields named as <em>slots</em> are given a
+    fixed width, and their values may later be replaced by writing
+    over the old value and padding it with trailing spaces, which the
+    recipient ignores as whitespace following the field value. No
+    other field may be changed.
+
+    Meets the requirements of <em>Fields</em>, and may be used as the
+    fields of a @ref response. The @ref serializer sends the rendered
+    bytes as the header, in one buffer when the version and status of
+    the message are those of the header it was prepared from and every
+    slot has a value. Otherwise the header is rendered again for each
+    message, leaving out the slots without a value.
+
+    Copies share the description of the fields, and each copy holds
+    its own rendered bytes, so a prepared header may be built once and
+    copied into every response.
+
+    @par Example
+    @code
+    response_header<> h;
+    h.version(11);
+    h.result(status::ok);
+    h.set(field::server, "example");
+    h.set(field::content_type, "application/json");
+    prepared_header const ph(h, {field::content_length, field::date});
+
+    response<string_body, prepared_header> res(status::ok, 11, body, ph);
+    res.set(field::date, date);
+    res.prepare_payload();
+    @endcode
+
+    @note The request-method, request-target, and reason-phrase may not
+    be changed, and this container may not be used with requests.
+*/
+class prepared_header
+{
+    struct impl;
+    struct part;
+
+public:
+    /** A field whose value may be changed after the header is prepared.
+
+        The width is the number of characters reserved for the value.
+        When it is zero, the width is that of the value in the header
+        the fields are prepared from, or the longest usual value for
+        Content-Length, Date, and Connection, whichever is greater.
+    */
+    class slot
+    {
+        friend class prepared_header;
+
+        field name_;
+        string_view name_string_;
+        std::size_t width_;
+
+    public:
+        /** Constructor.
+
+            @param name The field name.
+
+            @param width The number of characters reserved for the value.
+        */
+        slot(field name, std::size_t width = 0)
+            : name_(name)
+            , name_string_(to_string(name))
+            , width_(width)
+        {
+        }
+
+        /** Constructor.
+
+            @param name The field name. It is interpreted as a
+            case-insensitive string.
+
+            @param width The number of characters reserved for the value.
+        */
+        slot(string_view name, std::size_t width = 0)
+            : name_(string_to_field(name))
+            , name_string_(name)
+            , width_(width)
+        {
+        }
+    };
+
+    /// The algorithm used to serialize the header
+#if BOOST_BEAST_DOXYGEN
+    using writer = __implementation_defined__;
+#else
+    class writer;
+#endif
+
+    /** Constructor.
+
+        The default constructed header has no fields.
+    */
+    prepared_header() = default;
+
+    /// Copy constructor.
+    prepared_header(prepared_header const&) = default;
+
+    /// Move constructor.
+    prepared_header(prepared_header&&) = default;
+
+    /// Copy assignment.
+    prepared_header& operator=(prepared_header const&) = default;
+
+    /// Move assignment.
+    prepared_header& operator=(prepared_header&&) = default;
+
+    /** Constructor.
+
+        Renders the status line and fields of `h`. Slots which are not
+        present in `h` are added without a value, and are left out of
+        the serialized header until one is set.
+
+        @param h The response header to prepare.
+
+        @param slots The fields whose values may be changed.
+    */
+    template<class Fields>
+    explicit
+    prepared_header(
+        header<false, Fields> const& h,
+        std::initializer_list<slot> slots = {});
+
+    /** Returns the value for a field, or `""` if it does not exist.
+
+        If more than one field with the specified name exists, the
+        first field in serialization order is returned. The trailing
+        spaces used to pad the value of a slot are not included.
+
+        @param name The field name.
+    */
+    BOOST_BEAST_DECL
+    string_view
+    operator[](field name) const;
+
+    /** Returns the value for a field, or `""` if it does not exist.
+
+        If more than one field with the specified name exists, the
+        first field in serialization order is returned. The trailing
+        spaces used to pad the value of a slot are not included.
+
+        @param name The field name. It is interpreted as a
+        case-insensitive string.
+    */
+    BOOST_BEAST_DECL
+    string_view
+    operator[](string_view name) const;
+
+    /** Returns `true` if a field with the specified name has a value.
+
+        @param name The field name.
+    */
+    BOOST_BEAST_DECL
+    bool
+    contains(field name) const;
+
+    /** Returns `true` if a field with the specified name has a value.
+
+        @param name The field name. It is interpreted as a
+        case-insensitive string.
+    */
+    BOOST_BEAST_DECL
+    bool
+    contains(string_view name) const;
+
+    /** Returns `true` if the specified field is a slot.
+
+        @param name The field name.
+    */
+    BOOST_BEAST_DECL
+    bool
+    is_slot(field name) const;
+
+    /** Returns `true` if the specified field is a slot.
+
+        @param name The field name. It is interpreted as a
+        case-insensitive string.
+    */
+    BOOST_BEAST_DECL
+    bool
+    is_slot(string_view name) const;
+
+    /** Set the value of a slot.
+
+        The value is written over the previous value of the slot in the
+        rendered header. An empty value leaves the field out of the
+        serialized header.
+
+        @param name The field name.
+
+        @param value The field value.
+
+        @throws std::out_of_range if the field is not a slot.
+
+        @throws std::length_error if the value is wider than the slot.
+    */
+    BOOST_BEAST_DECL
+    void
+    set(field name, string_view value);
+
+    void
+    set(field, std::nullptr_t) = delete;
+
+    /** Set the value of a slot.
+
+        The value is written over the previous value of the slot in the
+        rendered header. An empty value leaves the field out of the
+        serialized header.
+
+        @param name The field name. It is interpreted as a
+        case-insensitive string.
+
+        @param value The field value.
+
+        @throws std::out_of_range if the field is not a slot.
+
+        @throws std::length_error if the value is wider than the slot.
+    */
+    BOOST_BEAST_DECL
+    void
+    set(string_view name, string_view value);
+
+    void
+    set(string_view, std::nullptr_t) = delete;
+
+protected:
+    /** Returns the request-method string.
+
+        @note Only called for requests.
+    */
+    BOOST_BEAST_DECL
+    string_view
+    get_method_impl() const;
+
+    /** Returns the request-target string.
+
+        @note Only called for requests.
+    */
+    BOOST_BEAST_DECL
+    string_view
+    get_target_impl() const;
+
+    /** Returns the response reason-phrase string.
+
+        @note Only called for responses.
+    */
+    BOOST_BEAST_DECL
+    string_view
+    get_reason_impl() const;
+
+    /** Returns the chunked Transfer-Encoding setting
+    */
+    BOOST_BEAST_DECL
+    bool
+    get_chunked_impl() const;
+
+    /** Returns the keep-alive setting
+    */
+    BOOST_BEAST_DECL
+    bool
+    get_keep_alive_impl(unsigned version) const;
+
+    /** Returns `true` if the Content-Length field is present.
+    */
+    BOOST_BEAST_DECL
+    bool
+    has_content_length_impl() const;
+
+    /** Set or clear the method string.
+
+        @throws std::invalid_argument if `s` is not empty.
+    */
+    BOOST_BEAST_DECL
+    void
+    set_method_impl(string_view s);
+
+    /** Set or clear the target string.
+
+        @throws std::invalid_argument if `s` is not empty.
+    */
+    BOOST_BEAST_DECL
+    void
+    set_target_impl(string_view s);
+
+    /** Set or clear the reason string.
+
+        @throws std::invalid_argument if `s` differs from
+        the prepared reason-phrase.
+    */
+    BOOST_BEAST_DECL
+    void
+    set_reason_impl(string_view s);
+
+    /** Adjusts the chunked Transfer-Encoding value
+
+        @throws std::invalid_argument if the value would
+        change and Transfer-Encoding is not a slot.
+    */
+    BOOST_BEAST_DECL
+    void
+    set_chunked_impl(bool value);
+
+    /** Sets or clears the Content-Length field
+
+        @throws std::invalid_argument if the value would
+        change and Content-Length is not a slot.
+    */
+    BOOST_BEAST_DECL
+    void
+    set_content_length_impl(
+        boost::optional<std::uint64_t> const& value);
+
+    /** Adjusts the Connection field
+
+        @throws std::invalid_argument if the value would
+        change and Connection is not a slot.
+    */
+    BOOST_BEAST_DECL
+    void
+    set_keep_alive_impl(
+        unsigned version, bool keep_alive);
+
+private:
+    BOOST_BEAST_DECL
+    void
+    build(
+        unsigned version,
+        unsigned code,
+        string_view reason,
+        std::vector<part> const& fields,
+        std::initializer_list<slot> slots);
+
+    BOOST_BEAST_DECL
+    std::size_t
+    find(field name, string_view sname) const;
+
+    BOOST_BEAST_DECL
+    string_view
+    value(std::size_t i) const;
+
+    BOOST_BEAST_DECL
+    void
+    assign(std::size_t i, string_view value);
+
+    BOOST_BEAST_DECL
+    void
+    update(field name, string_view value);
+
+    std::shared_ptr<impl const> impl_;
+    std::string s_;
+};
+
+} // http
+} // beast
+} // boost
+
+#include <boost/beast/http/impl/prepared_header.hpp>
+#ifdef BOOST_BEAST_HEADER_ONLY
+#include <boost/beast/http/impl/prepared_header.ipp>
+#endif
+
+#endif
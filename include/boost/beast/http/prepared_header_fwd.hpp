@@ -0,0 +1,23 @@
+//
+// Copyright (c) 2016-2019 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/beast
+//
+
+#ifndef BOOST_BEAST_HTTP_PREPARED_HEADER_FWD_HPP
+#define BOOST_BEAST_HTTP_PREPARED_HEADER_FWD_HPP
+
+namespace boost {
+namespace beast {
+namespace http {
+
+class prepared_header;
+
+} // http
+} // beast
+} // boost
+
+#endif
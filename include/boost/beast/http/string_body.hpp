@@ -85,6 +85,7 @@ public:
     class reader
     {
         value_type& body_;
+        std::size_t size_ = 0; // size before prepare
 
     public:
         template<bool isRequest, class Fields>
@@ -135,6 +136,29 @@ public:
             return extra;
         }
 
+        net::mutable_buffer
+        prepare(std::size_t n, error_code& ec)
+        {
+            auto const size = body_.size();
+            if(n > body_.max_size() - size)
+            {
+                BOOST_BEAST_ASSIGN_EC(ec, error::buffer_overflow);
+                return {};
+            }
+
+            body_.resize(size + n);
+            size_ = size;
+            ec = {};
+            return net::buffer(&body_[size], n);
+        }
+
+        void
+        commit(std::size_t n, error_code& ec)
+        {
+            body_.resize(size_ + n);
+            ec = {};
+        }
+
         void
         finish(error_code& ec)
         {
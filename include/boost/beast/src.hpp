@@ -31,6 +31,7 @@ the program, with the macro BOOST_BEAST_SEPARATE_COMPILATION defined.
 #include <boost/beast/_experimental/test/detail/stream_state.ipp>
 
 #include <boost/beast/core/detail/base64.ipp>
+#include <boost/beast/core/detail/char_scan.ipp>
 #include <boost/beast/core/detail/sha1.ipp>
 #include <boost/beast/core/detail/impl/temporary_buffer.ipp>
 #include <boost/beast/core/impl/error.ipp>
@@ -43,22 +44,31 @@ the program, with the macro BOOST_BEAST_SEPARATE_COMPILATION defined.
 #include <boost/beast/core/impl/string.ipp>
 
 #include <boost/beast/http/detail/basic_parser.ipp>
+#include <boost/beast/http/detail/date_service.ipp>
 #include <boost/beast/http/detail/rfc7230.ipp>
+#include <boost/beast/http/detail/status_line.ipp>
 #include <boost/beast/http/impl/basic_parser.ipp>
+#include <boost/beast/http/impl/date.ipp>
 #include <boost/beast/http/impl/error.ipp>
 #include <boost/beast/http/impl/field.ipp>
 #include <boost/beast/http/impl/fields.ipp>
+#include <boost/beast/http/impl/mapped_file_body.ipp>
+#include <boost/beast/http/impl/prepared_header.ipp>
 #include <boost/beast/http/impl/rfc7230.ipp>
 #include <boost/beast/http/impl/status.ipp>
 #include <boost/beast/http/impl/verb.ipp>
 
+#include <boost/beast/websocket/detail/buffer_pool.ipp>
+#include <boost/beast/websocket/detail/deflate_probe.ipp>
 #include <boost/beast/websocket/detail/hybi13.ipp>
 #include <boost/beast/websocket/detail/mask.ipp>
 #include <boost/beast/websocket/detail/pmd_extension.ipp>
+#include <boost/beast/websocket/detail/pmd_pool.ipp>
 #include <boost/beast/websocket/detail/prng.ipp>
 #include <boost/beast/websocket/detail/service.ipp>
 #include <boost/beast/websocket/detail/utf8_checker.ipp>
 #include <boost/beast/websocket/impl/error.ipp>
+#include <boost/beast/websocket/impl/prepared_message.ipp>
 
 #include <boost/beast/zlib/detail/deflate_stream.ipp>
 #include <boost/beast/zlib/detail/inflate_stream.ipp>
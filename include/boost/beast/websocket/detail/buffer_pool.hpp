@@ -0,0 +1,68 @@
+//
+// Copyright (c) 2016-2019 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/beast
+//
+
+#ifndef BOOST_BEAST_WEBSOCKET_DETAIL_BUFFER_POOL_HPP
+#define BOOST_BEAST_WEBSOCKET_DETAIL_BUFFER_POOL_HPP
+
+#include <boost/beast/core/detail/config.hpp>
+#include <cstddef>
+#include <mutex>
+
+namespace boost {
+namespace beast {
+namespace websocket {
+namespace detail {
+
+// A thread-safe cache of buffers shared by the
+// streams of one execution context. Idle buffers
+// are linked through their own storage.
+class buffer_pool
+{
+    struct node
+    {
+        node* next;
+        std::size_t size;
+    };
+
+    std::mutex m_;
+    node* head_ = nullptr;
+    std::size_t count_ = 0;
+
+public:
+    // Maximum number of idle buffers kept
+    static std::size_t constexpr max_idle = 64;
+
+    buffer_pool() = default;
+    buffer_pool(buffer_pool const&) = delete;
+    buffer_pool& operator=(buffer_pool const&) = delete;
+
+    BOOST_BEAST_DECL
+    ~buffer_pool();
+
+    // Returns a buffer of exactly `n` bytes
+    BOOST_BEAST_DECL
+    char*
+    borrow(std::size_t n);
+
+    // Returns a buffer obtained from `borrow`
+    BOOST_BEAST_DECL
+    void
+    give_back(char* p, std::size_t n) noexcept;
+};
+
+} // detail
+} // websocket
+} // beast
+} // boost
+
+#if BOOST_BEAST_HEADER_ONLY
+#include <boost/beast/websocket/detail/buffer_pool.ipp>
+#endif
+
+#endif
@@ -0,0 +1,77 @@
+//
+// Copyright (c) 2016-2019 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/beast
+//
+
+#ifndef BOOST_BEAST_WEBSOCKET_DETAIL_BUFFER_POOL_IPP
+#define BOOST_BEAST_WEBSOCKET_DETAIL_BUFFER_POOL_IPP
+
+#include <boost/beast/websocket/detail/buffer_pool.hpp>
+#include <boost/assert.hpp>
+#include <new>
+
+namespace boost {
+namespace beast {
+namespace websocket {
+namespace detail {
+
+buffer_pool::
+~buffer_pool()
+{
+    while(head_)
+    {
+        auto const p = head_;
+        head_ = p->next;
+        p->~node();
+        delete[] reinterpret_cast<char*>(p);
+    }
+}
+
+char*
+buffer_pool::
+borrow(std::size_t n)
+{
+    BOOST_ASSERT(n >= sizeof(node));
+    {
+        std::lock_guard<std::mutex> g(m_);
+        for(node** pp = &head_; *pp; pp = &(*pp)->next)
+        {
+            auto const p = *pp;
+            if(p->size != n)
+                continue;
+            *pp = p->next;
+            --count_;
+            p->~node();
+            return reinterpret_cast<char*>(p);
+        }
+    }
+    return new char[n];
+}
+
+void
+buffer_pool::
+give_back(char* p, std::size_t n) noexcept
+{
+    BOOST_ASSERT(n >= sizeof(node));
+    {
+        std::lock_guard<std::mutex> g(m_);
+        if(count_ < max_idle)
+        {
+            head_ = ::new(p) node{head_, n};
+            ++count_;
+            return;
+        }
+    }
+    delete[] p;
+}
+
+} // detail
+} // websocket
+} // beast
+} // boost
+
+#endif
@@ -0,0 +1,75 @@
+//
+// Copyright (c) 2016-2019 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/beast
+//
+
+#ifndef BOOST_BEAST_WEBSOCKET_DETAIL_DEFLATE_PROBE_HPP
+#define BOOST_BEAST_WEBSOCKET_DETAIL_DEFLATE_PROBE_HPP
+
+#include <boost/beast/core/buffers_suffix.hpp>
+#include <boost/beast/core/detail/config.hpp>
+#include <boost/asio/buffer.hpp>
+#include <cstddef>
+#include <cstdint>
+
+namespace boost {
+namespace beast {
+namespace websocket {
+namespace detail {
+
+// Bytes examined by the probe, and the
+// smallest sample which gives an answer
+std::size_t constexpr probe_size = 512;
+std::size_t constexpr probe_min = 256;
+
+// Returns `true` if the sample has nearly eight bits of
+// entropy per byte, as compressed or random data does
+BOOST_BEAST_DECL
+bool
+high_entropy(
+    std::uint8_t const* p, std::size_t n) noexcept;
+
+// Returns `true` if a message which begins with the `n`
+// bytes in `buffers` looks like it will not compress.
+// The sample is spread over the bytes so that a file
+// header does not hide the data which follows it.
+template<class ConstBufferSequence>
+bool
+is_incompressible(
+    ConstBufferSequence const& buffers, std::size_t n)
+{
+    if(n < probe_min)
+        return false;
+    std::uint8_t sample[probe_size];
+    if(n <= probe_size)
+        return high_entropy(sample, net::buffer_copy(
+            net::buffer(sample), buffers));
+    std::size_t constexpr chunks = 8;
+    std::size_t constexpr chunk = probe_size / chunks;
+    buffers_suffix<ConstBufferSequence> cb(buffers);
+    std::size_t pos = 0;
+    for(std::size_t i = 0; i < chunks; ++i)
+    {
+        auto const at = i * (n - chunk) / (chunks - 1);
+        cb.consume(at - pos);
+        pos = at + net::buffer_copy(
+            net::buffer(sample + i * chunk, chunk), cb);
+        cb.consume(pos - at);
+    }
+    return high_entropy(sample, probe_size);
+}
+
+} // detail
+} // websocket
+} // beast
+} // boost
+
+#if BOOST_BEAST_HEADER_ONLY
+#include <boost/beast/websocket/detail/deflate_probe.ipp>
+#endif
+
+#endif
@@ -0,0 +1,57 @@
+//
+// Copyright (c) 2016-2019 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/beast
+//
+
+#ifndef BOOST_BEAST_WEBSOCKET_DETAIL_DEFLATE_PROBE_IPP
+#define BOOST_BEAST_WEBSOCKET_DETAIL_DEFLATE_PROBE_IPP
+
+#include <boost/beast/websocket/detail/deflate_probe.hpp>
+#include <cmath>
+
+namespace boost {
+namespace beast {
+namespace websocket {
+namespace detail {
+
+bool
+high_entropy(
+    std::uint8_t const* p, std::size_t n) noexcept
+{
+    if(n < probe_min)
+        return false;
+    std::uint32_t count[256] = {};
+    for(std::size_t i = 0; i < n; ++i)
+        ++count[p[i]];
+
+    // Order-0 entropy in bits per byte, with the
+    // Miller-Madow correction for a small sample.
+    // Random bytes measure about 7.4 at 256 bytes
+    // and 7.7 at 512, while text and markup stay
+    // under 6 and packed integers near 6.
+    double sum = 0;
+    std::size_t distinct = 0;
+    for(auto c : count)
+    {
+        if(c == 0)
+            continue;
+        ++distinct;
+        sum += c * std::log2(static_cast<double>(c));
+    }
+    auto const dn = static_cast<double>(n);
+    auto const bits =
+        std::log2(dn) - sum / dn +
+        (distinct - 1) / (2 * dn * 0.6931471805599453);
+    return bits >= 7.2;
+}
+
+} // detail
+} // websocket
+} // beast
+} // boost
+
+#endif
@@ -11,7 +11,9 @@
 #define BOOST_BEAST_WEBSOCKET_DETAIL_IMPL_BASE_HPP
 
 #include <boost/beast/websocket/option.hpp>
+#include <boost/beast/websocket/detail/deflate_probe.hpp>
 #include <boost/beast/websocket/detail/frame.hpp>
+#include <boost/beast/websocket/detail/pmd_pool.hpp>
 #include <boost/beast/websocket/detail/pmd_extension.hpp>
 #include <boost/beast/core/buffer_traits.hpp>
 #include <boost/beast/core/role.hpp>
@@ -20,11 +22,15 @@
 #include <boost/beast/http/string_body.hpp>
 #include <boost/beast/zlib/deflate_stream.hpp>
 #include <boost/beast/zlib/inflate_stream.hpp>
+#include <boost/beast/core/buffers_prefix.hpp>
 #include <boost/beast/core/buffers_suffix.hpp>
 #include <boost/beast/core/error.hpp>
 #include <boost/beast/core/detail/clamp.hpp>
 #include <boost/asio/buffer.hpp>
+#include <boost/make_unique.hpp>
+#include <algorithm>
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <stdexcept>
 
@@ -33,6 +39,10 @@ namespace beast {
 namespace websocket {
 namespace detail {
 
+// Chooses the compression level of a message
+using deflate_cb_type =
+    std::function<int(net::const_buffer, std::size_t)>;
+
 //------------------------------------------------------------------------------
 
 template<bool deflateSupported>
@@ -48,13 +58,85 @@ struct impl_base<true>
         bool rd_set = false;
         std::size_t rd_eb_consumed = 0;
 
-        zlib::deflate_stream zo;
-        zlib::inflate_stream zi;
+        // Created on first use. Without context takeover
+        // they are only held for the length of a message.
+        std::unique_ptr<zlib::deflate_stream> zo;
+        std::unique_ptr<zlib::inflate_stream> zi;
+        int zo_bits = 15;
+        int zi_bits = 15;
+        int zo_level = 0;
+
+        // Observed output per 1024 bytes of input,
+        // averaged over recent outgoing messages
+        std::size_t wr_in = 0;
+        std::size_t wr_out = 0;
+        unsigned wr_ratio = 0;
+        bool wr_fast = false;
     };
 
     std::unique_ptr<pmd_type>   pmd_;           // pmd settings or nullptr
     permessage_deflate          pmd_opts_;      // local pmd options
     detail::pmd_offer           pmd_config_;    // offer (client) or negotiation (server)
+    pmd_pool*                   pmd_pool_       /* idle compression state */ = nullptr;
+
+    impl_base() = default;
+
+    ~impl_base()
+    {
+        close_pmd();
+    }
+
+    zlib::deflate_stream&
+    deflater()
+    {
+        auto& zo = pmd_->zo;
+        if(! zo)
+        {
+            zo = pmd_pool_ ? pmd_pool_->take_deflate() :
+                boost::make_unique<zlib::deflate_stream>();
+            zo->reset(
+                pmd_->zo_level,
+                pmd_->zo_bits,
+                pmd_opts_.memLevel,
+                zlib::Strategy::normal);
+        }
+        return *zo;
+    }
+
+    zlib::inflate_stream&
+    inflater()
+    {
+        auto& zi = pmd_->zi;
+        if(! zi)
+        {
+            zi = pmd_pool_ ? pmd_pool_->take_inflate() :
+                boost::make_unique<zlib::inflate_stream>();
+            zi->reset(pmd_->zi_bits);
+        }
+        return *zi;
+    }
+
+    // give up the compressor, the next
+    // message will start with a new window
+    void
+    release_deflate() noexcept
+    {
+        if(pmd_pool_)
+            pmd_pool_->give_back(std::move(pmd_->zo));
+        else
+            pmd_->zo.reset();
+    }
+
+    // give up the decompressor, the next
+    // message will start with a new window
+    void
+    release_inflate() noexcept
+    {
+        if(pmd_pool_)
+            pmd_pool_->give_back(std::move(pmd_->zi));
+        else
+            pmd_->zi.reset();
+    }
 
     // return `true` if current message is deflated
     bool
@@ -90,7 +172,7 @@ struct impl_base<true>
         error_code& ec)
     {
         BOOST_ASSERT(out.size() >= 6);
-        auto& zo = this->pmd_->zo;
+        auto& zo = deflater();
         zlib::z_params zs;
         zs.avail_in = 0;
         zs.next_in = nullptr;
@@ -144,12 +226,91 @@ struct impl_base<true>
                     // remove flush marker
                     zs.total_out -= 4;
                     out = net::buffer(out.data(), zs.total_out);
+                    count_deflate(zs.total_in, zs.total_out, true);
                     return false;
                 }
             }
         }
         ec = {};
         out = net::buffer(out.data(), zs.total_out);
+        count_deflate(zs.total_in, zs.total_out, false);
+        return true;
+    }
+
+    // Track the compression ratio of outgoing messages. When
+    // adapting, recent messages which shrink by less than a
+    // fifth switch the compressor to its fastest level, as
+    // higher levels gain little there. It goes back once
+    // they shrink by 30% or more.
+    void
+    count_deflate(
+        std::size_t in, std::size_t out, bool done)
+    {
+        pmd_->wr_in += in;
+        pmd_->wr_out += out;
+        if(! done)
+            return;
+        // Small messages say little about the data
+        if(pmd_->wr_in >= 256)
+        {
+            auto const r = (std::min<std::uint64_t>)(2048,
+                std::uint64_t(pmd_->wr_out) * 1024 / pmd_->wr_in);
+            // zero until the first message is seen
+            pmd_->wr_ratio = static_cast<unsigned>(
+                pmd_->wr_ratio == 0 ? r :
+                (3 * std::uint64_t(pmd_->wr_ratio) + r) / 4);
+            if(pmd_->wr_ratio > 820)
+                pmd_->wr_fast = true;
+            else if(pmd_->wr_ratio < 717)
+                pmd_->wr_fast = false;
+        }
+        pmd_->wr_in = 0;
+        pmd_->wr_out = 0;
+    }
+
+    // Decide whether the message which starts with the `n`
+    // bytes in `buffers` is compressed, and at which level
+    template<class ConstBufferSequence>
+    bool
+    begin_deflate(
+        ConstBufferSequence const& buffers,
+        std::size_t n,
+        deflate_cb_type const& cb)
+    {
+        if(! pmd_ || n < pmd_opts_.msg_size_threshold)
+            return false;
+        int level = pmd_opts_.compLevel;
+        if(cb)
+        {
+            level = cb(beast::buffers_front(buffers), n);
+            if(level <= 0)
+                return false;
+            if(level > 9)
+                level = 9;
+        }
+        else
+        {
+            if( pmd_opts_.msg_probe &&
+                detail::is_incompressible(buffers, n))
+                return false;
+            if( pmd_opts_.adaptive_level &&
+                pmd_->wr_fast && level > 1)
+                level = 1;
+        }
+        if(level != pmd_->zo_level)
+        {
+            pmd_->zo_level = level;
+            if(pmd_->zo)
+            {
+                // Nothing is pending between
+                // messages, so this cannot fail
+                zlib::z_params zs;
+                error_code ec;
+                pmd_->zo->params(
+                    zs, level, zlib::Strategy::normal, ec);
+                BOOST_ASSERT(! ec);
+            }
+        }
         return true;
     }
 
@@ -161,16 +322,62 @@ struct impl_base<true>
            (role == role_type::server &&
             this->pmd_config_.server_no_context_takeover))
         {
-            this->pmd_->zo.reset();
+            release_deflate();
         }
     }
 
+    // return `true` if a message compressed with a new
+    // window of `window_bits` may be sent in this role
+    bool
+    pmd_accepts(role_type role, int window_bits) const
+    {
+        if(! pmd_)
+            return false;
+        return window_bits <= (role == role_type::client ?
+            pmd_config_.client_max_window_bits :
+            pmd_config_.server_max_window_bits);
+    }
+
+    // forget the compression window after sending
+    // a message compressed by someone else
+    void
+    pmd_reset_write()
+    {
+        release_deflate();
+    }
+
+    // give up the compressor between messages, the
+    // peer's window does not depend on our state
+    void
+    pmd_hibernate()
+    {
+        if(pmd_)
+            release_deflate();
+    }
+
+    // approximate bytes held for compression
+    std::size_t
+    pmd_bytes() const noexcept
+    {
+        if(! pmd_)
+            return 0;
+        std::size_t n = sizeof(pmd_type);
+        if(pmd_->zo)
+            n += sizeof(zlib::deflate_stream) +
+                (std::size_t{1} << (pmd_->zo_bits + 2)) +
+                (std::size_t{1} << (pmd_opts_.memLevel + 9));
+        if(pmd_->zi)
+            n += sizeof(zlib::inflate_stream) +
+                (std::size_t{1} << pmd_->zi_bits);
+        return n;
+    }
+
     void
     inflate(
         zlib::z_params& zs,
         error_code& ec)
     {
-        pmd_->zi.write(zs, zlib::Flush::sync, ec);
+        inflater().write(zs, zlib::Flush::sync, ec);
     }
 
     // append the empty block codes and inflate
@@ -197,7 +404,7 @@ struct impl_base<true>
            (role == role_type::server &&
                 pmd_config_.client_no_context_takeover))
         {
-            pmd_->zi.clear();
+            release_inflate();
         }
     }
 
@@ -275,8 +482,10 @@ struct impl_base<true>
     }
 
     void
-    open_pmd(role_type role)
+    open_pmd(role_type role, pmd_pool& pool)
     {
+        close_pmd();
+        pmd_pool_ = &pool;
         if(((role == role_type::client &&
                 pmd_opts_.client_enable) ||
             (role == role_type::server &&
@@ -285,44 +494,46 @@ struct impl_base<true>
         {
             detail::pmd_normalize(pmd_config_);
             pmd_.reset(::new pmd_type);
+            pmd_->zo_level = pmd_opts_.compLevel;
             if(role == role_type::client)
             {
-                pmd_->zi.reset(
-                    pmd_config_.server_max_window_bits);
-                pmd_->zo.reset(
-                    pmd_opts_.compLevel,
-                    pmd_config_.client_max_window_bits,
-                    pmd_opts_.memLevel,
-                    zlib::Strategy::normal);
+                pmd_->zi_bits =
+                    pmd_config_.server_max_window_bits;
+                pmd_->zo_bits =
+                    pmd_config_.client_max_window_bits;
             }
             else
             {
-                pmd_->zi.reset(
-                    pmd_config_.client_max_window_bits);
-                pmd_->zo.reset(
-                    pmd_opts_.compLevel,
-                    pmd_config_.server_max_window_bits,
-                    pmd_opts_.memLevel,
-                    zlib::Strategy::normal);
+                pmd_->zi_bits =
+                    pmd_config_.client_max_window_bits;
+                pmd_->zo_bits =
+                    pmd_config_.server_max_window_bits;
             }
         }
     }
 
     void close_pmd()
     {
+        if(! pmd_)
+            return;
+        release_deflate();
+        release_inflate();
         pmd_.reset();
     }
 
-    bool pmd_enabled() const
+    // the pool is going away
+    void shutdown_pmd()
     {
-        return pmd_ != nullptr;
+        close_pmd();
+        pmd_pool_ = nullptr;
     }
 
-    bool should_compress(std::size_t n_bytes) const
+    bool pmd_enabled() const
     {
-        return n_bytes >= pmd_opts_.msg_size_threshold;
+        return pmd_ != nullptr;
     }
 
+
     std::size_t
     read_size_hint_pmd(
         std::size_t initial_size,
@@ -406,6 +617,28 @@ struct impl_base<false>
     {
     }
 
+    bool
+    pmd_accepts(role_type, int) const
+    {
+        return false;
+    }
+
+    void
+    pmd_reset_write()
+    {
+    }
+
+    void
+    pmd_hibernate()
+    {
+    }
+
+    std::size_t
+    pmd_bytes() const noexcept
+    {
+        return 0;
+    }
+
     void
     inflate(
         zlib::z_params&,
@@ -471,7 +704,7 @@ struct impl_base<false>
     {
     }
 
-    void open_pmd(role_type)
+    void open_pmd(role_type, pmd_pool&)
     {
     }
 
@@ -479,12 +712,21 @@ struct impl_base<false>
     {
     }
 
+    void shutdown_pmd()
+    {
+    }
+
     bool pmd_enabled() const
     {
         return false;
     }
 
-    bool should_compress(std::size_t) const
+    template<class ConstBufferSequence>
+    bool
+    begin_deflate(
+        ConstBufferSequence const&,
+        std::size_t,
+        deflate_cb_type const&)
     {
         return false;
     }
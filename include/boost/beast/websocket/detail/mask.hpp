@@ -11,6 +11,8 @@
 #define BOOST_BEAST_WEBSOCKET_DETAIL_MASK_HPP
 
 #include <boost/beast/core/detail/config.hpp>
+#include <boost/beast/core/detail/cpu_info.hpp>
+#include <boost/beast/websocket/detail/utf8_checker.hpp>
 #include <boost/beast/core/buffers_range.hpp>
 #include <boost/asio/buffer.hpp>
 #include <array>
@@ -30,12 +32,153 @@ BOOST_BEAST_DECL
 void
 prepare_key(prepared_key& prepared, std::uint32_t key);
 
+/*  Masking kernels
+
+    Each kernel masks the longest prefix of [in, in + n)
+    whose size is a multiple of its block size into `out`,
+    and returns the number of bytes masked. `out` may be
+    equal to `in` but the ranges must not otherwise overlap.
+    Since a block is a multiple of four bytes the key does
+    not rotate. The SSE2 and AVX2 kernels must only be called
+    when get_cpu_info() reports support for the instruction set.
+*/
+BOOST_BEAST_DECL
+std::size_t
+mask_swar(
+    unsigned char* out,
+    unsigned char const* in,
+    std::size_t n,
+    prepared_key const& key) noexcept;
+
+#if ! BOOST_BEAST_NO_INTRINSICS
+
+BOOST_BEAST_DECL
+std::size_t
+mask_sse2(
+    unsigned char* out,
+    unsigned char const* in,
+    std::size_t n,
+    prepared_key const& key) noexcept;
+
+BOOST_BEAST_DECL
+std::size_t
+mask_avx2(
+    unsigned char* out,
+    unsigned char const* in,
+    std::size_t n,
+    prepared_key const& key) noexcept;
+
+#endif
+
+#if BOOST_BEAST_NEON
+
+BOOST_BEAST_DECL
+std::size_t
+mask_neon(
+    unsigned char* out,
+    unsigned char const* in,
+    std::size_t n,
+    prepared_key const& key) noexcept;
+
+#endif
+
+/*  Unmasking kernels for text
+
+    Each kernel unmasks [p, p + n) in place one block at a
+    time for as long as every unmasked byte is ASCII, and
+    returns the number of bytes unmasked. The first block
+    holding a byte with the high bit set is left untouched.
+    Block sizes and instruction set requirements are the
+    same as for the masking kernels.
+*/
+BOOST_BEAST_DECL
+std::size_t
+unmask_ascii_swar(
+    unsigned char* p,
+    std::size_t n,
+    prepared_key const& key) noexcept;
+
+#if ! BOOST_BEAST_NO_INTRINSICS
+
+BOOST_BEAST_DECL
+std::size_t
+unmask_ascii_sse2(
+    unsigned char* p,
+    std::size_t n,
+    prepared_key const& key) noexcept;
+
+BOOST_BEAST_DECL
+std::size_t
+unmask_ascii_avx2(
+    unsigned char* p,
+    std::size_t n,
+    prepared_key const& key) noexcept;
+
+#endif
+
+#if BOOST_BEAST_NEON
+
+BOOST_BEAST_DECL
+std::size_t
+unmask_ascii_neon(
+    unsigned char* p,
+    std::size_t n,
+    prepared_key const& key) noexcept;
+
+#endif
+
 // Apply mask in place
 //
 BOOST_BEAST_DECL
 void
 mask_inplace(net::mutable_buffer const& b, prepared_key& key);
 
+// Apply mask in place and check the result as utf8 in a
+// single pass, returns `false` if the text is not valid.
+// The whole buffer is unmasked even if the check fails.
+//
+BOOST_BEAST_DECL
+bool
+unmask_utf8(
+    net::mutable_buffer const& b,
+    prepared_key& key,
+    utf8_checker& checker);
+
+// Copy and apply mask in a single pass, returns the
+// number of bytes copied, which is the smaller of the
+// two buffer sizes.
+//
+BOOST_BEAST_DECL
+std::size_t
+mask_copy(
+    net::mutable_buffer const& dest,
+    net::const_buffer const& source,
+    prepared_key& key);
+
+// Copy and apply mask in a single pass, returns the
+// number of bytes copied, which is the smaller of the
+// destination size and the size of the sequence.
+//
+template<class ConstBufferSequence>
+std::size_t
+mask_copy(
+    net::mutable_buffer dest,
+    ConstBufferSequence const& source,
+    prepared_key& key)
+{
+    std::size_t total = 0;
+    for(net::const_buffer b :
+            beast::buffers_range_ref(source))
+    {
+        if(dest.size() == 0)
+            break;
+        auto const n = detail::mask_copy(dest, b, key);
+        dest += n;
+        total += n;
+    }
+    return total;
+}
+
 // Apply mask in place
 //
 template<class MutableBufferSequence>
@@ -49,6 +192,29 @@ mask_inplace(
         detail::mask_inplace(b, key);
 }
 
+// Apply mask in place and check the result as utf8
+// in a single pass, returns `false` if the text is
+// not valid.
+//
+template<class MutableBufferSequence>
+bool
+unmask_utf8(
+    MutableBufferSequence const& buffers,
+    prepared_key& key,
+    utf8_checker& checker)
+{
+    bool valid = true;
+    for(net::mutable_buffer b :
+            beast::buffers_range_ref(buffers))
+    {
+        if(valid)
+            valid = detail::unmask_utf8(b, key, checker);
+        else
+            detail::mask_inplace(b, key);
+    }
+    return valid;
+}
+
 } // detail
 } // websocket
 } // beast
@@ -11,6 +11,16 @@
 #define BOOST_BEAST_WEBSOCKET_DETAIL_MASK_IPP
 
 #include <boost/beast/websocket/detail/mask.hpp>
+#include <algorithm>
+#include <cstring>
+
+#if ! BOOST_BEAST_NO_INTRINSICS
+#include <immintrin.h>
+#endif
+
+#if BOOST_BEAST_NEON
+#include <arm_neon.h>
+#endif
 
 namespace boost {
 namespace beast {
@@ -35,27 +45,378 @@ rol(prepared_key& v, std::size_t n)
         v[i] = v0[(i + n) % v.size()];
 }
 
-// Apply mask in place
-//
+std::size_t
+mask_swar(
+    unsigned char* out,
+    unsigned char const* in,
+    std::size_t n,
+    prepared_key const& key) noexcept
+{
+    std::uint64_t m;
+    std::memcpy(&m, key.data(), 4);
+    std::memcpy(reinterpret_cast<unsigned char*>(&m) + 4, key.data(), 4);
+    auto const n0 = n;
+    while(n >= 8)
+    {
+        std::uint64_t w;
+        std::memcpy(&w, in, 8);
+        w ^= m;
+        std::memcpy(out, &w, 8);
+        in += 8;
+        out += 8;
+        n -= 8;
+    }
+    return n0 - n;
+}
+
+#if ! BOOST_BEAST_NO_INTRINSICS
+
+BOOST_BEAST_TARGET("sse2")
+std::size_t
+mask_sse2(
+    unsigned char* out,
+    unsigned char const* in,
+    std::size_t n,
+    prepared_key const& key) noexcept
+{
+    unsigned char kb[16];
+    for(std::size_t i = 0; i < sizeof(kb); i += 4)
+        std::memcpy(kb + i, key.data(), 4);
+    __m128i const m = _mm_loadu_si128(
+        reinterpret_cast<__m128i const*>(kb));
+    auto const n0 = n;
+    while(n >= 16)
+    {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out),
+            _mm_xor_si128(_mm_loadu_si128(
+                reinterpret_cast<__m128i const*>(in)), m));
+        in += 16;
+        out += 16;
+        n -= 16;
+    }
+    return n0 - n;
+}
+
+BOOST_BEAST_TARGET("avx2")
+std::size_t
+mask_avx2(
+    unsigned char* out,
+    unsigned char const* in,
+    std::size_t n,
+    prepared_key const& key) noexcept
+{
+    unsigned char kb[32];
+    for(std::size_t i = 0; i < sizeof(kb); i += 4)
+        std::memcpy(kb + i, key.data(), 4);
+    __m256i const m = _mm256_loadu_si256(
+        reinterpret_cast<__m256i const*>(kb));
+    auto const n0 = n;
+    while(n >= 64)
+    {
+        auto const src = reinterpret_cast<__m256i const*>(in);
+        auto const dst = reinterpret_cast<__m256i*>(out);
+        __m256i const v0 = _mm256_loadu_si256(src);
+        __m256i const v1 = _mm256_loadu_si256(src + 1);
+        _mm256_storeu_si256(dst, _mm256_xor_si256(v0, m));
+        _mm256_storeu_si256(dst + 1, _mm256_xor_si256(v1, m));
+        in += 64;
+        out += 64;
+        n -= 64;
+    }
+    if(n >= 32)
+    {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out),
+            _mm256_xor_si256(_mm256_loadu_si256(
+                reinterpret_cast<__m256i const*>(in)), m));
+        n -= 32;
+    }
+    return n0 - n;
+}
+
+#endif
+
+#if BOOST_BEAST_NEON
+
+std::size_t
+mask_neon(
+    unsigned char* out,
+    unsigned char const* in,
+    std::size_t n,
+    prepared_key const& key) noexcept
+{
+    unsigned char kb[16];
+    for(std::size_t i = 0; i < sizeof(kb); i += 4)
+        std::memcpy(kb + i, key.data(), 4);
+    uint8x16_t const m = vld1q_u8(kb);
+    auto const n0 = n;
+    while(n >= 16)
+    {
+        vst1q_u8(out, veorq_u8(vld1q_u8(in), m));
+        in += 16;
+        out += 16;
+        n -= 16;
+    }
+    return n0 - n;
+}
+
+#endif
+
+std::size_t
+unmask_ascii_swar(
+    unsigned char* p,
+    std::size_t n,
+    prepared_key const& key) noexcept
+{
+    std::uint64_t m;
+    std::memcpy(&m, key.data(), 4);
+    std::memcpy(reinterpret_cast<unsigned char*>(&m) + 4, key.data(), 4);
+    auto const n0 = n;
+    while(n >= 8)
+    {
+        std::uint64_t w;
+        std::memcpy(&w, p, 8);
+        w ^= m;
+        if((w & 0x8080808080808080ULL) != 0)
+            break;
+        std::memcpy(p, &w, 8);
+        p += 8;
+        n -= 8;
+    }
+    return n0 - n;
+}
+
+#if ! BOOST_BEAST_NO_INTRINSICS
+
+BOOST_BEAST_TARGET("sse2")
+std::size_t
+unmask_ascii_sse2(
+    unsigned char* p,
+    std::size_t n,
+    prepared_key const& key) noexcept
+{
+    unsigned char kb[16];
+    for(std::size_t i = 0; i < sizeof(kb); i += 4)
+        std::memcpy(kb + i, key.data(), 4);
+    __m128i const m = _mm_loadu_si128(
+        reinterpret_cast<__m128i const*>(kb));
+    auto const n0 = n;
+    while(n >= 16)
+    {
+        __m128i const v = _mm_xor_si128(_mm_loadu_si128(
+            reinterpret_cast<__m128i const*>(p)), m);
+        if(_mm_movemask_epi8(v) != 0)
+            break;
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v);
+        p += 16;
+        n -= 16;
+    }
+    return n0 - n;
+}
+
+BOOST_BEAST_TARGET("avx2")
+std::size_t
+unmask_ascii_avx2(
+    unsigned char* p,
+    std::size_t n,
+    prepared_key const& key) noexcept
+{
+    unsigned char kb[32];
+    for(std::size_t i = 0; i < sizeof(kb); i += 4)
+        std::memcpy(kb + i, key.data(), 4);
+    __m256i const m = _mm256_loadu_si256(
+        reinterpret_cast<__m256i const*>(kb));
+    auto const n0 = n;
+    while(n >= 32)
+    {
+        __m256i const v = _mm256_xor_si256(_mm256_loadu_si256(
+            reinterpret_cast<__m256i const*>(p)), m);
+        if(_mm256_movemask_epi8(v) != 0)
+            break;
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v);
+        p += 32;
+        n -= 32;
+    }
+    return n0 - n;
+}
+
+#endif
+
+#if BOOST_BEAST_NEON
+
+std::size_t
+unmask_ascii_neon(
+    unsigned char* p,
+    std::size_t n,
+    prepared_key const& key) noexcept
+{
+    unsigned char kb[16];
+    for(std::size_t i = 0; i < sizeof(kb); i += 4)
+        std::memcpy(kb + i, key.data(), 4);
+    uint8x16_t const m = vld1q_u8(kb);
+    auto const n0 = n;
+    while(n >= 16)
+    {
+        uint8x16_t const v = veorq_u8(vld1q_u8(p), m);
+        if(vmaxvq_u8(v) >= 0x80)
+            break;
+        vst1q_u8(p, v);
+        p += 16;
+        n -= 16;
+    }
+    return n0 - n;
+}
+
+#endif
+
+// Mask as many bytes as possible using
+// the best kernel the processor supports
+inline
+std::size_t
+mask_blocks(
+    unsigned char* out,
+    unsigned char const* in,
+    std::size_t n,
+    prepared_key const& key) noexcept
+{
+    std::size_t used = 0;
+#if BOOST_BEAST_NEON
+    used = mask_neon(out, in, n, key);
+#elif ! BOOST_BEAST_NO_INTRINSICS
+    auto const& ci = beast::detail::get_cpu_info();
+    if(ci.avx2)
+        used = mask_avx2(out, in, n, key);
+    else if(ci.sse2)
+        used = mask_sse2(out, in, n, key);
+#endif
+    return used + mask_swar(
+        out + used, in + used, n - used, key);
+}
+
+// Unmask as many ASCII bytes as possible using
+// the best kernel the processor supports
+inline
+std::size_t
+unmask_ascii(
+    unsigned char* p,
+    std::size_t n,
+    prepared_key const& key) noexcept
+{
+    std::size_t used = 0;
+#if BOOST_BEAST_NEON
+    used = unmask_ascii_neon(p, n, key);
+#elif ! BOOST_BEAST_NO_INTRINSICS
+    auto const& ci = beast::detail::get_cpu_info();
+    if(ci.avx2)
+        used = unmask_ascii_avx2(p, n, key);
+    else if(ci.sse2)
+        used = unmask_ascii_sse2(p, n, key);
+#endif
+    return used + unmask_ascii_swar(
+        p + used, n - used, key);
+}
+
+inline
 void
-mask_inplace(net::mutable_buffer const& b, prepared_key& key)
+mask_bytes(
+    unsigned char* out,
+    unsigned char const* in,
+    std::size_t const size,
+    prepared_key& key) noexcept
 {
-    auto n = b.size();
-    auto const mask = key; // avoid aliasing
-    auto p = static_cast<unsigned char*>(b.data());
+    auto n = size;
+    auto mask = key; // avoid aliasing
+    if(n >= 64)
+    {
+        // Bring out to a 32-byte boundary so the
+        // kernels never split a cache line on store
+        auto const head = static_cast<std::size_t>(
+            (0 - reinterpret_cast<std::uintptr_t>(out)) & 31);
+        for(std::size_t i = 0; i < head; ++i)
+            out[i] = in[i] ^ mask[i % 4];
+        rol(mask, head);
+        in += head;
+        out += head;
+        n -= head;
+        auto const used = mask_blocks(out, in, n, mask);
+        in += used;
+        out += used;
+        n -= used;
+    }
     while(n >= 4)
     {
         for(int i = 0; i < 4; ++i)
-            p[i] ^= mask[i];
-        p += 4;
+            out[i] = in[i] ^ mask[i];
+        in += 4;
+        out += 4;
         n -= 4;
     }
-    if(n > 0)
+    for(std::size_t i = 0; i < n; ++i)
+        out[i] = in[i] ^ mask[i];
+    if(size % 4 != 0)
+        rol(key, size % 4);
+}
+
+// Apply mask in place
+//
+void
+mask_inplace(net::mutable_buffer const& b, prepared_key& key)
+{
+    auto const p = static_cast<unsigned char*>(b.data());
+    mask_bytes(p, p, b.size(), key);
+}
+
+bool
+unmask_utf8(
+    net::mutable_buffer const& b,
+    prepared_key& key,
+    utf8_checker& checker)
+{
+    // Text which is not ASCII is unmasked this many
+    // bytes at a time and checked while still in cache
+    std::size_t constexpr chunk = 1024;
+
+    auto p = static_cast<unsigned char*>(b.data());
+    auto n = b.size();
+    bool valid = true;
+    while(n >= 64)
     {
-        for(std::size_t i = 0; i < n; ++i)
-            p[i] ^= mask[i];
-        rol(key, n);
+        auto const used = unmask_ascii(p, n, key);
+        if(used > 0)
+        {
+            // The first character completes or rejects any
+            // code point left over from before, after which
+            // the rest of the ASCII run needs no checking.
+            if(valid)
+                valid = checker.write(p, 1);
+            p += used;
+            n -= used;
+            continue;
+        }
+        auto const size = (std::min)(n, chunk);
+        mask_bytes(p, p, size, key);
+        if(valid)
+            valid = checker.write(p, size);
+        p += size;
+        n -= size;
     }
+    mask_bytes(p, p, n, key);
+    if(valid && n > 0)
+        valid = checker.write(p, n);
+    return valid;
+}
+
+std::size_t
+mask_copy(
+    net::mutable_buffer const& dest,
+    net::const_buffer const& source,
+    prepared_key& key)
+{
+    auto const n = (std::min)(dest.size(), source.size());
+    mask_bytes(
+        static_cast<unsigned char*>(dest.data()),
+        static_cast<unsigned char const*>(source.data()),
+        n, key);
+    return n;
 }
 
 } // detail
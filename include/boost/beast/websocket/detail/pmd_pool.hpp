@@ -0,0 +1,75 @@
+//
+// Copyright (c) 2016-2019 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/beast
+//
+
+#ifndef BOOST_BEAST_WEBSOCKET_DETAIL_PMD_POOL_HPP
+#define BOOST_BEAST_WEBSOCKET_DETAIL_PMD_POOL_HPP
+
+#include <boost/beast/core/detail/config.hpp>
+#include <boost/beast/zlib/deflate_stream.hpp>
+#include <boost/beast/zlib/inflate_stream.hpp>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace boost {
+namespace beast {
+namespace websocket {
+namespace detail {
+
+// A thread-safe cache of permessage-deflate
+// compressors and decompressors shared by the
+// streams of one execution context. Idle objects
+// keep their buffers, so a stream which takes
+// one for a single message does not allocate.
+class pmd_pool
+{
+    std::mutex m_;
+    std::vector<std::unique_ptr<zlib::deflate_stream>> zo_;
+    std::vector<std::unique_ptr<zlib::inflate_stream>> zi_;
+
+public:
+    // Maximum number of idle objects of each kind kept
+    static std::size_t constexpr max_idle = 16;
+
+    BOOST_BEAST_DECL
+    pmd_pool();
+
+    pmd_pool(pmd_pool const&) = delete;
+    pmd_pool& operator=(pmd_pool const&) = delete;
+
+    // Returns a compressor, the caller must reset it
+    BOOST_BEAST_DECL
+    std::unique_ptr<zlib::deflate_stream>
+    take_deflate();
+
+    // Returns a decompressor, the caller must reset it
+    BOOST_BEAST_DECL
+    std::unique_ptr<zlib::inflate_stream>
+    take_inflate();
+
+    BOOST_BEAST_DECL
+    void
+    give_back(std::unique_ptr<zlib::deflate_stream> p) noexcept;
+
+    BOOST_BEAST_DECL
+    void
+    give_back(std::unique_ptr<zlib::inflate_stream> p) noexcept;
+};
+
+} // detail
+} // websocket
+} // beast
+} // boost
+
+#if BOOST_BEAST_HEADER_ONLY
+#include <boost/beast/websocket/detail/pmd_pool.ipp>
+#endif
+
+#endif
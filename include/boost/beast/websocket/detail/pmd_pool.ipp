@@ -0,0 +1,88 @@
+//
+// Copyright (c) 2016-2019 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/beast
+//
+
+#ifndef BOOST_BEAST_WEBSOCKET_DETAIL_PMD_POOL_IPP
+#define BOOST_BEAST_WEBSOCKET_DETAIL_PMD_POOL_IPP
+
+#include <boost/beast/websocket/detail/pmd_pool.hpp>
+#include <boost/make_unique.hpp>
+
+namespace boost {
+namespace beast {
+namespace websocket {
+namespace detail {
+
+pmd_pool::
+pmd_pool()
+{
+    // So that give_back never allocates
+    zo_.reserve(max_idle);
+    zi_.reserve(max_idle);
+}
+
+std::unique_ptr<zlib::deflate_stream>
+pmd_pool::
+take_deflate()
+{
+    {
+        std::lock_guard<std::mutex> g(m_);
+        if(! zo_.empty())
+        {
+            auto p = std::move(zo_.back());
+            zo_.pop_back();
+            return p;
+        }
+    }
+    return boost::make_unique<zlib::deflate_stream>();
+}
+
+std::unique_ptr<zlib::inflate_stream>
+pmd_pool::
+take_inflate()
+{
+    {
+        std::lock_guard<std::mutex> g(m_);
+        if(! zi_.empty())
+        {
+            auto p = std::move(zi_.back());
+            zi_.pop_back();
+            return p;
+        }
+    }
+    return boost::make_unique<zlib::inflate_stream>();
+}
+
+void
+pmd_pool::
+give_back(std::unique_ptr<zlib::deflate_stream> p) noexcept
+{
+    if(! p)
+        return;
+    std::lock_guard<std::mutex> g(m_);
+    if(zo_.size() < max_idle)
+        zo_.push_back(std::move(p));
+}
+
+void
+pmd_pool::
+give_back(std::unique_ptr<zlib::inflate_stream> p) noexcept
+{
+    if(! p)
+        return;
+    std::lock_guard<std::mutex> g(m_);
+    if(zi_.size() < max_idle)
+        zi_.push_back(std::move(p));
+}
+
+} // detail
+} // websocket
+} // beast
+} // boost
+
+#endif
@@ -0,0 +1,166 @@
+//
+// Copyright (c) 2016-2019 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/beast
+//
+
+#ifndef BOOST_BEAST_WEBSOCKET_DETAIL_READ_BUFFER_HPP
+#define BOOST_BEAST_WEBSOCKET_DETAIL_READ_BUFFER_HPP
+
+#include <boost/beast/core/static_buffer.hpp>
+#include <boost/beast/websocket/detail/buffer_pool.hpp>
+#include <boost/asio/buffer.hpp>
+#include <boost/assert.hpp>
+#include <cstddef>
+
+namespace boost {
+namespace beast {
+namespace websocket {
+namespace detail {
+
+// The circular buffer which holds received bytes
+// not yet handed to the caller.
+//
+// The first N bytes of storage are inline. A larger
+// size is either allocated for the life of the stream,
+// or borrowed from a pool while a read operation
+// receives a payload, returning to the inline storage
+// whenever what is left over fits.
+//
+template<std::size_t N>
+class read_buffer : public static_buffer_base
+{
+    char buf_[N];
+    char* p_ = nullptr;         // larger storage, if any
+    buffer_pool* pool_ = nullptr;
+    std::size_t size_opt_ = N;  // size option
+    bool pooled_opt_ = false;   // pooled option
+
+    // Move the readable bytes to new storage
+    void
+    move_to(char* p, std::size_t n) noexcept
+    {
+        BOOST_ASSERT(size() <= n);
+        auto const used = net::buffer_copy(
+            net::mutable_buffer(p, n), data());
+        reset(p, n);
+        commit(net::buffer_size(prepare(used)));
+    }
+
+    void
+    free_storage() noexcept
+    {
+        if(! p_)
+            return;
+        if(pool_)
+            pool_->give_back(p_, size_opt_);
+        else
+            delete[] p_;
+        p_ = nullptr;
+    }
+
+public:
+    read_buffer() noexcept
+        : static_buffer_base(buf_, N)
+    {
+    }
+
+    read_buffer(read_buffer const&) = delete;
+    read_buffer& operator=(read_buffer const&) = delete;
+
+    ~read_buffer()
+    {
+        free_storage();
+    }
+
+    std::size_t
+    size_option() const noexcept
+    {
+        return size_opt_;
+    }
+
+    bool
+    pooled_option() const noexcept
+    {
+        return pooled_opt_;
+    }
+
+    // Bytes of storage held outside of the object
+    std::size_t
+    storage_bytes() const noexcept
+    {
+        return p_ ? size_opt_ : 0;
+    }
+
+    // Change the size and strategy. Sizes below
+    // N use the inline storage. Readable bytes are
+    // kept, so the size may not drop below them.
+    void
+    set(std::size_t size, bool pooled, buffer_pool& pool)
+    {
+        if(size < N)
+            size = N;
+        BOOST_ASSERT(static_buffer_base::size() <= size);
+        if(size == size_opt_ && pooled == pooled_opt_)
+            return;
+        char* p = nullptr;
+        if(size > N && (! pooled ||
+                static_buffer_base::size() > N))
+            p = pooled ? pool.borrow(size) : new char[size];
+        if(p)
+            move_to(p, size);
+        else if(p_)
+            move_to(buf_, N);
+        free_storage();
+        p_ = p;
+        size_opt_ = size;
+        pooled_opt_ = pooled;
+        pool_ = pooled ? &pool : nullptr;
+    }
+
+    // Called before a read operation
+    // receives payload into the buffer
+    void
+    acquire()
+    {
+        if(! pooled_opt_ || p_ || size_opt_ == N)
+            return;
+        auto const p = pool_->borrow(size_opt_);
+        move_to(p, size_opt_);
+        p_ = p;
+    }
+
+    // Called when a read operation completes,
+    // or waits for the header of the next frame
+    void
+    release() noexcept
+    {
+        if(! pooled_opt_ || ! p_ || static_buffer_base::size() > N)
+            return;
+        move_to(buf_, N);
+        free_storage();
+    }
+
+    // Return borrowed storage now, dropping any
+    // bytes which do not fit the inline storage
+    void
+    shutdown() noexcept
+    {
+        if(! pooled_opt_ || ! p_)
+            return;
+        if(static_buffer_base::size() > N)
+            clear();
+        move_to(buf_, N);
+        free_storage();
+    }
+};
+
+} // detail
+} // websocket
+} // beast
+} // boost
+
+#endif
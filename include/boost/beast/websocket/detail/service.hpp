@@ -11,6 +11,8 @@
 #define BOOST_BEAST_WEBSOCKET_DETAIL_SERVICE_HPP
 
 #include <boost/beast/core/detail/service_base.hpp>
+#include <boost/beast/websocket/detail/buffer_pool.hpp>
+#include <boost/beast/websocket/detail/pmd_pool.hpp>
 #include <boost/asio/execution_context.hpp>
 #include <boost/enable_shared_from_this.hpp>
 #include <mutex>
@@ -44,6 +46,14 @@ public:
         void
         remove();
 
+        // Buffers shared by the streams of the execution context
+        buffer_pool&
+        pool() noexcept;
+
+        // Compression state shared by the streams of the execution context
+        pmd_pool&
+        deflate_pool() noexcept;
+
         virtual
         void
         shutdown() = 0;
@@ -52,6 +62,8 @@ public:
 private:
     std::mutex m_;
     std::vector<impl_type*> v_;
+    buffer_pool pool_;
+    pmd_pool pmd_pool_;
 
     BOOST_BEAST_DECL
     void
@@ -66,6 +78,24 @@ public:
     }
 };
 
+inline
+buffer_pool&
+service::
+impl_type::
+pool() noexcept
+{
+    return svc_.pool_;
+}
+
+inline
+pmd_pool&
+service::
+impl_type::
+deflate_pool() noexcept
+{
+    return svc_.pmd_pool_;
+}
+
 } // detail
 } // websocket
 } // beast
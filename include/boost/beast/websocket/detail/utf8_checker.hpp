@@ -11,6 +11,7 @@
 #define BOOST_BEAST_WEBSOCKET_DETAIL_UTF8_CHECKER_HPP
 
 #include <boost/beast/core/buffers_range.hpp>
+#include <boost/beast/core/detail/cpu_info.hpp>
 #include <boost/asio/buffer.hpp>
 
 #include <cstdint>
@@ -84,6 +85,59 @@ BOOST_BEAST_DECL
 bool
 check_utf8(char const* p, std::size_t n);
 
+/*  Bulk validators
+
+    Each function returns `true` if [in, in + size) holds
+    only complete and valid utf8 code points. The scalar
+    version walks one code point at a time, skipping runs of
+    ASCII eight bytes at once. The SSSE3, AVX2 and NEON
+    versions classify every byte of a block with table
+    lookups. The SSSE3 and AVX2 versions must only be called
+    when get_cpu_info() reports support for the instruction set.
+*/
+BOOST_BEAST_DECL
+bool
+validate_utf8_scalar(
+    std::uint8_t const* in,
+    std::size_t size) noexcept;
+
+#if ! BOOST_BEAST_NO_INTRINSICS
+
+BOOST_BEAST_DECL
+bool
+validate_utf8_ssse3(
+    std::uint8_t const* in,
+    std::size_t size) noexcept;
+
+BOOST_BEAST_DECL
+bool
+validate_utf8_avx2(
+    std::uint8_t const* in,
+    std::size_t size) noexcept;
+
+#endif
+
+#if BOOST_BEAST_NEON
+
+BOOST_BEAST_DECL
+bool
+validate_utf8_neon(
+    std::uint8_t const* in,
+    std::size_t size) noexcept;
+
+#endif
+
+/** Return `true` if the text is complete and valid utf8.
+
+    The fastest implementation supported by the
+    processor is selected at runtime.
+*/
+BOOST_BEAST_DECL
+bool
+validate_utf8(
+    std::uint8_t const* in,
+    std::size_t size) noexcept;
+
 } // detail
 } // websocket
 } // beast
@@ -13,12 +13,432 @@
 #include <boost/beast/websocket/detail/utf8_checker.hpp>
 
 #include <boost/assert.hpp>
+#include <algorithm>
+#include <cstring>
+
+#if ! BOOST_BEAST_NO_INTRINSICS
+#include <immintrin.h>
+#endif
+
+#if BOOST_BEAST_NEON
+#include <arm_neon.h>
+#endif
 
 namespace boost {
 namespace beast {
 namespace websocket {
 namespace detail {
 
+// Validate one complete code point and advance past it.
+// There must be at least as many bytes as the lead says.
+inline
+bool
+utf8_valid(std::uint8_t const*& p)
+{
+    if(p[0] < 128)
+    {
+        ++p;
+        return true;
+    }
+    if((p[0] & 0xe0) == 0xc0)
+    {
+        if( (p[1] & 0xc0) != 0x80 ||
+            (p[0] & 0x1e) == 0)  // overlong
+            return false;
+        p += 2;
+        return true;
+    }
+    if((p[0] & 0xf0) == 0xe0)
+    {
+        if(    (p[1] & 0xc0) != 0x80
+            || (p[2] & 0xc0) != 0x80
+            || (p[0] == 0xe0 && (p[1] & 0x20) == 0) // overlong
+            || (p[0] == 0xed && (p[1] & 0x20) == 0x20) // surrogate
+            //|| (p[0] == 0xef && p[1] == 0xbf && (p[2] & 0xfe) == 0xbe) // U+FFFE or U+FFFF
+            )
+            return false;
+        p += 3;
+        return true;
+    }
+    if((p[0] & 0xf8) == 0xf0)
+    {
+        if(    (p[0] & 0x07) >= 0x05 // invalid F5...FF characters
+            || (p[1] & 0xc0) != 0x80
+            || (p[2] & 0xc0) != 0x80
+            || (p[3] & 0xc0) != 0x80
+            || (p[0] == 0xf0 && (p[1] & 0x30) == 0) // overlong
+            || (p[0] == 0xf4 && p[1] > 0x8f) || p[0] > 0xf4 // > U+10FFFF
+            )
+            return false;
+        p += 4;
+        return true;
+    }
+    return false;
+}
+
+// Returns the size of a code point given its first
+// byte, or zero if the byte cannot start one.
+inline
+int
+utf8_size(std::uint8_t const v)
+{
+    if(v < 128)
+        return 1;
+    if(v < 192)
+        return 0;
+    if(v < 224)
+        return 2;
+    if(v < 240)
+        return 3;
+    if(v < 248)
+        return 4;
+    return 0;
+}
+
+// Returns the start of the code point which is cut
+// off by the end of [first, last), or `last` if the
+// text does not end with an incomplete code point.
+inline
+std::uint8_t const*
+utf8_split(
+    std::uint8_t const* first,
+    std::uint8_t const* last)
+{
+    for(int i = 1; i <= 3 && i <= last - first; ++i)
+    {
+        auto const c = last[-i];
+        if((c & 0xc0) == 0x80)
+            continue;
+        if(utf8_size(c) > i)
+            return last - i;
+        break;
+    }
+    return last;
+}
+
+bool
+validate_utf8_scalar(
+    std::uint8_t const* in,
+    std::size_t size) noexcept
+{
+    auto const end = in + size;
+    while(end - in >= 8)
+    {
+        // Skip eight low-ASCII characters at a time
+        std::uint64_t w;
+        std::memcpy(&w, in, sizeof(w));
+        if((w & 0x8080808080808080ULL) == 0)
+        {
+            in += 8;
+            continue;
+        }
+        if(! utf8_valid(in))
+            return false;
+    }
+    while(in != end)
+    {
+        auto const need = utf8_size(*in);
+        if(need == 0 || need > end - in)
+            return false;
+        if(! utf8_valid(in))
+            return false;
+    }
+    return true;
+}
+
+#if ! BOOST_BEAST_NO_INTRINSICS || BOOST_BEAST_NEON
+
+/*  Lookup tables for the vectorized validators.
+
+    Each pair of adjacent bytes is classified by three table
+    lookups: the high nibble of the first byte, the low nibble
+    of the first byte and the high nibble of the second byte.
+    Every bit stands for one kind of error, and the pair is
+    in error when a bit is set in all three results. Third
+    and fourth bytes of a code point are found separately,
+    from the bytes two and three positions before them.
+
+    See "Validating UTF-8 In Less Than One Instruction Per
+    Byte", John Keiser and Daniel Lemire, 2021.
+*/
+inline
+std::uint8_t const*
+utf8_tables() noexcept
+{
+    // bit 0   lead byte or ASCII followed by a lead byte
+    // bit 1   ASCII followed by a continuation
+    // bit 2   overlong three byte sequence
+    // bit 3   above U+10FFFF
+    // bit 4   surrogate
+    // bit 5   overlong two byte sequence
+    // bit 6   overlong four byte sequence, or above U+10FFFF
+    // bit 7   two continuations
+    static std::uint8_t constexpr tab[48] = {
+        // high nibble of the first byte
+        0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02,
+        0x80, 0x80, 0x80, 0x80, 0x21, 0x01, 0x15, 0x49,
+        // low nibble of the first byte
+        0xe7, 0xa3, 0x83, 0x83, 0x8b, 0xcb, 0xcb, 0xcb,
+        0xcb, 0xcb, 0xcb, 0xcb, 0xcb, 0xdb, 0xcb, 0xcb,
+        // high nibble of the second byte
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0xe6, 0xae, 0xba, 0xba, 0x01, 0x01, 0x01, 0x01 };
+    return tab;
+}
+
+#endif
+
+#if ! BOOST_BEAST_NO_INTRINSICS
+
+BOOST_BEAST_TARGET("ssse3")
+bool
+validate_utf8_ssse3(
+    std::uint8_t const* in,
+    std::size_t size) noexcept
+{
+    auto const tab = utf8_tables();
+    __m128i const hi1 = _mm_loadu_si128(
+        reinterpret_cast<__m128i const*>(tab));
+    __m128i const lo1 = _mm_loadu_si128(
+        reinterpret_cast<__m128i const*>(tab + 16));
+    __m128i const hi2 = _mm_loadu_si128(
+        reinterpret_cast<__m128i const*>(tab + 32));
+    __m128i const nibble = _mm_set1_epi8(0x0f);
+    // A block may not end inside a code point
+    __m128i const max_last = _mm_setr_epi8(
+        -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, '\xef', '\xdf', '\xbf');
+
+    __m128i err = _mm_setzero_si128();
+    __m128i prev = _mm_setzero_si128();
+    __m128i incomplete = _mm_setzero_si128();
+    std::uint8_t buf[16];
+    for(;;)
+    {
+        // The input is followed by a block of padding, which
+        // catches a code point cut off by the end of input.
+        __m128i v;
+        bool const more = size >= 16;
+        if(more)
+        {
+            v = _mm_loadu_si128(
+                reinterpret_cast<__m128i const*>(in));
+            in += 16;
+            size -= 16;
+        }
+        else
+        {
+            std::memset(buf, 0, sizeof(buf));
+            std::memcpy(buf, in, size);
+            v = _mm_loadu_si128(
+                reinterpret_cast<__m128i const*>(buf));
+        }
+        if(_mm_movemask_epi8(v) == 0)
+        {
+            // ASCII
+            err = _mm_or_si128(err, incomplete);
+        }
+        else
+        {
+            __m128i const prev1 = _mm_alignr_epi8(v, prev, 15);
+            __m128i const sc = _mm_and_si128(
+                _mm_and_si128(
+                    _mm_shuffle_epi8(hi1, _mm_and_si128(
+                        _mm_srli_epi16(prev1, 4), nibble)),
+                    _mm_shuffle_epi8(lo1, _mm_and_si128(
+                        prev1, nibble))),
+                _mm_shuffle_epi8(hi2, _mm_and_si128(
+                    _mm_srli_epi16(v, 4), nibble)));
+            __m128i const must23 = _mm_or_si128(
+                _mm_subs_epu8(_mm_alignr_epi8(v, prev, 14),
+                    _mm_set1_epi8(0x60)),
+                _mm_subs_epu8(_mm_alignr_epi8(v, prev, 13),
+                    _mm_set1_epi8(0x70)));
+            err = _mm_or_si128(err, _mm_xor_si128(sc,
+                _mm_and_si128(must23, _mm_set1_epi8('\x80'))));
+            incomplete = _mm_subs_epu8(v, max_last);
+        }
+        prev = v;
+        if(! more)
+            break;
+    }
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(
+        err, _mm_setzero_si128())) == 0xffff;
+}
+
+BOOST_BEAST_TARGET("avx2")
+bool
+validate_utf8_avx2(
+    std::uint8_t const* in,
+    std::size_t size) noexcept
+{
+    auto const tab = utf8_tables();
+    __m256i const hi1 = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128(reinterpret_cast<__m128i const*>(tab)));
+    __m256i const lo1 = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128(reinterpret_cast<__m128i const*>(tab + 16)));
+    __m256i const hi2 = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128(reinterpret_cast<__m128i const*>(tab + 32)));
+    __m256i const nibble = _mm256_set1_epi8(0x0f);
+    // A block may not end inside a code point
+    __m256i const max_last = _mm256_setr_epi8(
+        -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, '\xef', '\xdf', '\xbf');
+
+    __m256i err = _mm256_setzero_si256();
+    __m256i prev = _mm256_setzero_si256();
+    __m256i incomplete = _mm256_setzero_si256();
+    std::uint8_t buf[32];
+    for(;;)
+    {
+        // The input is followed by a block of padding, which
+        // catches a code point cut off by the end of input.
+        __m256i v;
+        bool const more = size >= 32;
+        if(more)
+        {
+            v = _mm256_loadu_si256(
+                reinterpret_cast<__m256i const*>(in));
+            in += 32;
+            size -= 32;
+        }
+        else
+        {
+            std::memset(buf, 0, sizeof(buf));
+            std::memcpy(buf, in, size);
+            v = _mm256_loadu_si256(
+                reinterpret_cast<__m256i const*>(buf));
+        }
+        if(_mm256_movemask_epi8(v) == 0)
+        {
+            // ASCII
+            err = _mm256_or_si256(err, incomplete);
+        }
+        else
+        {
+            // the previous block's upper lane and our lower lane,
+            // so that alignr can shift bytes in across the lanes
+            __m256i const p = _mm256_permute2x128_si256(prev, v, 0x21);
+            __m256i const prev1 = _mm256_alignr_epi8(v, p, 15);
+            __m256i const sc = _mm256_and_si256(
+                _mm256_and_si256(
+                    _mm256_shuffle_epi8(hi1, _mm256_and_si256(
+                        _mm256_srli_epi16(prev1, 4), nibble)),
+                    _mm256_shuffle_epi8(lo1, _mm256_and_si256(
+                        prev1, nibble))),
+                _mm256_shuffle_epi8(hi2, _mm256_and_si256(
+                    _mm256_srli_epi16(v, 4), nibble)));
+            __m256i const must23 = _mm256_or_si256(
+                _mm256_subs_epu8(_mm256_alignr_epi8(v, p, 14),
+                    _mm256_set1_epi8(0x60)),
+                _mm256_subs_epu8(_mm256_alignr_epi8(v, p, 13),
+                    _mm256_set1_epi8(0x70)));
+            err = _mm256_or_si256(err, _mm256_xor_si256(sc,
+                _mm256_and_si256(must23, _mm256_set1_epi8('\x80'))));
+            incomplete = _mm256_subs_epu8(v, max_last);
+        }
+        prev = v;
+        if(! more)
+            break;
+    }
+    return _mm256_testz_si256(err, err) != 0;
+}
+
+#endif
+
+#if BOOST_BEAST_NEON
+
+bool
+validate_utf8_neon(
+    std::uint8_t const* in,
+    std::size_t size) noexcept
+{
+    auto const tab = utf8_tables();
+    uint8x16_t const hi1 = vld1q_u8(tab);
+    uint8x16_t const lo1 = vld1q_u8(tab + 16);
+    uint8x16_t const hi2 = vld1q_u8(tab + 32);
+    uint8x16_t const nibble = vdupq_n_u8(0x0f);
+    // A block may not end inside a code point
+    static std::uint8_t constexpr last[16] = {
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xef, 0xdf, 0xbf };
+    uint8x16_t const max_last = vld1q_u8(last);
+
+    uint8x16_t err = vdupq_n_u8(0);
+    uint8x16_t prev = vdupq_n_u8(0);
+    uint8x16_t incomplete = vdupq_n_u8(0);
+    std::uint8_t buf[16];
+    for(;;)
+    {
+        // The input is followed by a block of padding, which
+        // catches a code point cut off by the end of input.
+        uint8x16_t v;
+        bool const more = size >= 16;
+        if(more)
+        {
+            v = vld1q_u8(in);
+            in += 16;
+            size -= 16;
+        }
+        else
+        {
+            std::memset(buf, 0, sizeof(buf));
+            std::memcpy(buf, in, size);
+            v = vld1q_u8(buf);
+        }
+        if(vmaxvq_u8(v) < 0x80)
+        {
+            // ASCII
+            err = vorrq_u8(err, incomplete);
+        }
+        else
+        {
+            uint8x16_t const prev1 = vextq_u8(prev, v, 15);
+            uint8x16_t const sc = vandq_u8(
+                vandq_u8(
+                    vqtbl1q_u8(hi1, vshrq_n_u8(prev1, 4)),
+                    vqtbl1q_u8(lo1, vandq_u8(prev1, nibble))),
+                vqtbl1q_u8(hi2, vshrq_n_u8(v, 4)));
+            uint8x16_t const must23 = vorrq_u8(
+                vqsubq_u8(vextq_u8(prev, v, 14), vdupq_n_u8(0x60)),
+                vqsubq_u8(vextq_u8(prev, v, 13), vdupq_n_u8(0x70)));
+            err = vorrq_u8(err, veorq_u8(sc,
+                vandq_u8(must23, vdupq_n_u8(0x80))));
+            incomplete = vqsubq_u8(v, max_last);
+        }
+        prev = v;
+        if(! more)
+            break;
+    }
+    return vmaxvq_u8(err) == 0;
+}
+
+#endif
+
+bool
+validate_utf8(
+    std::uint8_t const* in,
+    std::size_t size) noexcept
+{
+    // Short runs are not worth setting up the tables
+    if(size < 16)
+        return validate_utf8_scalar(in, size);
+#if BOOST_BEAST_NEON
+    return validate_utf8_neon(in, size);
+#else
+#if ! BOOST_BEAST_NO_INTRINSICS
+    auto const& ci = beast::detail::get_cpu_info();
+    if(ci.avx2)
+        return validate_utf8_avx2(in, size);
+    if(ci.ssse3)
+        return validate_utf8_ssse3(in, size);
+#endif
+    return validate_utf8_scalar(in, size);
+#endif
+}
+
 void
 utf8_checker::
 reset()
@@ -40,49 +460,6 @@ bool
 utf8_checker::
 write(std::uint8_t const* in, std::size_t size)
 {
-    auto const valid =
-        [](std::uint8_t const*& p)
-        {
-            if(p[0] < 128)
-            {
-                ++p;
-                return true;
-            }
-            if((p[0] & 0xe0) == 0xc0)
-            {
-                if( (p[1] & 0xc0) != 0x80 ||
-                    (p[0] & 0x1e) == 0)  // overlong
-                    return false;
-                p += 2;
-                return true;
-            }
-            if((p[0] & 0xf0) == 0xe0)
-            {
-                if(    (p[1] & 0xc0) != 0x80
-                    || (p[2] & 0xc0) != 0x80
-                    || (p[0] == 0xe0 && (p[1] & 0x20) == 0) // overlong
-                    || (p[0] == 0xed && (p[1] & 0x20) == 0x20) // surrogate
-                    //|| (p[0] == 0xef && p[1] == 0xbf && (p[2] & 0xfe) == 0xbe) // U+FFFE or U+FFFF
-                    )
-                    return false;
-                p += 3;
-                return true;
-            }
-            if((p[0] & 0xf8) == 0xf0)
-            {
-                if(    (p[0] & 0x07) >= 0x05 // invalid F5...FF characters
-                    || (p[1] & 0xc0) != 0x80
-                    || (p[2] & 0xc0) != 0x80
-                    || (p[3] & 0xc0) != 0x80
-                    || (p[0] == 0xf0 && (p[1] & 0x30) == 0) // overlong
-                    || (p[0] == 0xf4 && p[1] > 0x8f) || p[0] > 0xf4 // > U+10FFFF
-                    )
-                    return false;
-                p += 4;
-                return true;
-            }
-            return false;
-        };
     auto const fail_fast =
         [&]()
         {
@@ -155,21 +532,6 @@ write(std::uint8_t const* in, std::size_t size)
             }
             return true;
         };
-    auto const needed =
-        [](std::uint8_t const v)
-        {
-            if(v < 128)
-                return 1;
-            if(v < 192)
-                return 0;
-            if(v < 224)
-                return 2;
-            if(v < 240)
-                return 3;
-            if(v < 248)
-                return 4;
-            return 0;
-        };
 
     auto const end = in + size;
 
@@ -200,116 +562,39 @@ write(std::uint8_t const* in, std::size_t size)
 
         // Complete code point, validate it
         std::uint8_t const* p = &cp_[0];
-        if(! valid(p))
+        if(! utf8_valid(p))
             return false;
         p_ = cp_;
     }
 
-    if(size <= sizeof(std::size_t))
-        goto slow;
-
-    // Align `in` to sizeof(std::size_t) boundary
-    {
-        auto const in0 = in;
-        auto last = reinterpret_cast<std::uint8_t const*>(
-            ((reinterpret_cast<std::uintptr_t>(in) + sizeof(std::size_t) - 1) /
-                sizeof(std::size_t)) * sizeof(std::size_t));
-
-        // Check one character at a time for low-ASCII
-        while(in < last)
-        {
-            if(*in & 0x80)
-            {
-                // Not low-ASCII so switch to slow loop
-                size = size - (in - in0);
-                goto slow;
-            }
-            ++in;
-        }
-        size = size - (in - in0);
-    }
-
-    // Fast loop: Process 4 or 8 low-ASCII characters at a time
+    // Check everything up to the last code
+    // point in one go, unless it is cut off
+    // by the end of the input.
     {
-        auto const in0 = in;
-        auto last = in + size - 7;
-        auto constexpr mask = static_cast<
-            std::size_t>(0x8080808080808080 & ~std::size_t{0});
-        while(in < last)
-        {
-#if 0
-            std::size_t temp;
-            std::memcpy(&temp, in, sizeof(temp));
-            if((temp & mask) != 0)
-#else
-            // Technically UB but works on all known platforms
-            if((*reinterpret_cast<std::size_t const*>(in) & mask) != 0)
-#endif
-            {
-                size = size - (in - in0);
-                goto slow;
-            }
-            in += sizeof(std::size_t);
-        }
-        // There's at least one more full code point left
-        last += 4;
-        while(in < last)
-            if(! valid(in))
-                return false;
-        goto tail;
-    }
-
-slow:
-    // Slow loop: Full validation on one code point at a time
-    {
-        auto last = in + size - 3;
-        while(in < last)
-            if(! valid(in))
-                return false;
+        auto const last = utf8_split(in, end);
+        if(! validate_utf8(in, last - in))
+            return false;
+        in = last;
     }
 
-tail:
-    // Handle the remaining bytes. The last
-    // characters could split a code point so
-    // we save the partial code point for later.
-    //
-    // On entry to the loop, `in` points to the
-    // beginning of a code point.
-    //
-    for(;;)
+    // Save the partial code point for later.
+    auto n = end - in;
+    if(n > 0)
     {
-        // Number of chars left
-        auto n = end - in;
-        if(! n)
-            break;
+        // Calculate how many chars we need
+        // to finish this partial code point
+        auto const need = utf8_size(*in);
+        BOOST_ASSERT(need > n);
+        need_ = need - n;
 
-        // Chars we need to finish this code point
-        auto const need = needed(*in);
-        if(need == 0)
-            return false;
-        if(need <= n)
-        {
-            // Check a whole code point
-            if(! valid(in))
-                return false;
-        }
-        else
-        {
-            // Calculate how many chars we need
-            // to finish this partial code point
-            need_ = need - n;
-
-            // Save the partial code point
-            while(n--)
-                *p_++ = *in++;
-            BOOST_ASSERT(in == end);
-            BOOST_ASSERT(p_ <= cp_ + 4);
+        while(n--)
+            *p_++ = *in++;
+        BOOST_ASSERT(p_ <= cp_ + 4);
 
-            // Do partial validation on the incomplete
-            // code point, this is called "Fail fast"
-            // in Autobahn|Testsuite parlance.
-            return ! fail_fast();
-        }
+        // Do partial validation on the incomplete
+        // code point, this is called "Fail fast"
+        // in Autobahn|Testsuite parlance.
+        return ! fail_fast();
     }
     return true;
 }
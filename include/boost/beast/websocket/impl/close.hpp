@@ -291,7 +291,8 @@ public:
             impl.op_rd.maybe_invoke()
                 || impl.op_idle_ping.maybe_invoke()
                 || impl.op_ping.maybe_invoke()
-                || impl.op_wr.maybe_invoke();
+                || impl.op_wr.maybe_invoke()
+                || impl.op_send.maybe_invoke();
             this->complete(cont, ec);
         }
     }
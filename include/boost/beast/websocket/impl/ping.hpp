@@ -125,7 +125,8 @@ public:
             impl.op_close.maybe_invoke()
                 || impl.op_idle_ping.maybe_invoke()
                 || impl.op_rd.maybe_invoke()
-                || impl.op_wr.maybe_invoke();
+                || impl.op_wr.maybe_invoke()
+                || impl.op_send.maybe_invoke();
             this->complete(cont, ec);
         }
     }
@@ -236,7 +237,8 @@ public:
             impl.op_close.maybe_invoke()
                 || impl.op_ping.maybe_invoke()
                 || impl.op_rd.maybe_invoke()
-                || impl.op_wr.maybe_invoke();
+                || impl.op_wr.maybe_invoke()
+                || impl.op_send.maybe_invoke();
         }
     }
 };
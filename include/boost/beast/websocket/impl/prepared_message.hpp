@@ -0,0 +1,82 @@
+//
+// Copyright (c) 2016-2019 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/beast
+//
+
+#ifndef BOOST_BEAST_WEBSOCKET_IMPL_PREPARED_MESSAGE_HPP
+#define BOOST_BEAST_WEBSOCKET_IMPL_PREPARED_MESSAGE_HPP
+
+#include <boost/beast/core/buffer_traits.hpp>
+#include <boost/asio/buffer.hpp>
+
+namespace boost {
+namespace beast {
+namespace websocket {
+
+struct prepared_message::impl
+{
+    std::string frame;      // uncompressed frame
+    std::string zframe;     // compressed frame, or empty
+    std::size_t size;       // payload size
+    int window_bits = 0;    // window used to compress
+    bool binary;
+
+    // Reserve the frame and return the payload area
+    BOOST_BEAST_DECL
+    impl(std::size_t n, bool binary_);
+
+    BOOST_BEAST_DECL
+    net::mutable_buffer
+    payload() noexcept;
+
+    BOOST_BEAST_DECL
+    void
+    append_header(std::string& s,
+        std::size_t n, bool deflated) const;
+
+    BOOST_BEAST_DECL
+    void
+    deflate(permessage_deflate const& opts);
+};
+
+template<class ConstBufferSequence>
+prepared_message::
+prepared_message(
+    ConstBufferSequence const& payload,
+    bool binary)
+{
+    static_assert(net::is_const_buffer_sequence<
+        ConstBufferSequence>::value,
+            "ConstBufferSequence type requirements not met");
+    auto p = std::make_shared<impl>(
+        buffer_bytes(payload), binary);
+    net::buffer_copy(p->payload(), payload);
+    impl_ = std::move(p);
+}
+
+template<class ConstBufferSequence>
+prepared_message::
+prepared_message(
+    ConstBufferSequence const& payload,
+    bool binary,
+    permessage_deflate const& opts)
+{
+    static_assert(net::is_const_buffer_sequence<
+        ConstBufferSequence>::value,
+            "ConstBufferSequence type requirements not met");
+    auto p = std::make_shared<impl>(
+        buffer_bytes(payload), binary);
+    net::buffer_copy(p->payload(), payload);
+    p->deflate(opts);
+    impl_ = std::move(p);
+}
+
+} // websocket
+} // beast
+} // boost
+
+#endif
@@ -0,0 +1,178 @@
+//
+// Copyright (c) 2016-2019 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/beast
+//
+
+#ifndef BOOST_BEAST_WEBSOCKET_IMPL_PREPARED_MESSAGE_IPP
+#define BOOST_BEAST_WEBSOCKET_IMPL_PREPARED_MESSAGE_IPP
+
+#include <boost/beast/websocket/prepared_message.hpp>
+#include <boost/beast/websocket/detail/deflate_probe.hpp>
+#include <boost/beast/websocket/detail/frame.hpp>
+#include <boost/beast/zlib/deflate_stream.hpp>
+#include <boost/assert.hpp>
+#include <boost/throw_exception.hpp>
+#include <cstring>
+#include <stdexcept>
+
+namespace boost {
+namespace beast {
+namespace websocket {
+
+prepared_message::
+impl::
+impl(std::size_t n, bool binary_)
+    : size(n)
+    , binary(binary_)
+{
+    append_header(frame, n, false);
+    frame.resize(frame.size() + n);
+}
+
+net::mutable_buffer
+prepared_message::
+impl::
+payload() noexcept
+{
+    return {&frame[frame.size() - size], size};
+}
+
+void
+prepared_message::
+impl::
+append_header(std::string& s,
+    std::size_t n, bool deflated) const
+{
+    detail::frame_header fh;
+    fh.op = binary ?
+        detail::opcode::binary :
+        detail::opcode::text;
+    fh.fin = true;
+    fh.mask = false;
+    fh.rsv1 = deflated;
+    fh.rsv2 = false;
+    fh.rsv3 = false;
+    fh.len = n;
+    fh.key = 0;
+    detail::fh_buffer b;
+    detail::write<flat_static_buffer_base>(b, fh);
+    s.append(static_cast<char const*>(
+        b.data().data()), b.size());
+}
+
+void
+prepared_message::
+impl::
+deflate(permessage_deflate const& opts)
+{
+    if(! opts.server_enable)
+        return;
+    if( opts.server_max_window_bits > 15 ||
+        opts.server_max_window_bits < 9)
+        BOOST_THROW_EXCEPTION(std::invalid_argument{
+            "invalid server_max_window_bits"});
+    if( opts.compLevel < 0 ||
+        opts.compLevel > 9)
+        BOOST_THROW_EXCEPTION(std::invalid_argument{
+            "invalid compLevel"});
+    if( opts.memLevel < 1 ||
+        opts.memLevel > 9)
+        BOOST_THROW_EXCEPTION(std::invalid_argument{
+            "invalid memLevel"});
+    if(size == 0 || size < opts.msg_size_threshold)
+        return;
+    if(opts.msg_probe && detail::is_incompressible(
+        net::const_buffer(frame.data() + frame.size() - size,
+            size), size))
+        return;
+
+    // Compress the payload with a fresh window, so the
+    // result does not depend on any earlier message.
+    zlib::deflate_stream zo;
+    zo.reset(
+        opts.compLevel,
+        opts.server_max_window_bits,
+        opts.memLevel,
+        zlib::Strategy::normal);
+    std::string out;
+    out.resize(zo.upper_bound(size) + 16);
+    zlib::z_params zs;
+    zs.next_in = frame.data() + frame.size() - size;
+    zs.avail_in = size;
+    zs.next_out = &out[0];
+    zs.avail_out = out.size();
+    for(;;)
+    {
+        error_code ec;
+        zo.write(zs, zlib::Flush::sync, ec);
+        BOOST_ASSERT(! ec || ec == zlib::error::need_buffers);
+        if(zs.avail_out > 6)
+            break;
+        // Make room for the rest of the flush
+        auto const n = zs.total_out;
+        out.resize(out.size() * 2);
+        zs.next_out = &out[n];
+        zs.avail_out = out.size() - n;
+    }
+    BOOST_ASSERT(zs.avail_in == 0);
+    BOOST_ASSERT(zs.total_out >= 4);
+
+    // Remove the flush marker, as the extension requires
+    auto const n = zs.total_out - 4;
+    BOOST_ASSERT(std::memcmp(
+        &out[n], "\x00\x00\xff\xff", 4) == 0);
+    if(n >= size)
+        return;
+    append_header(zframe, n, true);
+    zframe.append(out.data(), n);
+    window_bits = opts.server_max_window_bits;
+}
+
+//------------------------------------------------------------------------------
+
+bool
+prepared_message::
+binary() const noexcept
+{
+    return impl_->binary;
+}
+
+std::size_t
+prepared_message::
+size() const noexcept
+{
+    return impl_->size;
+}
+
+bool
+prepared_message::
+deflated() const noexcept
+{
+    return ! impl_->zframe.empty();
+}
+
+net::const_buffer
+prepared_message::
+frame(bool deflated) const noexcept
+{
+    auto const& s = deflated ?
+        impl_->zframe : impl_->frame;
+    return {s.data(), s.size()};
+}
+
+int
+prepared_message::
+window_bits() const noexcept
+{
+    return impl_->window_bits;
+}
+
+} // websocket
+} // beast
+} // boost
+
+#endif
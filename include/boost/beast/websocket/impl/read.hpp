@@ -182,6 +182,8 @@ public:
                         goto close;
                     }
                     BOOST_ASSERT(impl.rd_block.is_locked(this));
+                    // Wait for the frame in the inline storage
+                    impl.rd_buf.release();
                     BOOST_ASIO_CORO_YIELD
                     {
                         BOOST_ASIO_HANDLER_LOCATION((
@@ -212,12 +214,17 @@ public:
                     impl.rd_block.lock(this);
                 }
                 // Immediately apply the mask to the portion
-                // of the buffer holding payload data.
-                if(impl.rd_fh.len > 0 && impl.rd_fh.mask)
-                    detail::mask_inplace(buffers_prefix(
-                        clamp(impl.rd_fh.len),
-                            impl.rd_buf.data()),
-                                impl.rd_key);
+                // of the buffer holding payload data, and
+                // check it if this is a text message.
+                if(impl.rd_fh.len > 0 && ! impl.rd_payload(
+                    buffers_prefix(clamp(impl.rd_fh.len),
+                        impl.rd_buf.data())))
+                {
+                    // _Fail the WebSocket Connection_
+                    code_ = close_code::bad_payload;
+                    result_ = error::bad_frame_payload;
+                    goto close;
+                }
                 if(detail::is_control(impl.rd_fh.op))
                 {
                     // Clear this otherwise the next
@@ -320,7 +327,8 @@ public:
                         impl.op_close.maybe_invoke()
                             || impl.op_idle_ping.maybe_invoke()
                             || impl.op_ping.maybe_invoke()
-                            || impl.op_wr.maybe_invoke();
+                            || impl.op_wr.maybe_invoke()
+                            || impl.op_send.maybe_invoke();
                         goto acquire_read_lock;
                     }
 
@@ -419,13 +427,14 @@ public:
                 }
                 impl.rd_done = false;
             }
+            if(impl.rd_remain > impl.rd_buf.size())
+                impl.rd_buf.acquire();
             if(! impl.rd_deflated())
             {
                 if(impl.rd_remain > 0)
                 {
-                    if(impl.rd_buf.size() == 0 && impl.rd_buf.max_size() >
-                        (std::min)(clamp(impl.rd_remain),
-                            buffer_bytes(cb_)))
+                    if(impl.rd_buf.size() == 0 &&
+                        impl.rd_buffered(buffer_bytes(cb_)))
                     {
                         // Fill the read buffer first, otherwise we
                         // get fewer bytes at the cost of one I/O.
@@ -444,25 +453,26 @@ public:
                         if(impl.check_stop_now(ec))
                             goto upcall;
                         impl.reset_idle();
-                        if(impl.rd_fh.mask)
-                            detail::mask_inplace(buffers_prefix(clamp(
-                                impl.rd_remain), impl.rd_buf.data()),
-                                    impl.rd_key);
+                        if(! impl.rd_payload(buffers_prefix(clamp(
+                            impl.rd_remain), impl.rd_buf.data())))
+                        {
+                            // _Fail the WebSocket Connection_
+                            code_ = close_code::bad_payload;
+                            result_ = error::bad_frame_payload;
+                            goto close;
+                        }
                     }
                     if(impl.rd_buf.size() > 0)
                     {
-                        // Copy from the read buffer.
-                        // The mask was already applied.
+                        // Copy from the read buffer. The mask was
+                        // already applied and the text checked.
                         bytes_transferred = net::buffer_copy(cb_,
                             impl.rd_buf.data(), clamp(impl.rd_remain));
-                        auto const mb = buffers_prefix(
-                            bytes_transferred, cb_);
                         impl.rd_remain -= bytes_transferred;
                         if(impl.rd_op == detail::opcode::text)
                         {
-                            if(! impl.rd_utf8.write(mb) ||
-                                (impl.rd_remain == 0 && impl.rd_fh.fin &&
-                                    ! impl.rd_utf8.finish()))
+                            if(impl.rd_remain == 0 && impl.rd_fh.fin &&
+                                ! impl.rd_utf8.finish())
                             {
                                 // _Fail the WebSocket Connection_
                                 code_ = close_code::bad_payload;
@@ -497,19 +507,15 @@ public:
                         auto const mb = buffers_prefix(
                             bytes_transferred, cb_);
                         impl.rd_remain -= bytes_transferred;
-                        if(impl.rd_fh.mask)
-                            detail::mask_inplace(mb, impl.rd_key);
-                        if(impl.rd_op == detail::opcode::text)
-                        {
-                            if(! impl.rd_utf8.write(mb) ||
-                                (impl.rd_remain == 0 && impl.rd_fh.fin &&
+                        if(! impl.rd_payload(mb) ||
+                            (impl.rd_op == detail::opcode::text &&
+                                impl.rd_remain == 0 && impl.rd_fh.fin &&
                                     ! impl.rd_utf8.finish()))
-                            {
-                                // _Fail the WebSocket Connection_
-                                code_ = close_code::bad_payload;
-                                result_ = error::bad_frame_payload;
-                                goto close;
-                            }
+                        {
+                            // _Fail the WebSocket Connection_
+                            code_ = close_code::bad_payload;
+                            result_ = error::bad_frame_payload;
+                            goto close;
                         }
                         bytes_written_ += bytes_transferred;
                         impl.rd_size += bytes_transferred;
@@ -714,13 +720,19 @@ public:
             impl.close();
 
         upcall:
-            impl.rd_block.try_unlock(this);
+            if(impl.rd_block.try_unlock(this))
+            {
+                impl.rd_buf.release();
+                if(impl.rd_buf_update)
+                    impl.hibernate_read();
+            }
             impl.op_r_close.maybe_invoke();
             if(impl.wr_block.try_unlock(this))
                 impl.op_close.maybe_invoke()
                     || impl.op_idle_ping.maybe_invoke()
                     || impl.op_ping.maybe_invoke()
-                    || impl.op_wr.maybe_invoke();
+                    || impl.op_wr.maybe_invoke()
+                    || impl.op_send.maybe_invoke();
             this->complete(cont, ec, bytes_written_);
         }
     }
@@ -1077,6 +1089,15 @@ read_some(
     // Make sure the stream is open
     if(impl.check_stop_now(ec))
         return bytes_written;
+    struct release_guard
+    {
+        impl_type& impl;
+
+        ~release_guard()
+        {
+            impl.rd_buf.release();
+        }
+    } guard{impl};
 loop:
     // See if we need to read a frame header. This
     // condition is structured to give the decompressor
@@ -1099,6 +1120,8 @@ loop:
                 do_fail(code, result, ec);
                 return bytes_written;
             }
+            // Wait for the frame in the inline storage
+            impl.rd_buf.release();
             auto const bytes_transferred =
                 impl.stream().read_some(
                     impl.rd_buf.prepare(read_size(
@@ -1109,11 +1132,17 @@ loop:
                 return bytes_written;
         }
         // Immediately apply the mask to the portion
-        // of the buffer holding payload data.
-        if(impl.rd_fh.len > 0 && impl.rd_fh.mask)
-            detail::mask_inplace(buffers_prefix(
-                clamp(impl.rd_fh.len), impl.rd_buf.data()),
-                    impl.rd_key);
+        // of the buffer holding payload data, and
+        // check it if this is a text message.
+        if(impl.rd_fh.len > 0 && ! impl.rd_payload(
+            buffers_prefix(clamp(impl.rd_fh.len),
+                impl.rd_buf.data())))
+        {
+            // _Fail the WebSocket Connection_
+            do_fail(close_code::bad_payload,
+                error::bad_frame_payload, ec);
+            return bytes_written;
+        }
         if(detail::is_control(impl.rd_fh.op))
         {
             // Get control frame payload
@@ -1196,13 +1225,14 @@ loop:
     {
         ec = {};
     }
+    if(impl.rd_remain > impl.rd_buf.size())
+        impl.rd_buf.acquire();
     if(! impl.rd_deflated())
     {
         if(impl.rd_remain > 0)
         {
-            if(impl.rd_buf.size() == 0 && impl.rd_buf.max_size() >
-                (std::min)(clamp(impl.rd_remain),
-                    buffer_bytes(buffers)))
+            if(impl.rd_buf.size() == 0 &&
+                impl.rd_buffered(buffer_bytes(buffers)))
             {
                 // Fill the read buffer first, otherwise we
                 // get fewer bytes at the cost of one I/O.
@@ -1211,26 +1241,27 @@ loop:
                         impl.rd_buf.max_size())), ec));
                 if(impl.check_stop_now(ec))
                     return bytes_written;
-                if(impl.rd_fh.mask)
-                    detail::mask_inplace(
-                        buffers_prefix(clamp(impl.rd_remain),
-                            impl.rd_buf.data()), impl.rd_key);
+                if(! impl.rd_payload(buffers_prefix(clamp(
+                    impl.rd_remain), impl.rd_buf.data())))
+                {
+                    // _Fail the WebSocket Connection_
+                    do_fail(close_code::bad_payload,
+                        error::bad_frame_payload, ec);
+                    return bytes_written;
+                }
             }
             if(impl.rd_buf.size() > 0)
             {
-                // Copy from the read buffer.
-                // The mask was already applied.
+                // Copy from the read buffer. The mask was
+                // already applied and the text checked.
                 auto const bytes_transferred = net::buffer_copy(
                     buffers, impl.rd_buf.data(),
                         clamp(impl.rd_remain));
-                auto const mb = buffers_prefix(
-                    bytes_transferred, buffers);
                 impl.rd_remain -= bytes_transferred;
                 if(impl.rd_op == detail::opcode::text)
                 {
-                    if(! impl.rd_utf8.write(mb) ||
-                        (impl.rd_remain == 0 && impl.rd_fh.fin &&
-                            ! impl.rd_utf8.finish()))
+                    if(impl.rd_remain == 0 && impl.rd_fh.fin &&
+                        ! impl.rd_utf8.finish())
                     {
                         // _Fail the WebSocket Connection_
                         do_fail(close_code::bad_payload,
@@ -1259,19 +1290,15 @@ loop:
                 auto const mb = buffers_prefix(
                     bytes_transferred, buffers);
                 impl.rd_remain -= bytes_transferred;
-                if(impl.rd_fh.mask)
-                    detail::mask_inplace(mb, impl.rd_key);
-                if(impl.rd_op == detail::opcode::text)
-                {
-                    if(! impl.rd_utf8.write(mb) ||
-                        (impl.rd_remain == 0 && impl.rd_fh.fin &&
+                if(! impl.rd_payload(mb) ||
+                    (impl.rd_op == detail::opcode::text &&
+                        impl.rd_remain == 0 && impl.rd_fh.fin &&
                             ! impl.rd_utf8.finish()))
-                    {
-                        // _Fail the WebSocket Connection_
-                        do_fail(close_code::bad_payload,
-                            error::bad_frame_payload, ec);
-                        return bytes_written;
-                    }
+                {
+                    // _Fail the WebSocket Connection_
+                    do_fail(close_code::bad_payload,
+                        error::bad_frame_payload, ec);
+                    return bytes_written;
                 }
                 bytes_written += bytes_transferred;
                 impl.rd_size += bytes_transferred;
@@ -0,0 +1,328 @@
+//
+// Copyright (c) 2016-2019 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/beast
+//
+
+#ifndef BOOST_BEAST_WEBSOCKET_IMPL_SEND_HPP
+#define BOOST_BEAST_WEBSOCKET_IMPL_SEND_HPP
+
+#include <boost/beast/websocket/impl/stream_impl.hpp>
+#include <boost/beast/core/async_base.hpp>
+#include <boost/beast/core/buffer_traits.hpp>
+#include <boost/beast/core/stream_traits.hpp>
+#include <boost/beast/core/detail/is_invocable.hpp>
+#include <boost/asio/coroutine.hpp>
+#include <boost/asio/dispatch.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/write.hpp>
+#include <boost/assert.hpp>
+#include <boost/core/ignore_unused.hpp>
+#include <memory>
+
+namespace boost {
+namespace beast {
+namespace websocket {
+
+// sends the frames in the send queue
+template<class NextLayer, bool deflateSupported>
+class stream<NextLayer, deflateSupported>::send_op
+    : public asio::coroutine
+{
+    boost::weak_ptr<impl_type> wp_;
+    typename stream::executor_type ex_;
+
+public:
+    static constexpr int id = 6; // for soft_mutex
+
+    using executor_type = typename stream::executor_type;
+
+    executor_type
+    get_executor() const noexcept
+    {
+        return ex_;
+    }
+
+    explicit
+    send_op(boost::shared_ptr<impl_type> const& sp)
+        : wp_(sp)
+        , ex_(sp->stream().get_executor())
+    {
+        BOOST_ASSERT(! sp->wr_q_busy);
+        sp->wr_q_busy = true;
+        (*this)({}, 0);
+    }
+
+    void operator()(
+        error_code ec = {},
+        std::size_t bytes_transferred = 0)
+    {
+        boost::ignore_unused(bytes_transferred);
+        auto sp = wp_.lock();
+        if(! sp)
+            return;
+        auto& impl = *sp;
+        BOOST_ASIO_CORO_REENTER(*this)
+        {
+            // Let the caller queue more messages first
+            BOOST_ASIO_CORO_YIELD
+            {
+                BOOST_ASIO_HANDLER_LOCATION((
+                    __FILE__, __LINE__,
+                    "websocket::send"));
+
+                net::post(ex_, std::move(*this));
+            }
+            while(! impl.wr_q.empty())
+            {
+                // Acquire the write lock
+                if(! impl.wr_block.try_lock(this))
+                {
+                    BOOST_ASIO_CORO_YIELD
+                    {
+                        BOOST_ASIO_HANDLER_LOCATION((
+                            __FILE__, __LINE__,
+                            "websocket::send"));
+
+                        impl.op_send.emplace(std::move(*this));
+                    }
+                    impl.wr_block.lock(this);
+                    BOOST_ASIO_CORO_YIELD
+                    {
+                        BOOST_ASIO_HANDLER_LOCATION((
+                            __FILE__, __LINE__,
+                            "websocket::send"));
+
+                        net::post(ex_, std::move(*this));
+                    }
+                    BOOST_ASSERT(impl.wr_block.is_locked(this));
+                }
+                if(impl.check_stop_now(ec))
+                    goto upcall;
+                if(impl.wr_close)
+                {
+                    // Nothing may follow a close frame
+                    BOOST_BEAST_ASSIGN_EC(ec, net::error::operation_aborted);
+                    goto upcall;
+                }
+                if(impl.wr_cont)
+                {
+                    // Wait for the end of the message
+                    // being sent with write_some
+                    impl.wr_block.unlock(this);
+                    impl.op_close.maybe_invoke()
+                        || impl.op_idle_ping.maybe_invoke()
+                        || impl.op_ping.maybe_invoke()
+                        || impl.op_rd.maybe_invoke()
+                        || impl.op_wr.maybe_invoke();
+                    BOOST_ASIO_CORO_YIELD
+                    {
+                        BOOST_ASIO_HANDLER_LOCATION((
+                            __FILE__, __LINE__,
+                            "websocket::send"));
+
+                        impl.op_send.emplace(std::move(*this));
+                    }
+                    continue;
+                }
+
+                // Send every queued frame in one write
+                impl.wr_q.swap(impl.wr_q_out);
+                BOOST_ASIO_CORO_YIELD
+                {
+                    BOOST_ASIO_HANDLER_LOCATION((
+                        __FILE__, __LINE__,
+                        "websocket::send"));
+
+                    net::async_write(impl.stream(),
+                        net::buffer(impl.wr_q_out),
+                            std::move(*this));
+                }
+                if(impl.check_stop_now(ec))
+                    goto upcall;
+                impl.wr_q_out.clear();
+                impl.wr_block.unlock(this);
+                impl.op_close.maybe_invoke()
+                    || impl.op_idle_ping.maybe_invoke()
+                    || impl.op_ping.maybe_invoke()
+                    || impl.op_rd.maybe_invoke()
+                    || impl.op_wr.maybe_invoke();
+            }
+            impl.wr_q_busy = false;
+            impl.hibernate_write();
+            impl.op_flush.maybe_invoke();
+            return;
+
+        upcall:
+            // Discard the queue
+            impl.wr_q.clear();
+            impl.wr_q_out.clear();
+            impl.wr_q_busy = false;
+            impl.wr_q_ec = ec;
+            impl.wr_block.unlock(this);
+            impl.op_close.maybe_invoke()
+                || impl.op_idle_ping.maybe_invoke()
+                || impl.op_ping.maybe_invoke()
+                || impl.op_rd.maybe_invoke()
+                || impl.op_wr.maybe_invoke();
+            impl.op_flush.maybe_invoke();
+        }
+    }
+};
+
+//------------------------------------------------------------------------------
+
+// waits for the send queue to empty
+template<class NextLayer, bool deflateSupported>
+template<class Handler>
+class stream<NextLayer, deflateSupported>::flush_op
+    : public beast::async_base<
+        Handler, beast::executor_type<stream>>
+    , public asio::coroutine
+{
+    boost::weak_ptr<impl_type> wp_;
+
+public:
+    template<class Handler_>
+    flush_op(
+        Handler_&& h,
+        boost::shared_ptr<impl_type> const& sp)
+        : beast::async_base<Handler,
+            beast::executor_type<stream>>(
+                std::forward<Handler_>(h),
+                    sp->stream().get_executor())
+        , wp_(sp)
+    {
+        (*this)({}, false);
+    }
+
+    void operator()(
+        error_code ec = {},
+        bool cont = true)
+    {
+        auto sp = wp_.lock();
+        if(! sp)
+        {
+            BOOST_BEAST_ASSIGN_EC(ec, net::error::operation_aborted);
+            return this->complete(cont, ec);
+        }
+        auto& impl = *sp;
+        BOOST_ASIO_CORO_REENTER(*this)
+        {
+            if(impl.wr_q_busy)
+            {
+                BOOST_ASIO_CORO_YIELD
+                {
+                    BOOST_ASIO_HANDLER_LOCATION((
+                        __FILE__, __LINE__,
+                        "websocket::async_flush"));
+
+                    this->set_allowed_cancellation(net::cancellation_type::all);
+                    impl.op_flush.emplace(std::move(*this),
+                                          net::cancellation_type::all);
+                }
+                if(ec)
+                    return this->complete(cont, ec);
+                BOOST_ASIO_CORO_YIELD
+                {
+                    BOOST_ASIO_HANDLER_LOCATION((
+                        __FILE__, __LINE__,
+                        "websocket::async_flush"));
+
+                    const auto ex = this->get_immediate_executor();
+                    net::dispatch(ex, std::move(*this));
+                }
+            }
+            ec = impl.wr_q_ec;
+            impl.wr_q_ec = {};
+            this->complete(cont, ec);
+        }
+    }
+};
+
+template<class NextLayer, bool deflateSupported>
+struct stream<NextLayer, deflateSupported>::
+    run_flush_op
+{
+    boost::shared_ptr<impl_type> const& self;
+
+    using executor_type = typename stream::executor_type;
+
+    executor_type
+    get_executor() const noexcept
+    {
+        return self->stream().get_executor();
+    }
+
+    template<class FlushHandler>
+    void
+    operator()(FlushHandler&& h)
+    {
+        // If you get an error on the following line it means
+        // that your handler does not meet the documented type
+        // requirements for the handler.
+
+        static_assert(
+            beast::detail::is_invocable<FlushHandler,
+                void(error_code)>::value,
+            "FlushHandler type requirements not met");
+
+        flush_op<
+            typename std::decay<FlushHandler>::type>(
+                std::forward<FlushHandler>(h),
+                self);
+    }
+};
+
+//------------------------------------------------------------------------------
+
+template<class NextLayer, bool deflateSupported>
+template<class ConstBufferSequence>
+bool
+stream<NextLayer, deflateSupported>::
+send(ConstBufferSequence const& buffers)
+{
+    static_assert(is_async_stream<next_layer_type>::value,
+        "AsyncStream type requirements not met");
+    static_assert(net::is_const_buffer_sequence<
+        ConstBufferSequence>::value,
+            "ConstBufferSequence type requirements not met");
+    auto& impl = *impl_;
+    if( impl.status_ != status::open ||
+        impl.wr_close)
+        return false;
+    auto const n = buffer_bytes(buffers);
+    auto const used = send_queue_size();
+    if(used > 0 && (
+        n > impl.wr_q_max ||
+        used > impl.wr_q_max - n))
+        return false;
+    impl.queue_msg(buffers);
+    if(! impl.wr_q_busy)
+        send_op{impl_};
+    return true;
+}
+
+template<class NextLayer, bool deflateSupported>
+template<BOOST_BEAST_ASYNC_TPARAM1 FlushHandler>
+BOOST_BEAST_ASYNC_RESULT1(FlushHandler)
+stream<NextLayer, deflateSupported>::
+async_flush(FlushHandler&& handler)
+{
+    static_assert(is_async_stream<next_layer_type>::value,
+        "AsyncStream type requirements not met");
+    return net::async_initiate<
+        FlushHandler,
+        void(error_code)>(
+            run_flush_op{impl_},
+            handler);
+}
+
+} // websocket
+} // beast
+} // boost
+
+#endif
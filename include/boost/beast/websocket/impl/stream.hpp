@@ -195,6 +195,23 @@ set_option(timeout const& opt)
     impl_->set_option(opt);
 }
 
+template<class NextLayer, bool deflateSupported>
+void
+stream<NextLayer, deflateSupported>::
+set_option(read_buffer const& opt)
+{
+    impl_->rd_buf.set(opt.size, opt.pooled, impl_->pool());
+}
+
+template<class NextLayer, bool deflateSupported>
+void
+stream<NextLayer, deflateSupported>::
+get_option(read_buffer& opt)
+{
+    opt.size = impl_->rd_buf.size_option();
+    opt.pooled = impl_->rd_buf.pooled_option();
+}
+
 //
 
 template<class NextLayer, bool deflateSupported>
@@ -307,6 +324,30 @@ write_buffer_bytes() const
     return impl_->wr_buf_opt;
 }
 
+template<class NextLayer, bool deflateSupported>
+void
+stream<NextLayer, deflateSupported>::
+send_queue_limit(std::size_t amount)
+{
+    impl_->wr_q_max = amount;
+}
+
+template<class NextLayer, bool deflateSupported>
+std::size_t
+stream<NextLayer, deflateSupported>::
+send_queue_limit() const
+{
+    return impl_->wr_q_max;
+}
+
+template<class NextLayer, bool deflateSupported>
+std::size_t
+stream<NextLayer, deflateSupported>::
+send_queue_size() const noexcept
+{
+    return impl_->wr_q.size() + impl_->wr_q_out.size();
+}
+
 template<class NextLayer, bool deflateSupported>
 void
 stream<NextLayer, deflateSupported>::
@@ -341,6 +382,55 @@ compress() const
     return impl_->wr_compress_opt;
 }
 
+template<class NextLayer, bool deflateSupported>
+void
+stream<NextLayer, deflateSupported>::
+compress_callback(std::function<
+    int(net::const_buffer, std::size_t)> cb)
+{
+    impl_->compress_cb = std::move(cb);
+}
+
+template<class NextLayer, bool deflateSupported>
+void
+stream<NextLayer, deflateSupported>::
+compress_callback()
+{
+    impl_->compress_cb = {};
+}
+
+template<class NextLayer, bool deflateSupported>
+void
+stream<NextLayer, deflateSupported>::
+hibernate(bool value)
+{
+    auto& impl = *impl_;
+    if(value == impl.hibernate_opt)
+        return;
+    impl.hibernate_opt = value;
+    if(value && ! impl.rd_buf_update)
+        impl.rd_pooled_prev = impl.rd_buf.pooled_option();
+    impl.hibernate_read();
+    if(value)
+        impl.hibernate_write();
+}
+
+template<class NextLayer, bool deflateSupported>
+bool
+stream<NextLayer, deflateSupported>::
+hibernate() const
+{
+    return impl_->hibernate_opt;
+}
+
+template<class NextLayer, bool deflateSupported>
+std::size_t
+stream<NextLayer, deflateSupported>::
+memory_usage() const noexcept
+{
+    return sizeof(*this) + impl_->memory_usage();
+}
+
 //------------------------------------------------------------------------------
 
 // _Fail the WebSocket Connection_
@@ -16,6 +16,7 @@
 #include <boost/beast/websocket/detail/mask.hpp>
 #include <boost/beast/websocket/detail/pmd_extension.hpp>
 #include <boost/beast/websocket/detail/prng.hpp>
+#include <boost/beast/websocket/detail/read_buffer.hpp>
 #include <boost/beast/websocket/detail/service.hpp>
 #include <boost/beast/websocket/detail/soft_mutex.hpp>
 #include <boost/beast/websocket/detail/utf8_checker.hpp>
@@ -31,10 +32,12 @@
 #include <boost/beast/core/stream_traits.hpp>
 #include <boost/beast/core/detail/clamp.hpp>
 #include <boost/asio/steady_timer.hpp>
+#include <boost/asio/write.hpp>
 #include <boost/core/empty_value.hpp>
 #include <boost/enable_shared_from_this.hpp>
 #include <boost/shared_ptr.hpp>
 #include <boost/optional.hpp>
+#include <string>
 
 namespace boost {
 namespace beast {
@@ -73,6 +76,7 @@ struct stream<NextLayer, deflateSupported>::impl_type
                             timer;          // used for timeouts
     close_reason            cr;             // set from received close frame
     control_cb_type         ctrl_cb;        // control callback
+    detail::deflate_cb_type compress_cb;    // compression level callback
 
     std::size_t             rd_msg_max      /* max message size */ = 16 * 1024 * 1024;
     std::uint64_t           rd_size         /* total size of current message so far */ = 0;
@@ -81,7 +85,7 @@ struct stream<NextLayer, deflateSupported>::impl_type
     detail::prepared_key    rd_key;         // current stateful mask key
     detail::frame_buffer    rd_fb;          // to write control frames (during reads)
     detail::utf8_checker    rd_utf8;        // to validate utf8
-    static_buffer<
+    detail::read_buffer<
         +tcp_frame_size>    rd_buf;         // buffer for reads
     detail::opcode          rd_op           /* current message binary or text */ = detail::opcode::text;
     bool                    rd_cont         /* `true` if the next frame is a continuation */ = false;
@@ -95,6 +99,7 @@ struct stream<NextLayer, deflateSupported>::impl_type
     detail::soft_mutex      wr_block;       // op currently writing
     bool                    wr_close        /* did we write a close frame? */ = false;
     bool                    wr_cont         /* next write is a continuation */ = false;
+    bool                    wr_busy         /* async message write in progress */ = false;
     bool                    wr_frag         /* autofrag the current message */ = false;
     bool                    wr_frag_opt     /* autofrag option setting */ = true;
     bool                    wr_compress;    /* compress current message */
@@ -105,6 +110,14 @@ struct stream<NextLayer, deflateSupported>::impl_type
     std::size_t             wr_buf_size     /* write buffer size (current message) */ = 0;
     std::size_t             wr_buf_opt      /* write buffer size option setting */ = 4096;
     detail::fh_buffer       wr_fb;          // header buffer used for writes
+    std::string             wr_q;           // frames queued by send
+    std::string             wr_q_out;       // queued frames being written
+    std::size_t             wr_q_max        /* send queue limit */ = 1024 * 1024;
+    bool                    wr_q_busy       /* sending queued frames */ = false;
+    error_code              wr_q_ec;        // error sending queued frames
+    bool                    hibernate_opt   /* hibernate option setting */ = false;
+    bool                    rd_pooled_prev  /* read buffer pooled setting before hibernate */ = false;
+    bool                    rd_buf_update   /* hibernate changed during a read */ = false;
 
     saved_handler           op_rd;          // paused read op
     saved_handler           op_wr;          // paused write op
@@ -113,6 +126,8 @@ struct stream<NextLayer, deflateSupported>::impl_type
     saved_handler           op_close;       // paused close op
     saved_handler           op_r_rd;        // paused read op (async read)
     saved_handler           op_r_close;     // paused close op (async read)
+    saved_handler           op_send;        // paused send queue op
+    saved_handler           op_flush;       // paused flush op
 
     bool    idle_pinging = false;
     bool    secure_prng_ = true;
@@ -148,6 +163,10 @@ struct stream<NextLayer, deflateSupported>::impl_type
         op_close.reset();
         op_r_rd.reset();
         op_r_close.reset();
+        op_send.reset();
+        op_flush.reset();
+        rd_buf.shutdown();
+        this->shutdown_pmd();
     }
 
     void
@@ -172,11 +191,18 @@ struct stream<NextLayer, deflateSupported>::impl_type
         // stream exhibits undefined behavior.
         wr_block.reset();
         rd_block.reset();
+        if(rd_buf_update)
+            hibernate_read();
 
         wr_cont = false;
+        wr_busy = false;
         wr_buf_size = 0;
+        wr_q.clear();
+        wr_q_out.clear();
+        wr_q_busy = false;
+        wr_q_ec = {};
 
-        this->open_pmd(role);
+        this->open_pmd(role, this->deflate_pool());
     }
 
     void
@@ -221,14 +247,15 @@ struct stream<NextLayer, deflateSupported>::impl_type
 
     // Called just before sending
     // the first frame of each message
+    template<class ConstBufferSequence>
     void
-    begin_msg(std::size_t n_bytes)
+    begin_msg(ConstBufferSequence const& buffers)
     {
         wr_frag = wr_frag_opt;
         wr_compress =
-            this->pmd_enabled() &&
             wr_compress_opt &&
-            this->should_compress(n_bytes);
+            this->begin_deflate(buffers,
+                beast::buffer_bytes(buffers), compress_cb);
 
         // Maintain the write buffer
         if( this->pmd_enabled() ||
@@ -251,6 +278,169 @@ struct stream<NextLayer, deflateSupported>::impl_type
         //
     }
 
+    // Append a message to the send queue as a single frame
+    template<class ConstBufferSequence>
+    void
+    queue_msg(ConstBufferSequence const& buffers)
+    {
+        auto const n = beast::buffer_bytes(buffers);
+        detail::frame_header fh;
+        fh.op = wr_opcode;
+        fh.fin = true;
+        fh.rsv1 = false;
+        fh.rsv2 = false;
+        fh.rsv3 = false;
+        fh.mask = role == role_type::client;
+        fh.key = fh.mask ? this->create_mask() : 0;
+        detail::prepared_key key;
+        if(fh.mask)
+            detail::prepare_key(key, fh.key);
+        auto const pos = wr_q.size();
+        // The compressor belongs to an asynchronous write while
+        // it has a message open, so such a message goes uncompressed.
+        if( wr_compress_opt && ! wr_cont && ! wr_busy &&
+            this->begin_deflate(buffers, n, compress_cb))
+        {
+            // Compress after room for the largest header,
+            // the payload size is not known until the end.
+            std::size_t const room = 14;
+            std::size_t len = 0;
+            buffers_suffix<ConstBufferSequence> cb(buffers);
+            for(;;)
+            {
+                auto const used = pos + room + len;
+                wr_q.resize(used + n / 2 + 64);
+                net::mutable_buffer b(
+                    &wr_q[used], wr_q.size() - used);
+                std::size_t in;
+                error_code ec;
+                auto const more =
+                    this->deflate(b, cb, true, in, ec);
+                BOOST_ASSERT(! ec);
+                len += b.size();
+                if(! more)
+                    break;
+            }
+            this->do_context_takeover_write(role);
+            if(hibernate_opt)
+                this->pmd_hibernate();
+            fh.rsv1 = true;
+            fh.len = len;
+            detail::fh_buffer fb;
+            detail::write<flat_static_buffer_base>(fb, fh);
+            auto const h = fb.size();
+            net::buffer_copy(net::buffer(
+                &wr_q[pos + room - h], h), fb.data());
+            wr_q.resize(pos + room + len);
+            wr_q.erase(pos, room - h);
+            if(fh.mask)
+                detail::mask_inplace(net::buffer(
+                    &wr_q[pos + h], len), key);
+            return;
+        }
+        fh.len = n;
+        detail::fh_buffer fb;
+        detail::write<flat_static_buffer_base>(fb, fh);
+        auto const h = fb.size();
+        wr_q.resize(pos + h + n);
+        net::buffer_copy(net::buffer(&wr_q[pos], h), fb.data());
+        if(fh.mask)
+            detail::mask_copy(net::buffer(
+                &wr_q[pos + h], n), buffers, key);
+        else
+            net::buffer_copy(net::buffer(
+                &wr_q[pos + h], n), buffers);
+    }
+
+    // Called by a synchronous write before it starts a message.
+    // Frames in the send queue were compressed before the new
+    // message will be, so they must reach the wire first.
+    void
+    write_queue(error_code& ec)
+    {
+        if(wr_cont || wr_q.empty())
+            return;
+        net::write(stream(), net::buffer(wr_q), ec);
+        wr_q.clear();
+        if(ec)
+            wr_q_ec = ec;
+    }
+
+    // Switch the read buffer to the strategy chosen by the
+    // hibernate option. The storage may not change under a
+    // pending read, which applies the change as it completes.
+    void
+    hibernate_read()
+    {
+        if(rd_block.is_locked())
+        {
+            rd_buf_update = true;
+            return;
+        }
+        rd_buf_update = false;
+        rd_buf.set(rd_buf.size_option(),
+            hibernate_opt || rd_pooled_prev, this->pool());
+    }
+
+    // Called when a write completes. With the hibernate
+    // option, give back the memory used to send a message
+    // unless one is still open.
+    void
+    hibernate_write()
+    {
+        if(! hibernate_opt || wr_cont || wr_busy)
+            return;
+        wr_buf.reset();
+        this->pmd_hibernate();
+        if(! wr_q_busy)
+        {
+            std::string().swap(wr_q);
+            std::string().swap(wr_q_out);
+        }
+    }
+
+    // Approximate number of bytes held
+    std::size_t
+    memory_usage() const noexcept
+    {
+        auto const heap =
+            [](std::string const& s) -> std::size_t
+            {
+                return s.capacity() > std::string().capacity() ?
+                    s.capacity() + 1 : 0;
+            };
+        return sizeof(*this) +
+            rd_buf.storage_bytes() +
+            (wr_buf ? wr_buf_size : 0) +
+            heap(wr_q) +
+            heap(wr_q_out) +
+            this->pmd_bytes();
+    }
+
+    // Choose the frame of a prepared message to send
+    net::const_buffer
+    begin_prepared(
+        prepared_message const& m,
+        error_code& ec)
+    {
+        // Frames are unmasked, and hold a complete message
+        if(role != role_type::server || wr_cont)
+        {
+            BOOST_BEAST_ASSIGN_EC(ec,
+                net::error::operation_not_supported);
+            return {};
+        }
+        if( m.deflated() && wr_compress_opt &&
+            this->pmd_accepts(role, m.window_bits()))
+        {
+            // The peer's window now holds data which
+            // our compressor did not see, so restart it.
+            this->pmd_reset_write();
+            return m.frame(true);
+        }
+        return m.frame(false);
+    }
+
     //--------------------------------------------------------------------------
 
     template<class Decorator>
@@ -281,6 +471,27 @@ struct stream<NextLayer, deflateSupported>::impl_type
     parse_fh(detail::frame_header& fh,
         DynamicBuffer& b, error_code& ec);
 
+    // Unmask payload bytes of the current frame in place.
+    // For an uncompressed text message the bytes are also
+    // checked as utf8, in the same pass when masked.
+    // Returns `false` if the text is not valid utf8.
+    template<class MutableBufferSequence>
+    bool
+    rd_payload(MutableBufferSequence const& mb)
+    {
+        if( detail::is_control(rd_fh.op) ||
+            rd_op != detail::opcode::text ||
+            this->rd_deflated())
+        {
+            if(rd_fh.mask)
+                detail::mask_inplace(mb, rd_key);
+            return true;
+        }
+        if(rd_fh.mask)
+            return detail::unmask_utf8(mb, rd_key, rd_utf8);
+        return rd_utf8.write(mb);
+    }
+
     std::uint32_t
     create_mask()
     {
@@ -290,6 +501,21 @@ struct stream<NextLayer, deflateSupported>::impl_type
                 return key;
     }
 
+    // Returns `true` if frame payload should be received into
+    // the read buffer, rather than directly into the caller's
+    // buffer of `n` bytes. The read buffer also picks up the
+    // frames which follow, at the cost of a copy. This pays
+    // off unless the rest of a large frame fits in `n`.
+    bool
+    rd_buffered(std::size_t n) const
+    {
+        using beast::detail::clamp;
+        auto const remain = clamp(rd_remain);
+        if(remain >= n)
+            return rd_buf.max_size() > n;
+        return remain < +tcp_frame_size;
+    }
+
     template<class DynamicBuffer>
     std::size_t
     read_size_hint_db(DynamicBuffer& buffer) const
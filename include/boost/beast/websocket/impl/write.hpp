@@ -81,11 +81,12 @@ public:
         , fin_(fin)
     {
         auto& impl = *sp;
+        impl.wr_busy = true;
 
         // Set up the outgoing frame header
         if(! impl.wr_cont)
         {
-            impl.begin_msg(beast::buffer_bytes(bs));
+            impl.begin_msg(bs);
             fh_.rsv1 = impl.wr_compress;
         }
         else
@@ -185,7 +186,10 @@ operator()(
                                    net::cancellation_type::all);
             }
             if (ec)
+            {
+                impl.wr_busy = false;
                 return this->complete(cont, ec, bytes_transferred_);
+            }
 
             this->set_allowed_cancellation(net::cancellation_type::terminal);
             impl.wr_block.lock(this);
@@ -205,6 +209,18 @@ operator()(
         }
         if(impl.check_stop_now(ec))
             goto upcall;
+        if(! impl.wr_cont && ! impl.wr_q.empty())
+        {
+            // Frames in the send queue were compressed
+            // before this message, let them go first.
+            impl.wr_block.unlock(this);
+            impl.op_close.maybe_invoke()
+                || impl.op_idle_ping.maybe_invoke()
+                || impl.op_rd.maybe_invoke()
+                || impl.op_ping.maybe_invoke()
+                || impl.op_send.maybe_invoke();
+            goto do_suspend;
+        }
 
         //------------------------------------------------------------------
 
@@ -317,10 +333,8 @@ operator()(
             detail::write<flat_static_buffer_base>(
                 impl.wr_fb, fh_);
             n = clamp(remain_, impl.wr_buf_size);
-            net::buffer_copy(net::buffer(
-                impl.wr_buf.get(), n), cb_);
-            detail::mask_inplace(net::buffer(
-                impl.wr_buf.get(), n), key_);
+            detail::mask_copy(net::buffer(
+                impl.wr_buf.get(), n), cb_, key_);
             remain_ -= n;
             impl.wr_cont = ! fin_;
             // write frame header and some payload
@@ -354,10 +368,8 @@ operator()(
             {
                 cb_.consume(impl.wr_buf_size);
                 n = clamp(remain_, impl.wr_buf_size);
-                net::buffer_copy(net::buffer(
-                    impl.wr_buf.get(), n), cb_);
-                detail::mask_inplace(net::buffer(
-                    impl.wr_buf.get(), n), key_);
+                detail::mask_copy(net::buffer(
+                    impl.wr_buf.get(), n), cb_, key_);
                 remain_ -= n;
                 // write more payload
                 BOOST_ASIO_CORO_YIELD
@@ -401,10 +413,8 @@ operator()(
                 fh_.key = impl.create_mask();
                 fh_.fin = fin_ ? remain_ == 0 : false;
                 detail::prepare_key(key_, fh_.key);
-                net::buffer_copy(net::buffer(
-                    impl.wr_buf.get(), n), cb_);
-                detail::mask_inplace(net::buffer(
-                    impl.wr_buf.get(), n), key_);
+                detail::mask_copy(net::buffer(
+                    impl.wr_buf.get(), n), cb_, key_);
                 impl.wr_fb.clear();
                 detail::write<flat_static_buffer_base>(
                     impl.wr_fb, fh_);
@@ -546,11 +556,14 @@ operator()(
     //--------------------------------------------------------------------------
 
     upcall:
+        impl.wr_busy = false;
+        impl.hibernate_write();
         impl.wr_block.unlock(this);
         impl.op_close.maybe_invoke()
             || impl.op_idle_ping.maybe_invoke()
             || impl.op_rd.maybe_invoke()
-            || impl.op_ping.maybe_invoke();
+            || impl.op_ping.maybe_invoke()
+            || impl.op_send.maybe_invoke();
         this->complete(cont, ec, bytes_transferred_);
     }
 }
@@ -634,12 +647,15 @@ write_some(bool fin,
     auto& impl = *impl_;
     std::size_t bytes_transferred = 0;
     ec = {};
+    if(impl.check_stop_now(ec))
+        return bytes_transferred;
+    impl.write_queue(ec);
     if(impl.check_stop_now(ec))
         return bytes_transferred;
     detail::frame_header fh;
     if(! impl.wr_cont)
     {
-        impl.begin_msg(beast::buffer_bytes(buffers));
+        impl.begin_msg(buffers);
         fh.rsv1 = impl.wr_compress;
     }
     else
@@ -765,10 +781,9 @@ write_some(bool fin,
                 clamp(remain, impl.wr_buf_size);
             auto const b =
                 net::buffer(impl.wr_buf.get(), n);
-            net::buffer_copy(b, cb);
+            detail::mask_copy(b, cb, key);
             cb.consume(n);
             remain -= n;
-            detail::mask_inplace(b, key);
             impl.wr_cont = ! fin;
             net::write(impl.stream(),
                 buffers_cat(fh_buf.data(), b), ec);
@@ -782,10 +797,9 @@ write_some(bool fin,
                 clamp(remain, impl.wr_buf_size);
             auto const b =
                 net::buffer(impl.wr_buf.get(), n);
-            net::buffer_copy(b, cb);
+            detail::mask_copy(b, cb, key);
             cb.consume(n);
             remain -= n;
-            detail::mask_inplace(b, key);
             net::write(impl.stream(), b, ec);
             bytes_transferred += n;
             if(impl.check_stop_now(ec))
@@ -807,8 +821,7 @@ write_some(bool fin,
                 clamp(remain, impl.wr_buf_size);
             auto const b =
                 net::buffer(impl.wr_buf.get(), n);
-            net::buffer_copy(b, cb);
-            detail::mask_inplace(b, key);
+            detail::mask_copy(b, cb, key);
             fh.len = n;
             remain -= n;
             fh.fin = fin ? remain == 0 : false;
@@ -827,6 +840,10 @@ write_some(bool fin,
             cb.consume(n);
         }
     }
+    // Resume the send queue if it waits for this message
+    if(! impl.wr_cont)
+        impl.op_send.maybe_invoke();
+    impl.hibernate_write();
     return bytes_transferred;
 }
 
@@ -906,6 +923,226 @@ async_write(
             bs);
 }
 
+//------------------------------------------------------------------------------
+
+template<class NextLayer, bool deflateSupported>
+template<class Handler>
+class stream<NextLayer, deflateSupported>::write_prepared_op
+    : public beast::async_base<
+        Handler, beast::executor_type<stream>>
+    , public asio::coroutine
+{
+    boost::weak_ptr<impl_type> wp_;
+    prepared_message m_;
+    net::const_buffer b_;
+    std::size_t bytes_transferred_ = 0;
+
+public:
+    static constexpr int id = 2; // for soft_mutex, as write_some_op
+
+    template<class Handler_>
+    write_prepared_op(
+        Handler_&& h,
+        boost::shared_ptr<impl_type> const& sp,
+        prepared_message const& m)
+        : beast::async_base<Handler,
+            beast::executor_type<stream>>(
+                std::forward<Handler_>(h),
+                    sp->stream().get_executor())
+        , wp_(sp)
+        , m_(m)
+    {
+        sp->wr_busy = true;
+        (*this)({}, 0, false);
+    }
+
+    void operator()(
+        error_code ec = {},
+        std::size_t bytes_transferred = 0,
+        bool cont = true)
+    {
+        boost::ignore_unused(bytes_transferred);
+        auto sp = wp_.lock();
+        if(! sp)
+        {
+            BOOST_BEAST_ASSIGN_EC(ec, net::error::operation_aborted);
+            return this->complete(cont, ec, 0);
+        }
+        auto& impl = *sp;
+        BOOST_ASIO_CORO_REENTER(*this)
+        {
+            // Acquire the write lock
+            if(! impl.wr_block.try_lock(this))
+            {
+            do_suspend:
+                BOOST_ASIO_CORO_YIELD
+                {
+                    BOOST_ASIO_HANDLER_LOCATION((
+                        __FILE__, __LINE__,
+                        "websocket::async_write_prepared"));
+
+                    this->set_allowed_cancellation(net::cancellation_type::all);
+                    impl.op_wr.emplace(std::move(*this),
+                                       net::cancellation_type::all);
+                }
+                if (ec)
+                {
+                    impl.wr_busy = false;
+                    return this->complete(cont, ec, 0);
+                }
+
+                this->set_allowed_cancellation(net::cancellation_type::terminal);
+                impl.wr_block.lock(this);
+                BOOST_ASIO_CORO_YIELD
+                {
+                    BOOST_ASIO_HANDLER_LOCATION((
+                        __FILE__, __LINE__,
+                        "websocket::async_write_prepared"));
+
+                    const auto ex = this->get_immediate_executor();
+                    net::dispatch(ex, std::move(*this));
+                }
+                BOOST_ASSERT(impl.wr_block.is_locked(this));
+            }
+            if(impl.check_stop_now(ec))
+                goto upcall;
+            if(! impl.wr_cont && ! impl.wr_q.empty())
+            {
+                // Let the send queue go first
+                impl.wr_block.unlock(this);
+                impl.op_close.maybe_invoke()
+                    || impl.op_idle_ping.maybe_invoke()
+                    || impl.op_rd.maybe_invoke()
+                    || impl.op_ping.maybe_invoke()
+                    || impl.op_send.maybe_invoke();
+                goto do_suspend;
+            }
+
+            b_ = impl.begin_prepared(m_, ec);
+            if(ec)
+                goto upcall;
+
+            // send the frame
+            BOOST_ASIO_CORO_YIELD
+            {
+                BOOST_ASIO_HANDLER_LOCATION((
+                    __FILE__, __LINE__,
+                    "websocket::async_write_prepared"));
+
+                net::async_write(impl.stream(), b_,
+                    beast::detail::bind_continuation(std::move(*this)));
+            }
+            if(impl.check_stop_now(ec))
+                goto upcall;
+            bytes_transferred_ = m_.size();
+
+        upcall:
+            impl.wr_busy = false;
+            impl.hibernate_write();
+            impl.wr_block.unlock(this);
+            impl.op_close.maybe_invoke()
+                || impl.op_idle_ping.maybe_invoke()
+                || impl.op_rd.maybe_invoke()
+                || impl.op_ping.maybe_invoke()
+                || impl.op_send.maybe_invoke();
+            this->complete(cont, ec, bytes_transferred_);
+        }
+    }
+};
+
+template<class NextLayer, bool deflateSupported>
+struct stream<NextLayer, deflateSupported>::
+    run_write_prepared_op
+{
+    boost::shared_ptr<impl_type> const& self;
+
+    using executor_type = typename stream::executor_type;
+
+    executor_type
+    get_executor() const noexcept
+    {
+        return self->stream().get_executor();
+    }
+
+    template<class WriteHandler>
+    void
+    operator()(
+        WriteHandler&& h,
+        prepared_message const& m)
+    {
+        // If you get an error on the following line it means
+        // that your handler does not meet the documented type
+        // requirements for the handler.
+
+        static_assert(
+            beast::detail::is_invocable<WriteHandler,
+                void(error_code, std::size_t)>::value,
+            "WriteHandler type requirements not met");
+
+        write_prepared_op<
+            typename std::decay<WriteHandler>::type>(
+                std::forward<WriteHandler>(h),
+                self,
+                m);
+    }
+};
+
+template<class NextLayer, bool deflateSupported>
+std::size_t
+stream<NextLayer, deflateSupported>::
+write_prepared(prepared_message const& msg)
+{
+    static_assert(is_sync_stream<next_layer_type>::value,
+        "SyncStream type requirements not met");
+    error_code ec;
+    auto const bytes_transferred =
+        write_prepared(msg, ec);
+    if(ec)
+        BOOST_THROW_EXCEPTION(system_error{ec});
+    return bytes_transferred;
+}
+
+template<class NextLayer, bool deflateSupported>
+std::size_t
+stream<NextLayer, deflateSupported>::
+write_prepared(prepared_message const& msg, error_code& ec)
+{
+    static_assert(is_sync_stream<next_layer_type>::value,
+        "SyncStream type requirements not met");
+    auto& impl = *impl_;
+    ec = {};
+    if(impl.check_stop_now(ec))
+        return 0;
+    impl.write_queue(ec);
+    if(impl.check_stop_now(ec))
+        return 0;
+    auto const b = impl.begin_prepared(msg, ec);
+    if(ec)
+        return 0;
+    net::write(impl.stream(), b, ec);
+    if(impl.check_stop_now(ec))
+        return 0;
+    impl.hibernate_write();
+    return msg.size();
+}
+
+template<class NextLayer, bool deflateSupported>
+template<BOOST_BEAST_ASYNC_TPARAM2 WriteHandler>
+BOOST_BEAST_ASYNC_RESULT2(WriteHandler)
+stream<NextLayer, deflateSupported>::
+async_write_prepared(
+    prepared_message const& msg, WriteHandler&& handler)
+{
+    static_assert(is_async_stream<next_layer_type>::value,
+        "AsyncStream type requirements not met");
+    return net::async_initiate<
+        WriteHandler,
+        void(error_code, std::size_t)>(
+            run_write_prepared_op{impl_},
+            handler,
+            msg);
+}
+
 } // websocket
 } // beast
 } // boost
@@ -30,6 +30,13 @@ namespace websocket {
 
     Objects of this type are used with
     @ref beast::websocket::stream::set_option.
+
+    A stream creates its compressor and decompressor when the first
+    compressed message is sent or received. When context takeover is
+    disabled for a direction, the state for that direction is taken
+    from a pool shared by the streams of the execution context at the
+    start of each message and returned at its end, so idle streams
+    hold no compression state.
 */
 struct permessage_deflate
 {
@@ -65,6 +72,28 @@ struct permessage_deflate
 
     /// The minimum size a message should have to be compressed
     std::size_t msg_size_threshold = 0;
+
+    /** Skip compression for messages which look incompressible.
+
+        When `true`, the stream estimates the entropy of a sample of
+        the first bytes written for each message which would be
+        compressed. Messages which look like compressed or random
+        data, such as images or encrypted payloads, are sent without
+        compression. Messages smaller than 256 bytes are not examined.
+        The default is `false`.
+    */
+    bool msg_probe = false;
+
+    /** Lower the compression level while messages compress poorly.
+
+        When `true`, the stream tracks how much its recent messages
+        shrink. While they shrink by less than a fifth, messages are
+        compressed at level 1, which is much faster than the default
+        and loses little on such data. The level set in `compLevel`
+        is used again once messages shrink by 30% or more.
+        The default is `false`.
+    */
+    bool adaptive_level = false;
 };
 
 } // websocket
@@ -0,0 +1,144 @@
+//
+// Copyright (c) 2016-2019 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/beast
+//
+
+#ifndef BOOST_BEAST_WEBSOCKET_PREPARED_MESSAGE_HPP
+#define BOOST_BEAST_WEBSOCKET_PREPARED_MESSAGE_HPP
+
+#include <boost/beast/core/detail/config.hpp>
+#include <boost/beast/websocket/option.hpp>
+#include <boost/beast/websocket/stream_fwd.hpp>
+#include <boost/asio/buffer.hpp>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace boost {
+namespace beast {
+namespace websocket {
+
+/** A message framed once, to be sent on many streams.
+
+    This object holds a complete message as a single unmasked
+    frame, ready to be written by a stream in the server role.
+    When constructed with @ref permessage_deflate options which
+    enable the extension in the server role, the payload is also
+    compressed once, without reference to earlier messages, and
+    held as a second frame.
+
+    A message is sent with @ref stream::write_prepared or
+    @ref stream::async_write_prepared. The compressed frame is
+    sent when the stream negotiated permessage-deflate with a
+    window at least as large as the one used to compress the
+    payload, and compression is enabled on the stream. Otherwise
+    the uncompressed frame is sent.
+
+    Copies share the frames, so a prepared message may be copied
+    cheaply into the write queue of each stream it is sent to.
+
+    @par Example
+    @code
+    permessage_deflate pmd;
+    pmd.server_enable = true;
+    prepared_message const m(net::buffer(text), false, pmd);
+    for(auto& ws : sessions)
+        ws.async_write_prepared(m, handler);
+    @endcode
+*/
+class prepared_message
+{
+    template<class, bool>
+    friend class stream;
+
+    struct impl;
+
+    std::shared_ptr<impl const> impl_;
+
+public:
+    /// Copy constructor.
+    prepared_message(prepared_message const&) = default;
+
+    /// Copy assignment.
+    prepared_message& operator=(prepared_message const&) = default;
+
+    /** Constructor.
+
+        The payload is copied into an uncompressed frame.
+
+        @param payload The buffers containing the message.
+
+        @param binary `true` for a binary message,
+        `false` for a text message.
+    */
+    template<class ConstBufferSequence>
+    explicit
+    prepared_message(
+        ConstBufferSequence const& payload,
+        bool binary = false);
+
+    /** Constructor.
+
+        The payload is copied into an uncompressed frame. If
+        `opts.server_enable` is `true` and the payload is not
+        smaller than `opts.msg_size_threshold`, the payload is
+        also compressed using the compression level, memory
+        level, and server window bits in `opts`. The compressed
+        frame is kept only when it is smaller than the
+        uncompressed frame. When `opts.msg_probe` is `true`,
+        payloads which look incompressible are not compressed.
+
+        @param payload The buffers containing the message.
+
+        @param binary `true` for a binary message,
+        `false` for a text message.
+
+        @param opts The permessage-deflate settings to compress with.
+
+        @throws std::invalid_argument if the settings are invalid.
+    */
+    template<class ConstBufferSequence>
+    prepared_message(
+        ConstBufferSequence const& payload,
+        bool binary,
+        permessage_deflate const& opts);
+
+    /// Returns `true` if this is a binary message.
+    BOOST_BEAST_DECL
+    bool
+    binary() const noexcept;
+
+    /// Returns the size of the payload.
+    BOOST_BEAST_DECL
+    std::size_t
+    size() const noexcept;
+
+    /// Returns `true` if a compressed frame was prepared.
+    BOOST_BEAST_DECL
+    bool
+    deflated() const noexcept;
+
+private:
+    BOOST_BEAST_DECL
+    net::const_buffer
+    frame(bool deflated) const noexcept;
+
+    BOOST_BEAST_DECL
+    int
+    window_bits() const noexcept;
+};
+
+} // websocket
+} // beast
+} // boost
+
+#include <boost/beast/websocket/impl/prepared_message.hpp>
+#ifdef BOOST_BEAST_HEADER_ONLY
+#include <boost/beast/websocket/impl/prepared_message.ipp>
+#endif
+
+#endif
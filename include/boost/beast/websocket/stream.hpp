@@ -13,6 +13,7 @@
 #include <boost/beast/core/detail/config.hpp>
 #include <boost/beast/websocket/error.hpp>
 #include <boost/beast/websocket/option.hpp>
+#include <boost/beast/websocket/prepared_message.hpp>
 #include <boost/beast/websocket/rfc6455.hpp>
 #include <boost/beast/websocket/stream_base.hpp>
 #include <boost/beast/websocket/stream_fwd.hpp>
@@ -413,6 +414,21 @@ public:
     void
     get_option(timeout& opt);
 
+    /** Set the read buffer option
+
+        The read buffer can be resized at any time outside of a read
+        or close operation, provided the new size is not less than the
+        number of bytes it currently holds.
+
+        @param opt The read buffer option to set.
+    */
+    void
+    set_option(read_buffer const& opt);
+
+    /// Get the read buffer option
+    void
+    get_option(read_buffer& opt);
+
     /** Set the permessage-deflate extension options
 
         @throws invalid_argument if `deflateSupported == false`, and either
@@ -638,6 +654,35 @@ public:
     std::size_t
     write_buffer_bytes() const;
 
+    /** Set the send queue limit.
+
+        Sets the number of bytes which @ref send may hold in the
+        queue of outgoing messages, including messages being written.
+        When the queue holds at least one message and a new message
+        would bring its size over the limit, @ref send refuses the
+        message so the caller can slow down.
+
+        The default setting is 1 megabyte.
+
+        @par Example
+        Setting the send queue limit.
+        @code
+            ws.send_queue_limit(65536);
+        @endcode
+
+        @param amount The limit on the size of the send queue.
+    */
+    void
+    send_queue_limit(std::size_t amount);
+
+    /// Returns the send queue limit.
+    std::size_t
+    send_queue_limit() const;
+
+    /// Returns the number of bytes held in the send queue.
+    std::size_t
+    send_queue_size() const noexcept;
+
     /** Set the text message write option.
 
         This controls whether or not outgoing message opcodes
@@ -673,6 +718,8 @@ public:
         @li Compression is enable. This is controlled with `stream::set_option`
         @li Client and server have negotiated permessage-deflate settings
         @li The message is larger than `permessage_deflate::msg_size_threshold`
+        @li The compression callback, or the built-in policy when no callback
+            is set, chooses to compress the message. See @ref compress_callback.
 
         This function permits adjusting per-message compression.
         Changing the opcode after a message is started will only take effect
@@ -698,6 +745,113 @@ public:
     bool
     compress() const;
 
+    /** Set a callback to choose how each message is compressed.
+
+        The callback is invoked before the first frame of each
+        outgoing message which is eligible for compression, as
+        described in @ref compress. It receives the first buffer
+        passed to the write function and the number of bytes in that
+        call, and returns the compression level for the message,
+        from 1 to 9, or 0 to send the message uncompressed.
+
+        When no callback is set, the stream uses a built-in policy
+        controlled by `permessage_deflate::msg_probe` and
+        `permessage_deflate::adaptive_level`.
+
+        The function object will be invoked with this equivalent
+        signature:
+        @code
+        int
+        callback(
+            net::const_buffer first,    // The first buffer of the message
+            std::size_t size            // Bytes in the first write call
+        );
+        @endcode
+
+        @par Example
+        Sending JPEG images uncompressed.
+        @code
+            ws.compress_callback(
+                [](net::const_buffer b, std::size_t)
+                {
+                    auto const p = static_cast<unsigned char const*>(b.data());
+                    if(b.size() >= 2 && p[0] == 0xff && p[1] == 0xd8)
+                        return 0;
+                    return 6;
+                });
+        @endcode
+
+        @param cb The function object to call.
+    */
+    void
+    compress_callback(
+        std::function<int(net::const_buffer, std::size_t)> cb);
+
+    /** Reset the compression callback.
+
+        This function removes any previously set compression
+        callback, restoring the built-in policy.
+    */
+    void
+    compress_callback();
+
+    /** Set the hibernate option.
+
+        When set, the stream gives back memory it only needs while a
+        message is being sent or received, so that a connection which
+        is open but idle holds as little as possible. This suits
+        programs keeping a large number of mostly idle connections.
+
+        After each write which ends a message, the write buffer is
+        freed, the compression state of outgoing messages is returned
+        to a pool shared by the streams of the same execution context,
+        and the send queue gives up its storage once it is empty. The
+        next message allocates them again. Outgoing messages which
+        follow then start with a new compression window, which the
+        receiver accepts as-is.
+
+        The read buffer is switched to pooled storage, see
+        @ref stream_base::read_buffer. Storage above the default size
+        is borrowed only while a read operation receives a payload,
+        so a read which waits for the next message holds none. When
+        the option is turned off again, the read buffer goes back to
+        the pooled setting it had before. The
+        decompression state for incoming messages is kept when the peer
+        uses context takeover, because the next message may refer to
+        the data which came before it.
+
+        The default setting is off. The option may be changed on an
+        open stream at any time. If an asynchronous read operation is
+        pending, the read buffer changes when that operation completes.
+
+        @par Example
+        Setting the hibernate option.
+        @code
+            ws.hibernate(true);
+        @endcode
+
+        @param value `true` if the stream should hibernate while idle.
+
+        @see memory_usage
+    */
+    void
+    hibernate(bool value);
+
+    /// Returns `true` if the hibernate option is set.
+    bool
+    hibernate() const;
+
+    /** Returns the approximate number of bytes held by the stream.
+
+        The figure includes the state of the stream, which holds the
+        next layer object, plus the read and write buffers, the send
+        queue, and the compression state currently in use. It does
+        not include memory allocated by the next layer itself, or by
+        callbacks and decorators installed on the stream.
+    */
+    std::size_t
+    memory_usage() const noexcept;
+
 
 
     /*
@@ -2859,6 +3013,244 @@ public:
             net::default_completion_token_t<
                 executor_type>{});
 
+    /** Write a prepared message.
+
+        This function is used to write a complete message which
+        was framed ahead of time.
+
+        The call blocks until one of the following is true:
+
+        @li The message is written.
+
+        @li An error occurs.
+
+        The algorithm, known as a <em>composed operation</em>, is implemented
+        in terms of calls to the next layer's `write_some` function.
+
+        The message is sent as a single frame, with the opcode chosen
+        when it was prepared. The @ref binary and @ref auto_fragment
+        options do not apply. The compressed frame of the message is
+        sent if permessage-deflate is in use with a large enough window
+        and the @ref compress option is set; in that case, the next
+        message compressed by this stream starts with a new window.
+
+        @param msg The message to send.
+
+        @return The size of the message payload.
+
+        @throws system_error Thrown on failure. The error is
+        `net::error::operation_not_supported` if the stream is not
+        in the server role, or if a message started by @ref write_some
+        is not finished.
+    */
+    std::size_t
+    write_prepared(prepared_message const& msg);
+
+    /** Write a prepared message.
+
+        This function is used to write a complete message which
+        was framed ahead of time.
+
+        The call blocks until one of the following is true:
+
+        @li The message is written.
+
+        @li An error occurs.
+
+        The algorithm, known as a <em>composed operation</em>, is implemented
+        in terms of calls to the next layer's `write_some` function.
+
+        The message is sent as a single frame, with the opcode chosen
+        when it was prepared. The @ref binary and @ref auto_fragment
+        options do not apply. The compressed frame of the message is
+        sent if permessage-deflate is in use with a large enough window
+        and the @ref compress option is set; in that case, the next
+        message compressed by this stream starts with a new window.
+
+        @param msg The message to send.
+
+        @param ec Set to indicate what error occurred, if any. The
+        error is `net::error::operation_not_supported` if the stream
+        is not in the server role, or if a message started by
+        @ref write_some is not finished.
+
+        @return The size of the message payload.
+    */
+    std::size_t
+    write_prepared(prepared_message const& msg, error_code& ec);
+
+    /** Write a prepared message asynchronously.
+
+        This function is used to asynchronously write a complete
+        message which was framed ahead of time.
+
+        This call always returns immediately. The asynchronous operation
+        will continue until one of the following conditions is true:
+
+        @li The message is written.
+
+        @li An error occurs.
+
+        The algorithm, known as a <em>composed asynchronous operation</em>,
+        is implemented in terms of calls to the next layer's
+        `async_write_some` function. The program must ensure that no other
+        calls to @ref write, @ref write_some, @ref async_write,
+        @ref async_write_some, or @ref async_write_prepared are performed
+        until this operation completes.
+
+        The message is sent as a single frame, with the opcode chosen
+        when it was prepared. The @ref binary and @ref auto_fragment
+        options do not apply. The compressed frame of the message is
+        sent if permessage-deflate is in use with a large enough window
+        and the @ref compress option is set; in that case, the next
+        message compressed by this stream starts with a new window.
+
+        @param msg The message to send. The implementation holds a
+        copy, which shares the frames of the message.
+
+        @param handler The completion handler to invoke when the operation
+        completes. The implementation takes ownership of the handler by
+        performing a decay-copy. The equivalent function signature of
+        the handler must be:
+        @code
+        void handler(
+            error_code const& ec,           // Result of operation
+            std::size_t bytes_transferred   // The size of the message
+                                            // payload, or zero if an
+                                            // error occurred.
+        );
+        @endcode
+        If the handler has an associated immediate executor,
+        an immediate completion will be dispatched to it.
+        Otherwise, the handler will not be invoked from within
+        this function. Invocation of the handler will be performed
+        by dispatching to the immediate executor. If no
+        immediate executor is specified, this is equivalent
+        to using `net::post`.
+
+        The error is `net::error::operation_not_supported` if the
+        stream is not in the server role, or if a message started
+        by @ref async_write_some is not finished.
+
+        @par Per-Operation Cancellation
+
+        This asynchronous operation supports cancellation for the following
+        net::cancellation_type values:
+
+        @li @c net::cancellation_type::terminal
+        @li @c net::cancellation_type::total
+
+        `total` cancellation succeeds if the operation is suspended due to ongoing
+        control operations such as a ping/pong.
+
+        `terminal` cancellation succeeds when supported by the underlying stream.
+
+        `terminal` cancellation leaves the stream in an undefined state,
+        so that only closing it is guaranteed to succeed.
+    */
+    template<
+        BOOST_BEAST_ASYNC_TPARAM2 WriteHandler =
+            net::default_completion_token_t<
+                executor_type>>
+    BOOST_BEAST_ASYNC_RESULT2(WriteHandler)
+    async_write_prepared(
+        prepared_message const& msg,
+        WriteHandler&& handler =
+            net::default_completion_token_t<
+                executor_type>{});
+
+    /** Queue a message for sending.
+
+        This function copies a complete message into the send queue
+        of the stream and returns immediately. The message is framed,
+        masked and compressed as it would be by @ref write, using the
+        current settings of @ref binary and @ref compress, and is sent
+        as a single frame.
+
+        Messages in the queue are sent in order by an operation which
+        the stream runs on its own. Whenever no other write is being
+        performed, every message queued so far is sent with a single
+        write to the next layer, so that a burst of small messages
+        costs one call instead of one call per message.
+
+        The other write functions may be used while messages are
+        queued. A message started with @ref write, @ref write_some,
+        @ref write_prepared, @ref async_write, @ref async_write_some
+        or @ref async_write_prepared is sent once the queue is empty,
+        so it follows every message queued before it. Use
+        @ref async_flush to learn when the queue is empty. Messages
+        still queued when a close frame is sent are discarded.
+
+        When a message started with @ref write_some or
+        @ref async_write_some is still open, queued messages are sent
+        after its final frame. Messages queued while that message is
+        open, or while any asynchronous write is in progress, are sent
+        uncompressed.
+
+        @param buffers The buffers containing the message to send.
+
+        @return `true` if the message was queued. `false` if the stream
+        is not open, or if the message would bring the size of a
+        non-empty queue over @ref send_queue_limit.
+    */
+    template<class ConstBufferSequence>
+    bool
+    send(ConstBufferSequence const& buffers);
+
+    /** Wait for the send queue to empty.
+
+        This function is used to asynchronously wait until every
+        message queued with @ref send is written, or until writing
+        them fails.
+
+        This call always returns immediately. The asynchronous operation
+        will continue until one of the following conditions is true:
+
+        @li The send queue is empty.
+
+        @li An error occurs while writing queued messages. The
+        remaining messages are discarded.
+
+        Only one call to `async_flush` may be outstanding at a time.
+
+        @param handler The completion handler to invoke when the operation
+        completes. The implementation takes ownership of the handler by
+        performing a decay-copy. The equivalent function signature of
+        the handler must be:
+        @code
+        void handler(
+            error_code const& ec    // Result of writing the queued messages
+        );
+        @endcode
+        If the handler has an associated immediate executor,
+        an immediate completion will be dispatched to it.
+        Otherwise, the handler will not be invoked from within
+        this function. Invocation of the handler will be performed
+        by dispatching to the immediate executor. If no
+        immediate executor is specified, this is equivalent
+        to using `net::post`.
+
+        @par Per-Operation Cancellation
+
+        This asynchronous operation supports cancellation for the following
+        net::cancellation_type values:
+
+        @li @c net::cancellation_type::terminal
+        @li @c net::cancellation_type::partial
+        @li @c net::cancellation_type::total
+
+        Cancellation stops the wait. Queued messages are still sent.
+    */
+    template<
+        BOOST_BEAST_ASYNC_TPARAM1 FlushHandler =
+            net::default_completion_token_t<executor_type>
+    >
+    BOOST_BEAST_ASYNC_RESULT1(FlushHandler)
+    async_flush(
+        FlushHandler&& handler =
+            net::default_completion_token_t<
+                executor_type>{});
+
 private:
     template<class, class>  class accept_op;
     template<class>         class close_op;
@@ -2870,6 +3262,9 @@ private:
     template<class>         class response_op;
     template<class, class>  class write_some_op;
     template<class, class>  class write_op;
+    template<class>         class write_prepared_op;
+    template<class>         class flush_op;
+                            class send_op;
 
     struct run_accept_op;
     struct run_close_op;
@@ -2881,6 +3276,8 @@ private:
     struct run_response_op;
     struct run_write_some_op;
     struct run_write_op;
+    struct run_write_prepared_op;
+    struct run_flush_op;
 
     static void default_decorate_req(request_type&) {}
     static void default_decorate_res(response_type&) {}
@@ -2964,6 +3361,7 @@ seed_prng(std::seed_seq& ss)
 #include <boost/beast/websocket/impl/handshake.hpp>
 #include <boost/beast/websocket/impl/ping.hpp>
 #include <boost/beast/websocket/impl/read.hpp>
+#include <boost/beast/websocket/impl/send.hpp>
 #include <boost/beast/websocket/impl/stream.hpp>
 #include <boost/beast/websocket/impl/write.hpp>
 
@@ -14,6 +14,7 @@
 #include <boost/beast/websocket/detail/decorator.hpp>
 #include <boost/beast/core/role.hpp>
 #include <chrono>
+#include <cstddef>
 #include <type_traits>
 
 namespace boost {
@@ -163,6 +164,51 @@ struct stream_base
         }
     };
 
+    /** Stream option to control the size and storage of the read buffer.
+
+        Received bytes are placed in the read buffer when a frame header
+        is read, and whenever the caller's buffer is smaller than the
+        read buffer. A larger read buffer receives more data with each
+        call to the next layer, which reduces the number of calls made
+        when messages are large or arrive in quick succession. Payload
+        left in a frame which fits in the caller's buffer is always
+        read into it directly, without a copy.
+
+        By default the read buffer has 1536 bytes, which are stored
+        inside the stream object.
+
+        @par Example
+        This statement gives a stream a 64 kilobyte read buffer which
+        is shared with other streams while no read is in progress:
+        @code
+            ws.set_option(stream_base::read_buffer{65536, true});
+        @endcode
+    */
+    struct read_buffer
+    {
+        /** The size of the read buffer in bytes.
+
+            Values smaller than the default use the default size.
+        */
+        std::size_t size;
+
+        /** Pooled storage setting.
+
+            When `false`, storage above the default size is allocated
+            once and held for the lifetime of the stream.
+
+            When `true`, the storage is borrowed from a pool shared by
+            the streams of the same execution context at the start of
+            each read operation. It is returned when the operation
+            completes, unless the bytes left over do not fit in the
+            default size. Idle streams then hold no extra memory.
+
+            The stream's hibernate option sets this to `true` while
+            it is on, and restores the previous setting afterwards.
+        */
+        bool pooled;
+    };
+
 protected:
     enum class status
     {
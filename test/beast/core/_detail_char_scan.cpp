@@ -0,0 +1,200 @@
+//
+// Copyright (c) 2016-2019 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/beast
+//
+
+// Test that header file is self-contained.
+#include <boost/beast/core/detail/char_scan.hpp>
+
+#include <boost/beast/_experimental/unit_test/suite.hpp>
+#include <boost/beast/core/string.hpp>
+#include <random>
+#include <string>
+
+namespace boost {
+namespace beast {
+namespace detail {
+
+class char_scan_test : public beast::unit_test::suite
+{
+public:
+    using find_fn = char const*(*)(
+        char const*, char const*, char const*, std::size_t);
+
+    static
+    char const*
+    find_ranges_ref(
+        char const* first,
+        char const* last,
+        char const* ranges,
+        std::size_t ranges_size)
+    {
+        for(; first != last; ++first)
+        {
+            auto const c = static_cast<unsigned char>(*first);
+            for(std::size_t i = 0; i < ranges_size; i += 2)
+                if( c >= static_cast<unsigned char>(ranges[i]) &&
+                    c <= static_cast<unsigned char>(ranges[i + 1]))
+                    return first;
+        }
+        return last;
+    }
+
+    void
+    check(find_fn f)
+    {
+        static char const tokens[] =
+            "\x00 \"\"(),,//:@[]{\377";
+        static char const ctls[] =
+            "\x00\x08\x0a\x1f\x7f\x7f";
+        static char const high[] =
+            "\x80\x81\xfe\xff";
+        static char const all[] =
+            "\x00\xff";
+        struct range_set
+        {
+            char const* ranges;
+            std::size_t size;
+        };
+        range_set const sets[] = {
+            { tokens, sizeof(tokens) - 1 },
+            { ctls, sizeof(ctls) - 1 },
+            { high, sizeof(high) - 1 },
+            { all, sizeof(all) - 1 },
+            { all, 0 }
+        };
+
+        std::mt19937 g;
+        for(auto const& rs : sets)
+        {
+            for(std::size_t len = 0; len < 100; ++len)
+            {
+                for(int i = 0; i < 50; ++i)
+                {
+                    std::string s(len, 'a');
+                    for(auto& c : s)
+                        c = g() % 16 == 0 ?
+                            static_cast<char>(g()) :
+                            static_cast<char>('a' + g() % 26);
+                    auto const first = s.data();
+                    auto const last = first + s.size();
+                    BEAST_EXPECT(
+                        f(first, last, rs.ranges, rs.size) ==
+                        find_ranges_ref(
+                            first, last, rs.ranges, rs.size));
+                }
+            }
+        }
+
+        // every single byte value, at every position in a block
+        for(unsigned v = 0; v < 256; ++v)
+        {
+            for(std::size_t pos = 0; pos < 40; ++pos)
+            {
+                std::string s(40, 'a');
+                s[pos] = static_cast<char>(v);
+                auto const first = s.data();
+                auto const last = first + s.size();
+                for(auto const& rs : sets)
+                    BEAST_EXPECT(
+                        f(first, last, rs.ranges, rs.size) ==
+                        find_ranges_ref(
+                            first, last, rs.ranges, rs.size));
+            }
+        }
+    }
+
+    void
+    testFindRanges()
+    {
+        check(&char_scan::find_ranges_swar);
+        check(&char_scan::find_ranges);
+#if ! BOOST_BEAST_NO_INTRINSICS
+        auto const& ci = get_cpu_info();
+        if(ci.sse42)
+            check(&char_scan::find_ranges_sse42);
+        if(ci.avx2)
+            check(&char_scan::find_ranges_avx2);
+#endif
+    }
+
+    using find_crlfcrlf_fn = char const*(*)(
+        char const*, char const*);
+
+    static
+    char const*
+    find_crlfcrlf_ref(
+        char const* first,
+        char const* last)
+    {
+        string_view const s(first, last - first);
+        auto const pos = s.find("\r\n\r\n");
+        if(pos == string_view::npos)
+            return last;
+        return first + pos;
+    }
+
+    void
+    check(find_crlfcrlf_fn f)
+    {
+        static char const alphabet[] = "\r\n\r\nab:";
+        std::mt19937 g;
+        for(std::size_t len = 0; len < 100; ++len)
+        {
+            for(int i = 0; i < 200; ++i)
+            {
+                std::string s(len, 'a');
+                for(auto& c : s)
+                    c = alphabet[g() % (sizeof(alphabet) - 1)];
+                auto const first = s.data();
+                auto const last = first + s.size();
+                BEAST_EXPECT(f(first, last) ==
+                    find_crlfcrlf_ref(first, last));
+            }
+        }
+
+        // the pattern at every position, including
+        // where it is cut off by the end of the input
+        for(std::size_t pos = 0; pos < 70; ++pos)
+        {
+            std::string s(70, 'a');
+            s.replace(pos, 4, "\r\n\r\n");
+            s.resize(70);
+            auto const first = s.data();
+            auto const last = first + s.size();
+            BEAST_EXPECT(f(first, last) ==
+                find_crlfcrlf_ref(first, last));
+        }
+    }
+
+    void
+    testFindCrlfcrlf()
+    {
+        check(&char_scan::find_crlfcrlf_swar);
+        check(&char_scan::find_crlfcrlf);
+#if ! BOOST_BEAST_NO_INTRINSICS
+        auto const& ci = get_cpu_info();
+        if(ci.sse2)
+            check(&char_scan::find_crlfcrlf_sse2);
+        if(ci.avx2)
+            check(&char_scan::find_crlfcrlf_avx2);
+#endif
+    }
+
+    void
+    run() override
+    {
+        testFindRanges();
+        testFindCrlfcrlf();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(beast,core,char_scan);
+
+} // detail
+} // beast
+} // boost
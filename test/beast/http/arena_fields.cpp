@@ -0,0 +1,499 @@
+//
+// Copyright (c) 2016-2019 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/beast
+//
+
+// Test that header file is self-contained.
+#include <boost/beast/http/arena_fields.hpp>
+
+#include <boost/beast/core/buffers_to_string.hpp>
+#include <boost/beast/http/empty_body.hpp>
+#include <boost/beast/http/fields.hpp>
+#include <boost/beast/http/message.hpp>
+#include <boost/beast/http/parser.hpp>
+#include <boost/beast/http/serializer.hpp>
+#include <boost/beast/http/string_body.hpp>
+#include <boost/beast/http/type_traits.hpp>
+#include <boost/beast/_experimental/unit_test/suite.hpp>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace boost {
+namespace beast {
+namespace http {
+
+class arena_fields_test : public beast::unit_test::suite
+{
+public:
+    BOOST_CORE_STATIC_ASSERT(is_fields<arena_fields>::value);
+    BOOST_CORE_STATIC_ASSERT(std::is_nothrow_move_constructible<arena_fields>::value);
+    BOOST_CORE_STATIC_ASSERT(std::is_nothrow_move_assignable<arena_fields>::value);
+
+    BOOST_CORE_STATIC_ASSERT(std::is_same<
+        request_parser<string_body, arena_fields>::value_type,
+        request<string_body, arena_fields>>::value);
+
+    BOOST_CORE_STATIC_ASSERT(std::is_same<
+        request_parser<string_body>::value_type,
+        request<string_body>>::value);
+
+    template<class Fields>
+    static
+    std::size_t
+    size(Fields const& f)
+    {
+        return static_cast<std::size_t>(
+            std::distance(f.begin(), f.end()));
+    }
+
+    // Returns true if both containers hold the same fields in the same order
+    template<class Fields>
+    bool
+    same(arena_fields const& a, Fields const& b)
+    {
+        if(size(a) != size(b))
+            return false;
+        auto it = b.begin();
+        for(auto const& e : a)
+        {
+            if( e.name() != it->name() ||
+                e.name_string() != it->name_string() ||
+                e.value() != it->value())
+                return false;
+            ++it;
+        }
+        return true;
+    }
+
+    struct serialize_visitor
+    {
+        std::string& s;
+
+        template<class ConstBufferSequence>
+        void
+        operator()(error_code&,
+            ConstBufferSequence const& buffers)
+        {
+            s.append(buffers_to_string(buffers));
+        }
+    };
+
+    template<bool isRequest, class Body, class Fields>
+    static
+    std::string
+    serialize(message<isRequest, Body, Fields> const& m)
+    {
+        std::string s;
+        serializer<isRequest, Body, Fields> sr{m};
+        error_code ec;
+        do
+        {
+            auto const n = s.size();
+            sr.next(ec, serialize_visitor{s});
+            if(ec)
+                break;
+            sr.consume(s.size() - n);
+        }
+        while(! sr.is_done());
+        return s;
+    }
+
+    void
+    testContainer()
+    {
+        {
+            // group fields
+            arena_fields f;
+            f.insert(field::age,   "1");
+            f.insert(field::cookie,  "2");
+            f.insert(field::from, "3");
+            f.insert(field::cookie,  "4");
+            BEAST_EXPECT(std::next(f.begin(), 0)->name() == field::age);
+            BEAST_EXPECT(std::next(f.begin(), 1)->name() == field::cookie);
+            BEAST_EXPECT(std::next(f.begin(), 2)->name() == field::cookie);
+            BEAST_EXPECT(std::next(f.begin(), 3)->name() == field::from);
+            BEAST_EXPECT(std::next(f.begin(), 0)->name_string() == "Age");
+            BEAST_EXPECT(std::next(f.begin(), 1)->value() == "2");
+            BEAST_EXPECT(std::next(f.begin(), 2)->value() == "4");
+            BEAST_EXPECT(std::next(f.begin(), 3)->value() == "3");
+            BEAST_EXPECT(f.count(field::cookie) == 2);
+            BEAST_EXPECT(f.erase(field::cookie) == 2);
+            BEAST_EXPECT(size(f) == 2);
+            BEAST_EXPECT(std::next(f.begin(), 0)->name_string() == "Age");
+            BEAST_EXPECT(std::next(f.begin(), 1)->name_string() == "From");
+        }
+        {
+            // group fields, case insensitive
+            arena_fields f;
+            f.insert("a",  "1");
+            f.insert("ab", "2");
+            f.insert("b",  "3");
+            f.insert("AB", "4");
+            BEAST_EXPECT(std::next(f.begin(), 0)->name_string() == "a");
+            BEAST_EXPECT(std::next(f.begin(), 1)->name_string() == "ab");
+            BEAST_EXPECT(std::next(f.begin(), 2)->name_string() == "AB");
+            BEAST_EXPECT(std::next(f.begin(), 3)->name_string() == "b");
+            BEAST_EXPECT(f.erase("Ab") == 2);
+            BEAST_EXPECT(std::next(f.begin(), 0)->name_string() == "a");
+            BEAST_EXPECT(std::next(f.begin(), 1)->name_string() == "b");
+        }
+        {
+            // known names are recognized however they are inserted
+            arena_fields f;
+            f.insert("content-TYPE", "text/html");
+            f.insert(field::unknown, "HOST", "example.com");
+            BEAST_EXPECT(f.begin()->name() == field::content_type);
+            BEAST_EXPECT(f[field::content_type] == "text/html");
+            BEAST_EXPECT(f[field::host] == "example.com");
+            BEAST_EXPECT(f["Host"] == "example.com");
+            BEAST_EXPECT(f.at("host") == "example.com");
+            BEAST_THROWS(f.at(field::age), std::out_of_range);
+            BEAST_THROWS(f.at("X-Missing"), std::out_of_range);
+            BEAST_EXPECT(f[field::age].empty());
+            BEAST_EXPECT(f["X-Missing"].empty());
+        }
+        {
+            // values are trimmed
+            arena_fields f;
+            f.insert(field::age, "  1\t");
+            BEAST_EXPECT(f[field::age] == "1");
+        }
+        {
+            // equal_range and set
+            arena_fields f;
+            f.insert("E", "1");
+            f.insert("B", "2");
+            f.insert("D", "3");
+            f.insert("b", "4");
+            f.insert("C", "5");
+            f.insert("B", "6");
+            auto const rng = f.equal_range("B");
+            BEAST_EXPECT(std::distance(rng.first, rng.second) == 3);
+            BEAST_EXPECT(std::next(rng.first, 0)->value() == "2");
+            BEAST_EXPECT(std::next(rng.first, 1)->value() == "4");
+            BEAST_EXPECT(std::next(rng.first, 2)->value() == "6");
+            f.set("b", "-");
+            BEAST_EXPECT(f.count("B") == 1);
+            BEAST_EXPECT(f["B"] == "-");
+            BEAST_EXPECT(std::prev(f.end())->name_string() == "b");
+        }
+        {
+            // erase by iterator
+            arena_fields f;
+            f.insert("a", "1");
+            f.insert("b", "2");
+            f.insert("c", "3");
+            auto it = f.erase(std::next(f.begin()));
+            BEAST_EXPECT(it->name_string() == "c");
+            it = f.erase(it);
+            BEAST_EXPECT(it == f.end());
+            BEAST_EXPECT(size(f) == 1);
+        }
+
+        // max field name and max field value
+        {
+            arena_fields f;
+            error_code ec;
+            auto fit_name  = std::string(arena_fields::max_name_size,      'a');
+            auto big_name  = std::string(arena_fields::max_name_size + 1,  'a');
+            auto fit_value = std::string(arena_fields::max_value_size,     'a');
+            auto big_value = std::string(arena_fields::max_value_size + 1, 'a');
+
+            f.insert(fit_name, fit_value);
+            f.set(fit_name, fit_value);
+            BEAST_EXPECT(f[fit_name] == fit_value);
+
+            f.insert(field::age, big_name, "", ec);
+            BEAST_EXPECT(ec == error::header_field_name_too_large);
+            f.insert(field::age, "", big_value, ec);
+            BEAST_EXPECT(ec == error::header_field_value_too_large);
+
+            BEAST_THROWS(f.insert(field::age, big_value),     boost::system::system_error);
+            BEAST_THROWS(f.insert(big_name, ""),              boost::system::system_error);
+            BEAST_THROWS(f.set(field::age, big_value),        boost::system::system_error);
+            BEAST_THROWS(f.set(big_name, ""),                 boost::system::system_error);
+            BEAST_EXPECT(size(f) == 1);
+        }
+    }
+
+    // Apply the same random operations to an arena_fields and
+    // a fields, checking that they always hold the same contents.
+    void
+    testRandom()
+    {
+        std::mt19937 g;
+        static char const* const names[] = {
+            "Host", "Accept", "Cookie", "X-A", "x-a", "X-Bb",
+            "Content-Length", "Via", "Set-Cookie", "X-Long-Unknown-Name" };
+        arena_fields a;
+        fields b;
+        for(int i = 0; i < 5000; ++i)
+        {
+            string_view const name = names[g() % 10];
+            auto const value = std::string(g() % 100, 'a' + g() % 26);
+            switch(g() % 8)
+            {
+            case 0:
+            case 1:
+            case 2:
+                a.insert(name, value);
+                b.insert(name, value);
+                break;
+
+            case 3:
+                a.set(name, value);
+                b.set(name, value);
+                break;
+
+            case 4:
+                BEAST_EXPECT(a.erase(name) == b.erase(name));
+                break;
+
+            case 5:
+                if(a.begin() != a.end())
+                {
+                    auto const n = g() % size(a);
+                    a.erase(std::next(a.begin(), n));
+                    b.erase(std::next(b.begin(), n));
+                }
+                break;
+
+            case 6:
+                // the value refers to the container itself
+                if(a.contains(name))
+                {
+                    a.set(name, a[name]);
+                    b.set(name, std::string(b[name]));
+                }
+                break;
+
+            case 7:
+                if(g() % 50 == 0)
+                {
+                    a.clear();
+                    b.clear();
+                }
+                break;
+            }
+            BEAST_EXPECT(a.count(name) == b.count(name));
+            BEAST_EXPECT(a[name] == b[name]);
+            if(! BEAST_EXPECT(same(a, b)))
+                break;
+        }
+
+        // copy and move
+        arena_fields c(a);
+        BEAST_EXPECT(same(c, b));
+        arena_fields d(std::move(c));
+        BEAST_EXPECT(same(d, b));
+        BEAST_EXPECT(size(c) == 0);
+        c = d;
+        BEAST_EXPECT(same(c, b));
+        d = std::move(c);
+        BEAST_EXPECT(same(d, b));
+        arena_fields e;
+        e.insert("a", "b");
+        swap(d, e);
+        BEAST_EXPECT(same(e, b));
+        BEAST_EXPECT(size(d) == 1);
+    }
+
+    void
+    testReserve()
+    {
+        arena_fields f;
+        f.reserve(4, 64);
+        f.insert(field::host, "example.com");
+        auto const p = f.begin();
+        f.insert(field::accept, "*/*");
+        f.insert(field::user_agent, "test");
+        BEAST_EXPECT(f.begin() == p);
+        f.reserve(100, 4096);
+        BEAST_EXPECT(size(f) == 3);
+        BEAST_EXPECT(f[field::user_agent] == "test");
+    }
+
+    void
+    testMessage()
+    {
+        auto const check =
+            [&](request<empty_body, arena_fields>& a, request<empty_body>& b)
+            {
+                a.prepare_payload();
+                b.prepare_payload();
+                BEAST_EXPECT(serialize(a) == serialize(b));
+            };
+
+        request<empty_body, arena_fields> a;
+        request<empty_body> b;
+        a.method(verb::get);
+        b.method(verb::get);
+        a.target("/index.html");
+        b.target("/index.html");
+        a.set(field::host, "example.com");
+        b.set(field::host, "example.com");
+        a.insert("X-Custom", "1");
+        b.insert("X-Custom", "1");
+        BEAST_EXPECT(a.method_string() == "GET");
+        BEAST_EXPECT(a.target() == "/index.html");
+        check(a, b);
+
+        a.method_string("PURGE2");
+        b.method_string("PURGE2");
+        BEAST_EXPECT(a.method_string() == "PURGE2");
+        a.keep_alive(false);
+        b.keep_alive(false);
+        BEAST_EXPECT(! a.keep_alive());
+        a.chunked(true);
+        b.chunked(true);
+        BEAST_EXPECT(a.chunked());
+        a.target(a.target().substr(1));
+        b.target(b.target().substr(1));
+        check(a, b);
+
+        a.content_length(10);
+        b.content_length(10);
+        BEAST_EXPECT(! a.chunked());
+        BEAST_EXPECT(a.has_content_length());
+        a.version(10);
+        b.version(10);
+        a.keep_alive(true);
+        b.keep_alive(true);
+        BEAST_EXPECT(serialize(a) == serialize(b));
+
+        response<empty_body, arena_fields> ra;
+        response<empty_body> rb;
+        ra.result(status::not_found);
+        rb.result(status::not_found);
+        ra.set(field::server, "test");
+        rb.set(field::server, "test");
+        BEAST_EXPECT(serialize(ra) == serialize(rb));
+        ra.reason("Gone Fishing");
+        rb.reason("Gone Fishing");
+        BEAST_EXPECT(ra.reason() == "Gone Fishing");
+        BEAST_EXPECT(serialize(ra) == serialize(rb));
+    }
+
+    void
+    testWriter()
+    {
+        // A header built in order is a single buffer
+        arena_fields f;
+        f.insert(field::host, "example.com");
+        f.insert(field::accept, "*/*");
+        f.insert(field::user_agent, "test");
+        {
+            arena_fields::writer w(f);
+            auto const b = w.get();
+            std::size_t n = 0;
+            for(auto it = net::buffer_sequence_begin(b);
+                it != net::buffer_sequence_end(b); ++it)
+                if(net::const_buffer(*it).size() > 0)
+                    ++n;
+            BEAST_EXPECT(n == 2);
+            BEAST_EXPECT(buffers_to_string(b) ==
+                "Host: example.com\r\n"
+                "Accept: */*\r\n"
+                "User-Agent: test\r\n"
+                "\r\n");
+        }
+
+        // A field inserted out of order is its own buffer
+        f.insert(field::host, "example.org");
+        {
+            arena_fields::writer w(f);
+            auto const b = w.get();
+            std::vector<std::string> v;
+            for(auto it = net::buffer_sequence_begin(b);
+                it != net::buffer_sequence_end(b); ++it)
+                if(net::const_buffer(*it).size() > 0)
+                    v.emplace_back(buffers_to_string(
+                        net::const_buffer(*it)));
+            BEAST_EXPECT(v.size() == 4);
+            BEAST_EXPECT(buffers_to_string(b) ==
+                "Host: example.com\r\n"
+                "Host: example.org\r\n"
+                "Accept: */*\r\n"
+                "User-Agent: test\r\n"
+                "\r\n");
+
+            // iterate backwards
+            std::string s;
+            auto it = net::buffer_sequence_end(b);
+            while(it != net::buffer_sequence_begin(b))
+                s.insert(0, buffers_to_string(
+                    net::const_buffer(*--it)));
+            BEAST_EXPECT(s == buffers_to_string(b));
+        }
+    }
+
+    void
+    testParser()
+    {
+        string_view const s =
+            "POST /upload HTTP/1.1\r\n"
+            "Host: example.com\r\n"
+            "User-Agent: test\r\n"
+            "X-Trace: 1\r\n"
+            "X-Trace: 2\r\n"
+            "Content-Length: 5\r\n"
+            "\r\n"
+            "hello";
+
+        request_parser<string_body, arena_fields> p;
+        p.eager(true);
+        error_code ec;
+        auto const n = p.put(net::buffer(s.data(), s.size()), ec);
+        BEAST_EXPECTS(! ec, ec.message());
+        BEAST_EXPECT(n == s.size());
+        BEAST_EXPECT(p.is_done());
+        auto const& m = p.get();
+        BEAST_EXPECT(m.method() == verb::post);
+        BEAST_EXPECT(m.target() == "/upload");
+        BEAST_EXPECT(m[field::host] == "example.com");
+        BEAST_EXPECT(m.count("x-trace") == 2);
+        BEAST_EXPECT(m.body() == "hello");
+        BEAST_EXPECT(serialize(m) == s);
+
+        // moving to a parser with another body keeps the fields
+        response_parser<empty_body, arena_fields> p0;
+        string_view const s0 =
+            "HTTP/1.1 200 OK\r\n"
+            "Server: test\r\n"
+            "Content-Length: 3\r\n"
+            "\r\n"
+            "abc";
+        auto const header_size = s0.size() - 3;
+        p0.put(net::buffer(s0.data(), header_size), ec);
+        BEAST_EXPECTS(! ec, ec.message());
+        BEAST_EXPECT(p0.is_header_done());
+        response_parser<string_body, arena_fields> p1(std::move(p0));
+        p1.put(net::buffer(s0.data() + header_size, 3), ec);
+        BEAST_EXPECTS(! ec, ec.message());
+        BEAST_EXPECT(p1.get()[field::server] == "test");
+        BEAST_EXPECT(p1.get().body() == "abc");
+    }
+
+    void
+    run() override
+    {
+        testContainer();
+        testRandom();
+        testReserve();
+        testMessage();
+        testWriter();
+        testParser();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(beast,http,arena_fields);
+
+} // http
+} // beast
+} // boost
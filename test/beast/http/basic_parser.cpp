@@ -24,6 +24,9 @@
 #include <boost/beast/http/string_body.hpp>
 #include <boost/beast/test/fuzz.hpp>
 #include <boost/beast/_experimental/unit_test/suite.hpp>
+#include <array>
+#include <string>
+#include <vector>
 
 namespace boost {
 namespace beast {
@@ -359,6 +362,57 @@ public:
         check("x\r\n y\r\n z ",         "x y z");
     }
 
+    void
+    testLongFields()
+    {
+        using P = request_parser<string_body>;
+
+        // Long enough to be scanned in vector-sized blocks
+        std::string const name(70, 'n');
+        std::string value;
+        for(int i = 0; i < 300; ++i)
+            value.push_back(static_cast<char>(' ' + 1 + i % 94));
+        std::string const target = "/" + value.substr(0, 100);
+        std::string const m =
+            "GET " + target + " HTTP/1.1\r\n"
+            "Cookie: " + value + "\r\n" +
+            name + ": " + value + "\r\n"
+            "\r\n";
+        parsegrind<P>(m,
+            [&](P const& p)
+            {
+                BEAST_EXPECT(p.get().target() == target);
+                BEAST_EXPECT(p.get()[field::cookie] == value);
+                BEAST_EXPECT(p.get()[name] == value);
+            });
+
+        // Trickle the header in one octet at a time
+        {
+            P p;
+            error_code ec;
+            std::size_t used = 0;
+            for(std::size_t i = 1; i <= m.size(); ++i)
+            {
+                used += p.put(net::const_buffer(
+                    m.data() + used, i - used), ec);
+                if(ec != error::need_more)
+                    break;
+            }
+            BEAST_EXPECTS(! ec, ec.message());
+            BEAST_EXPECT(used == m.size());
+            BEAST_EXPECT(p.is_done());
+            BEAST_EXPECT(p.get()[name] == value);
+        }
+
+        // Invalid octets found past the first block
+        failgrind<P>("GET / HTTP/1.1\r\n" + name + "@: x\r\n\r\n",
+            error::bad_field);
+        failgrind<P>("GET / HTTP/1.1\r\nf: " + value + "\x01\r\n\r\n",
+            error::bad_value);
+        failgrind<P>("GET " + target + "\x01 HTTP/1.1\r\n\r\n",
+            error::bad_target);
+    }
+
     // Check that all callbacks are invoked
     void
     testCallbacks()
@@ -1746,6 +1800,120 @@ public:
         BEAST_EXPECT(ec == error::body_limit);
     }
 
+    void
+    testScatter()
+    {
+        // Large buffer sequences are parsed in place, in
+        // any number of pieces, with the same results.
+        std::string const pad(8200, '*');
+        std::string const m =
+            "HTTP/1.1 200 OK\r\n"
+            "Server: test\r\n"
+            "Transfer-Encoding: chunked\r\n"
+            "Trailer: Digest\r\n"
+            "\r\n"
+            "2008;x=y\r\n" + pad + "\r\n"
+            "3\r\n***\r\n"
+            "0\r\nDigest: abc\r\n"
+            "\r\n";
+        std::vector<std::size_t> splits;
+        for(std::size_t i = 0; i < 110; ++i)
+            splits.push_back(i);
+        for(std::size_t i = m.size() - 40; i <= m.size(); ++i)
+            splits.push_back(i);
+        for(auto i : splits)
+        {
+            for(auto j : splits)
+            {
+                if(j < i)
+                    continue;
+                std::array<net::const_buffer, 3> const b{{
+                    net::const_buffer(m.data(), i),
+                    net::const_buffer(m.data() + i, j - i),
+                    net::const_buffer(m.data() + j, m.size() - j)}};
+                test_parser<false> p;
+                p.eager(true);
+                error_code ec;
+                auto const n = p.put(b, ec);
+                if(! BEAST_EXPECTS(! ec, ec.message()))
+                    continue;
+                BEAST_EXPECT(n == m.size());
+                BEAST_EXPECT(p.is_done());
+                BEAST_EXPECT(p.body.size() == pad.size() + 3);
+                BEAST_EXPECT(p.fields["Server"] == "test");
+                BEAST_EXPECT(p.got_on_chunk == 3);
+                BEAST_EXPECT(p.got_on_trailer_field == 1);
+                BEAST_EXPECT(p.buf_len_ == 0);
+            }
+        }
+
+        std::string fields;
+        for(int i = 0; i < 400; ++i)
+            fields += "X-Field-" + std::to_string(i) + ": some value\r\n";
+
+        // Without the eager option, parsing stops after the header
+        {
+            std::string const s =
+                "POST / HTTP/1.1\r\n" + fields +
+                "Content-Length: 5\r\n"
+                "\r\n"
+                "*****";
+            std::array<net::const_buffer, 3> const b{{
+                net::const_buffer(s.data(), 20),
+                net::const_buffer(s.data() + 20, 5000),
+                net::const_buffer(s.data() + 5020, s.size() - 5020)}};
+            test_parser<true> p;
+            p.header_limit(65536);
+            error_code ec;
+            auto n = p.put(b, ec);
+            BEAST_EXPECTS(! ec, ec.message());
+            BEAST_EXPECT(p.is_header_done());
+            BEAST_EXPECT(n == s.size() - 5);
+            BEAST_EXPECT(p.got_on_field == 401);
+            buffers_suffix<std::array<net::const_buffer, 3>> cb(b);
+            cb.consume(n);
+            n = p.put(cb, ec);
+            BEAST_EXPECTS(! ec, ec.message());
+            BEAST_EXPECT(n == 5);
+            BEAST_EXPECT(p.is_done());
+            BEAST_EXPECT(p.body == "*****");
+            BEAST_EXPECT(p.buf_len_ == 0);
+        }
+
+        // An incomplete element at the end needs more input
+        {
+            std::string const s =
+                "GET / HTTP/1.1\r\n" + fields +
+                "Host: exam";
+            std::array<net::const_buffer, 2> const b{{
+                net::const_buffer(s.data(), 10),
+                net::const_buffer(s.data() + 10, s.size() - 10)}};
+            test_parser<true> p;
+            p.header_limit(65536);
+            p.eager(true);
+            error_code ec;
+            auto const n = p.put(b, ec);
+            BEAST_EXPECTS(ec == error::need_more, ec.message());
+            BEAST_EXPECT(n == s.size() - 10);
+            BEAST_EXPECT(p.path == "/");
+            BEAST_EXPECT(p.got_on_field == 400);
+        }
+
+        // The header limit is enforced across pieces
+        {
+            std::string const s =
+                "GET / HTTP/1.1\r\n" + fields + "\r\n";
+            std::array<net::const_buffer, 2> const b{{
+                net::const_buffer(s.data(), 100),
+                net::const_buffer(s.data() + 100, s.size() - 100)}};
+            test_parser<true> p;
+            p.eager(true);
+            error_code ec;
+            p.put(b, ec);
+            BEAST_EXPECTS(ec == error::header_limit, ec.message());
+        }
+    }
+
     //--------------------------------------------------------------------------
 
     void
@@ -1753,6 +1921,7 @@ public:
     {
         testFlatten();
         testObsFold();
+        testLongFields();
         testCallbacks();
         testRequestLine();
         testStatusLine();
@@ -1777,6 +1946,7 @@ public:
         testChunkExtensions();
         testUnlimitedBody();
         testIssue2201();
+        testScatter();
     }
 };
 
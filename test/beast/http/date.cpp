@@ -0,0 +1,95 @@
+//
+// Copyright (c) 2016-2019 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/beast
+//
+
+// Test that header file is self-contained.
+#include <boost/beast/http/date.hpp>
+
+#include <boost/beast/http/detail/date_service.hpp>
+#include <boost/beast/_experimental/unit_test/suite.hpp>
+#include <boost/asio/io_context.hpp>
+#include <string>
+
+namespace boost {
+namespace beast {
+namespace http {
+
+class date_test : public beast::unit_test::suite
+{
+public:
+    static
+    std::string
+    format(std::time_t t)
+    {
+        char buf[29];
+        detail::format_date(buf, t);
+        return std::string(buf, sizeof(buf));
+    }
+
+    void
+    testFormat()
+    {
+        BEAST_EXPECT(format(0) == "Thu, 01 Jan 1970 00:00:00 GMT");
+        BEAST_EXPECT(format(784111777) == "Sun, 06 Nov 1994 08:49:37 GMT");
+        BEAST_EXPECT(format(951782400) == "Tue, 29 Feb 2000 00:00:00 GMT");
+        BEAST_EXPECT(format(1709251199) == "Thu, 29 Feb 2024 23:59:59 GMT");
+        BEAST_EXPECT(format(1735689600) == "Wed, 01 Jan 2025 00:00:00 GMT");
+        BEAST_EXPECT(format(-1) == "Wed, 31 Dec 1969 23:59:59 GMT");
+    }
+
+    void
+    testService()
+    {
+        net::io_context ioc;
+        auto& svc = net::use_service<detail::date_service>(ioc);
+
+        // the string is shared within a second
+        auto const s1 = svc.get(784111777);
+        BEAST_EXPECT(s1 == "Sun, 06 Nov 1994 08:49:37 GMT");
+        BEAST_EXPECT(svc.get(784111777).data() == s1.data());
+
+        // and survives the next second
+        auto const s2 = svc.get(784111778);
+        BEAST_EXPECT(s2 == "Sun, 06 Nov 1994 08:49:38 GMT");
+        BEAST_EXPECT(s2.data() != s1.data());
+        BEAST_EXPECT(s1 == "Sun, 06 Nov 1994 08:49:37 GMT");
+
+        // an earlier time does not go back
+        BEAST_EXPECT(svc.get(784111777) == s2);
+
+        BEAST_EXPECT(svc.get(784111779).data() == s1.data());
+    }
+
+    void
+    testCurrentDate()
+    {
+        net::io_context ioc1;
+        net::io_context ioc2;
+        auto const s1 = current_date(ioc1);
+        auto const s2 = current_date(ioc2);
+        BEAST_EXPECT(s1.size() == 29);
+        BEAST_EXPECT(s1.substr(25) == " GMT");
+        BEAST_EXPECT(s1.data() != s2.data());
+        auto const s3 = current_date(ioc1);
+        BEAST_EXPECT(s3.size() == 29);
+    }
+
+    void
+    run() override
+    {
+        testFormat();
+        testService();
+        testCurrentDate();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(beast,http,date);
+
+} // http
+} // beast
+} // boost
@@ -11,6 +11,8 @@
 #include <boost/beast/http/field.hpp>
 
 #include <boost/beast/_experimental/unit_test/suite.hpp>
+#include <cctype>
+#include <string>
 
 namespace boost {
 namespace beast {
@@ -170,11 +172,48 @@ public:
             };
         unknown("");
         unknown("x");
+        unknown("TEx");
+        unknown("X-Custom-Header");
+        unknown("Content-Lengt");
+        unknown("Content-Lengthh");
+        unknown("Content_Length");
+        unknown("ontent-Length");
+    }
+
+    void
+    testAllFields()
+    {
+        // Every known field is found in any letter case,
+        // and a name that differs in one character is not
+        for(unsigned i = 1;; ++i)
+        {
+            auto const f = static_cast<field>(i);
+            auto const s = to_string(f);
+            std::string name(s.data(), s.size());
+            BEAST_EXPECT(string_to_field(name) == f);
+            for(auto& c : name)
+                c = static_cast<char>(std::tolower(
+                    static_cast<unsigned char>(c)));
+            BEAST_EXPECT(string_to_field(name) == f);
+            for(auto& c : name)
+                c = static_cast<char>(std::toupper(
+                    static_cast<unsigned char>(c)));
+            BEAST_EXPECT(string_to_field(name) == f);
+            for(std::size_t j = 0; j < name.size(); ++j)
+            {
+                auto other = name;
+                other[j] = '~';
+                BEAST_EXPECT(string_to_field(other) == field::unknown);
+            }
+            if(f == field::x_xss_protection)
+                break;
+        }
     }
 
     void run() override
     {
         testField();
+        testAllFields();
         pass();
     }
 };
@@ -10,6 +10,7 @@
 // Test that header file is self-contained.
 #include <boost/beast/http/fields.hpp>
 
+#include <boost/beast/core/buffers_to_string.hpp>
 #include <boost/beast/core/static_string.hpp>
 #include <boost/beast/http/empty_body.hpp>
 #include <boost/beast/http/message.hpp>
@@ -1174,6 +1175,159 @@ public:
         BEAST_EXPECT(itr->value().empty());
     }
 
+    template<class ConstBufferSequence>
+    static
+    std::size_t
+    buffer_count(ConstBufferSequence const& buffers)
+    {
+        std::size_t n = 0;
+        for(auto it = net::buffer_sequence_begin(buffers);
+                it != net::buffer_sequence_end(buffers); ++it)
+            if(net::const_buffer(*it).size() > 0)
+                ++n;
+        return n;
+    }
+
+    template<class ConstBufferSequence>
+    static
+    void const*
+    buffer_data(ConstBufferSequence const& buffers)
+    {
+        return net::const_buffer(
+            *net::buffer_sequence_begin(buffers)).data();
+    }
+
+    void
+    testContiguousHeader()
+    {
+        response<empty_body> res{status::ok, 11};
+        res.set(field::server, "test");
+        res.set(field::content_type, "text/plain");
+        res.set(field::cache_control, "no-cache");
+        std::string const s =
+            "HTTP/1.1 200 OK\r\n"
+            "Server: test\r\n"
+            "Content-Type: text/plain\r\n"
+            "Cache-Control: no-cache\r\n"
+            "\r\n";
+        {
+            fields::writer w(res, 11, 200);
+            BEAST_EXPECT(buffers_to_string(w.get()) == s);
+            BEAST_EXPECT(buffer_count(w.get()) > 1);
+        }
+
+        BEAST_EXPECT(! res.contiguous_header());
+        res.contiguous_header(true);
+        BEAST_EXPECT(res.contiguous_header());
+        void const* p;
+        {
+            fields::writer w(res, 11, 200);
+            BEAST_EXPECT(buffers_to_string(w.get()) == s);
+            BEAST_EXPECT(buffer_count(w.get()) == 1);
+            p = buffer_data(w.get());
+        }
+        {
+            // unchanged, so the rendering is reused
+            fields::writer w(res, 11, 200);
+            BEAST_EXPECT(buffer_data(w.get()) == p);
+            BEAST_EXPECT(buffers_to_string(w.get()) == s);
+        }
+        {
+            res.set(field::server, "x");
+            fields::writer w(res, 11, 200);
+            BEAST_EXPECT(buffers_to_string(w.get()) ==
+                "HTTP/1.1 200 OK\r\n"
+                "Content-Type: text/plain\r\n"
+                "Cache-Control: no-cache\r\n"
+                "Server: x\r\n"
+                "\r\n");
+        }
+        {
+            res.erase(field::content_type);
+            res.erase(field::cache_control);
+            fields::writer w(res, 10, 404);
+            BEAST_EXPECT(buffers_to_string(w.get()) ==
+                "HTTP/1.0 404 Not Found\r\n"
+                "Server: x\r\n"
+                "\r\n");
+        }
+        {
+            res.reason("Gone Fishing");
+            fields::writer w(res, 10, 404);
+            BEAST_EXPECT(buffers_to_string(w.get()) ==
+                "HTTP/1.0 404 Gone Fishing\r\n"
+                "Server: x\r\n"
+                "\r\n");
+        }
+        {
+            res.clear();
+            fields::writer w(res, 10, 404);
+            BEAST_EXPECT(buffers_to_string(w.get()) ==
+                "HTTP/1.0 404 Gone Fishing\r\n"
+                "\r\n");
+        }
+
+        request<empty_body> req{verb::get, "/", 11};
+        req.set(field::host, "example.com");
+        req.contiguous_header(true);
+        {
+            fields::writer w(req, 11, verb::get);
+            BEAST_EXPECT(buffers_to_string(w.get()) ==
+                "GET / HTTP/1.1\r\n"
+                "Host: example.com\r\n"
+                "\r\n");
+        }
+        {
+            req.target("/a/b");
+            fields::writer w(req, 11, verb::get);
+            BEAST_EXPECT(buffers_to_string(w.get()) ==
+                "GET /a/b HTTP/1.1\r\n"
+                "Host: example.com\r\n"
+                "\r\n");
+        }
+        {
+            fields::writer w(req, 11, verb::post);
+            BEAST_EXPECT(buffers_to_string(w.get()) ==
+                "POST /a/b HTTP/1.1\r\n"
+                "Host: example.com\r\n"
+                "\r\n");
+        }
+        {
+            req.method_string("BREW");
+            fields::writer w(req, 11, verb::unknown);
+            BEAST_EXPECT(buffers_to_string(w.get()) ==
+                "BREW /a/b HTTP/1.1\r\n"
+                "Host: example.com\r\n"
+                "\r\n");
+        }
+
+        // copies and moves keep the option
+        {
+            fields f(req);
+            BEAST_EXPECT(f.contiguous_header());
+            fields::writer w(f, 11, verb::unknown);
+            BEAST_EXPECT(buffer_count(w.get()) == 1);
+            fields f2(std::move(f));
+            BEAST_EXPECT(f2.contiguous_header());
+            BEAST_EXPECT(! f.contiguous_header());
+            fields::writer w2(f2, 11, verb::unknown);
+            BEAST_EXPECT(buffers_to_string(w2.get()) ==
+                "BREW /a/b HTTP/1.1\r\n"
+                "Host: example.com\r\n"
+                "\r\n");
+            f.swap(f2);
+            BEAST_EXPECT(f.contiguous_header());
+            f = f2;
+            BEAST_EXPECT(! f.contiguous_header());
+        }
+
+        req.contiguous_header(false);
+        {
+            fields::writer w(req, 11, verb::unknown);
+            BEAST_EXPECT(buffer_count(w.get()) > 1);
+        }
+    }
+
     void
     run() override
     {
@@ -1193,6 +1347,7 @@ public:
         boost::ignore_unused(&fields_test::testIssue2085);
         testIssue2517();
         testEmpty();
+        testContiguousHeader();
     }
 };
 
@@ -0,0 +1,164 @@
+//
+// Copyright (c) 2016-2019 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/beast
+//
+
+// Test that header file is self-contained.
+#include <boost/beast/http/fields_view.hpp>
+
+#include <boost/beast/http/header_view_parser.hpp>
+#include <boost/beast/_experimental/unit_test/suite.hpp>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace boost {
+namespace beast {
+namespace http {
+
+class fields_view_test : public beast::unit_test::suite
+{
+public:
+    static
+    string_view
+    header()
+    {
+        return
+            "GET / HTTP/1.1\r\n"
+            "Host: example.com\r\n"
+            "X-Trace: 1\r\n"
+            "Accept: */*\r\n"
+            "x-trace: 2\r\n"
+            "My-Field: a\r\n"
+            "Set-Cookie: x\r\n"
+            "MY-FIELD: b\r\n"
+            "Empty:\r\n"
+            "\r\n";
+    }
+
+    void
+    parse(header_view_parser<true>& p, string_view s)
+    {
+        error_code ec;
+        auto const n = p.put(net::buffer(s.data(), s.size()), ec);
+        BEAST_EXPECTS(! ec, ec.message());
+        BEAST_EXPECT(n == s.size());
+        BEAST_EXPECT(p.is_header_done());
+    }
+
+    void
+    testLookup()
+    {
+        header_view_parser<true> p;
+        parse(p, header());
+        auto const& f = p.fields();
+
+        BEAST_EXPECT(! f.empty());
+        BEAST_EXPECT(f.size() == 8);
+
+        BEAST_EXPECT(f[field::host] == "example.com");
+        BEAST_EXPECT(f["HOST"] == "example.com");
+        BEAST_EXPECT(f.at(field::accept) == "*/*");
+        BEAST_EXPECT(f.at("accept") == "*/*");
+        BEAST_EXPECT(f["empty"] == "");
+        BEAST_EXPECT(f.contains("Empty"));
+        BEAST_EXPECT(f[field::age] == "");
+        BEAST_EXPECT(f["Missing"] == "");
+        BEAST_EXPECT(! f.contains(field::age));
+        BEAST_EXPECT(! f.contains("missing"));
+        BEAST_EXPECT(f.find(field::age) == f.end());
+        BEAST_EXPECT(f.find("missing") == f.end());
+
+        try
+        {
+            f.at(field::age);
+            fail("", __FILE__, __LINE__);
+        }
+        catch(std::out_of_range const&)
+        {
+            pass();
+        }
+        try
+        {
+            f.at("missing");
+            fail("", __FILE__, __LINE__);
+        }
+        catch(std::out_of_range const&)
+        {
+            pass();
+        }
+
+        // repeated names are grouped, in the order received
+        BEAST_EXPECT(f.count("X-TRACE") == 2);
+        BEAST_EXPECT(f.count(field::set_cookie) == 1);
+        auto r = f.equal_range("my-field");
+        BEAST_EXPECT(r.second - r.first == 2);
+        BEAST_EXPECT(r.first[0].value() == "a");
+        BEAST_EXPECT(r.first[1].value() == "b");
+        BEAST_EXPECT(r.first[1].name_string() == "MY-FIELD");
+        BEAST_EXPECT(r.first[0].name() == field::unknown);
+        BEAST_EXPECT(f.find("My-field") == r.first);
+
+        std::vector<std::string> v;
+        for(auto const& e : f)
+            v.emplace_back(e.value());
+        BEAST_EXPECT((v == std::vector<std::string>{
+            "example.com", "1", "2", "*/*", "a", "b", "x", ""}));
+    }
+
+    void
+    testInPlace()
+    {
+        auto const s = header();
+        header_view_parser<true> p;
+        parse(p, s);
+        for(auto const& e : p.fields())
+        {
+            BEAST_EXPECT(e.name_string().data() >= s.data());
+            BEAST_EXPECT(e.value().data() >= s.data());
+            BEAST_EXPECT(e.value().data() + e.value().size() <=
+                s.data() + s.size());
+        }
+    }
+
+    void
+    testModifiers()
+    {
+        header_view_parser<true> p;
+        parse(p, header());
+
+        // copies refer to the same characters
+        fields_view f(p.fields());
+        BEAST_EXPECT(f.size() == p.fields().size());
+        BEAST_EXPECT(f[field::host].data() ==
+            p.fields()[field::host].data());
+
+        fields_view f2;
+        BEAST_EXPECT(f2.empty());
+        BEAST_EXPECT(f2.begin() == f2.end());
+        swap(f, f2);
+        BEAST_EXPECT(f.empty());
+        BEAST_EXPECT(f2.size() == 8);
+        f2.clear();
+        BEAST_EXPECT(f2.empty());
+        BEAST_EXPECT(f2.find("host") == f2.end());
+    }
+
+    void
+    run() override
+    {
+        testLookup();
+        testInPlace();
+        testModifiers();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(beast,http,fields_view);
+
+} // http
+} // beast
+} // boost
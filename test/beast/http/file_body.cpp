@@ -15,13 +15,20 @@
 #include <boost/beast/core/file_stdio.hpp>
 #include <boost/beast/core/flat_buffer.hpp>
 #include <boost/beast/core/static_string.hpp>
+#include <boost/beast/core/tcp_stream.hpp>
 #include <boost/beast/http/parser.hpp>
+#include <boost/beast/http/read.hpp>
 #include <boost/beast/http/serializer.hpp>
 #include <boost/beast/http/string_body.hpp>
+#include <boost/beast/http/write.hpp>
 #include <boost/beast/_experimental/unit_test/suite.hpp>
 #include <boost/filesystem.hpp>
 #include <boost/asio/error.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
 #include <fstream>
+#include <functional>
+#include <thread>
 
 namespace boost {
 namespace beast {
@@ -292,6 +299,184 @@ public:
         }
     }
 
+#if BOOST_BEAST_USE_POSIX_SENDFILE
+    void
+    testSendfile()
+    {
+        auto temp = temp_file(log);
+
+        // large enough that the socket buffers fill up
+        std::string data;
+        for(std::size_t i = 0; i < 4000000; ++i)
+            data.push_back(static_cast<char>('a' + i % 26));
+        {
+            std::ofstream fstemp(temp.path().string(), std::ios::binary);
+            fstemp << data;
+            BEAST_EXPECT(fstemp.good());
+        }
+
+        net::io_context ioc;
+        net::ip::tcp::acceptor a(ioc, net::ip::tcp::endpoint(
+            net::ip::make_address_v4("127.0.0.1"), 0));
+
+        auto const make_response =
+            [&](response<file_body>& res)
+            {
+                error_code ec;
+                res.version(11);
+                res.result(status::ok);
+                res.set(field::server, "test");
+                res.body().open(temp.path().string<std::string>().c_str(),
+                    file_mode::read, ec);
+                BEAST_EXPECTS(! ec, ec.message());
+                res.body().seek(5, ec); // so we start at 'f'
+                BEAST_EXPECTS(! ec, ec.message());
+                res.prepare_payload();
+            };
+
+        // synchronous, through a tcp_stream
+        {
+            tcp_stream stream(ioc);
+            net::ip::tcp::socket peer(ioc);
+            stream.connect(a.local_endpoint());
+            a.accept(peer);
+
+            response_parser<string_body> p;
+            p.body_limit(boost::none);
+            std::thread t(
+                [&]
+                {
+                    error_code ec;
+                    flat_buffer b;
+                    read(peer, b, p, ec);
+                    BEAST_EXPECTS(! ec, ec.message());
+                });
+
+            response<file_body> res;
+            make_response(res);
+            error_code ec;
+            write(stream, res, ec);
+            BEAST_EXPECTS(! ec, ec.message());
+            t.join();
+            BEAST_EXPECT(p.get()[field::server] == "test");
+            BEAST_EXPECT(p.get().body() == data.substr(5));
+        }
+
+        // asynchronous, through a socket
+        {
+            net::ip::tcp::socket sock(ioc);
+            net::ip::tcp::socket peer(ioc);
+            sock.connect(a.local_endpoint());
+            a.accept(peer);
+
+            response_parser<string_body> p;
+            p.body_limit(boost::none);
+            flat_buffer b;
+            async_read(peer, b, p,
+                [&](error_code ec, std::size_t)
+                {
+                    BEAST_EXPECTS(! ec, ec.message());
+                });
+
+            response<file_body> res;
+            make_response(res);
+            response_serializer<file_body> sr(res);
+            std::function<void(error_code, std::size_t)> on_write =
+                [&](error_code ec, std::size_t)
+                {
+                    BEAST_EXPECTS(! ec, ec.message());
+                    if(! ec && ! sr.is_done())
+                        async_write_some(sock, sr, on_write);
+                };
+            async_write_some(sock, sr, on_write);
+            ioc.run();
+            BEAST_EXPECT(sr.is_done());
+            BEAST_EXPECT(p.get()[field::server] == "test");
+            BEAST_EXPECT(p.get().body() == data.substr(5));
+        }
+
+        // async_write picks the sendfile overloads. Only
+        // the sendfile path sets the non-blocking mode of
+        // the native socket, asio leaves it unchanged.
+        auto const do_async_write =
+            [&](net::ip::tcp::socket& sock, std::function<
+                void(response<file_body>&)> write_msg)
+            {
+                net::ip::tcp::socket peer(ioc);
+                sock.connect(a.local_endpoint());
+                a.accept(peer);
+
+                response_parser<string_body> p;
+                p.body_limit(boost::none);
+                flat_buffer b;
+                async_read(peer, b, p,
+                    [&](error_code ec, std::size_t)
+                    {
+                        BEAST_EXPECTS(! ec, ec.message());
+                    });
+
+                response<file_body> res;
+                make_response(res);
+                BEAST_EXPECT(! sock.native_non_blocking());
+                write_msg(res);
+                ioc.run();
+                ioc.restart();
+                BEAST_EXPECT(sock.native_non_blocking());
+                BEAST_EXPECT(p.get()[field::server] == "test");
+                BEAST_EXPECT(p.get().body() == data.substr(5));
+            };
+
+        // asynchronous message, through a socket
+        {
+            net::ip::tcp::socket sock(ioc);
+            do_async_write(sock,
+                [&](response<file_body>& res)
+                {
+                    async_write(sock, res,
+                        [&](error_code ec, std::size_t n)
+                        {
+                            BEAST_EXPECTS(! ec, ec.message());
+                            BEAST_EXPECT(n > data.size() - 5);
+                        });
+                });
+        }
+
+        // asynchronous message, through a tcp_stream
+        {
+            tcp_stream stream(ioc);
+            do_async_write(stream.socket(),
+                [&](response<file_body>& res)
+                {
+                    async_write(stream, res,
+                        [&](error_code ec, std::size_t n)
+                        {
+                            BEAST_EXPECTS(! ec, ec.message());
+                            BEAST_EXPECT(n > data.size() - 5);
+                        });
+                });
+        }
+
+        // a small send buffer makes the writes through the
+        // tcp_stream take only part of the serializer's buffer
+        {
+            tcp_stream stream(ioc);
+            stream.socket().open(net::ip::tcp::v4());
+            stream.socket().set_option(
+                net::socket_base::send_buffer_size(1024));
+            do_async_write(stream.socket(),
+                [&](response<file_body>& res)
+                {
+                    async_write(stream, res,
+                        [&](error_code ec, std::size_t n)
+                        {
+                            BEAST_EXPECTS(! ec, ec.message());
+                            BEAST_EXPECT(n > data.size() - 5);
+                        });
+                });
+        }
+    }
+#endif
+
     void
     run() override
     {
@@ -322,6 +507,9 @@ public:
         readPartialFile<file_win32, false>();
 #endif
 
+#if BOOST_BEAST_USE_POSIX_SENDFILE
+        testSendfile();
+#endif
     }
 };
 
@@ -0,0 +1,289 @@
+//
+// Copyright (c) 2016-2019 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/beast
+//
+
+// Test that header file is self-contained.
+#include <boost/beast/http/header_view_parser.hpp>
+
+#include <boost/beast/_experimental/unit_test/suite.hpp>
+#include <array>
+#include <functional>
+#include <string>
+
+namespace boost {
+namespace beast {
+namespace http {
+
+class header_view_parser_test : public beast::unit_test::suite
+{
+public:
+    static
+    bool
+    within(string_view s, string_view in)
+    {
+        return
+            std::less_equal<char const*>{}(in.data(), s.data()) &&
+            std::less_equal<char const*>{}(
+                s.data() + s.size(), in.data() + in.size());
+    }
+
+    void
+    testRequest()
+    {
+        string_view const s =
+            "PATCH /a/b?c=d HTTP/1.0\r\n"
+            "Host: example.com\r\n"
+            "Connection: keep-alive\r\n"
+            "X-Custom:   padded  \r\n"
+            "\r\n";
+        header_view_parser<true> p;
+        error_code ec;
+        auto const n = p.put(net::buffer(s.data(), s.size()), ec);
+        BEAST_EXPECTS(! ec, ec.message());
+        BEAST_EXPECT(n == s.size());
+        BEAST_EXPECT(p.is_header_done());
+        BEAST_EXPECT(p.is_done());
+        BEAST_EXPECT(p.keep_alive());
+        BEAST_EXPECT(p.method() == verb::patch);
+        BEAST_EXPECT(p.method_string() == "PATCH");
+        BEAST_EXPECT(p.target() == "/a/b?c=d");
+        BEAST_EXPECT(p.version() == 10);
+        BEAST_EXPECT(within(p.method_string(), s));
+        BEAST_EXPECT(within(p.target(), s));
+        auto const& f = p.fields();
+        BEAST_EXPECT(f["x-custom"] == "padded");
+        for(auto const& e : f)
+        {
+            BEAST_EXPECT(within(e.name_string(), s));
+            BEAST_EXPECT(within(e.value(), s));
+        }
+
+        // unknown method
+        string_view const s2 =
+            "BREW /pot HTTP/1.1\r\n"
+            "\r\n";
+        header_view_parser<true> p2;
+        p2.put(net::buffer(s2.data(), s2.size()), ec);
+        BEAST_EXPECTS(! ec, ec.message());
+        BEAST_EXPECT(p2.method() == verb::unknown);
+        BEAST_EXPECT(p2.method_string() == "BREW");
+        BEAST_EXPECT(p2.fields().empty());
+    }
+
+    void
+    testResponse()
+    {
+        string_view const s =
+            "HTTP/1.1 404 Not Found\r\n"
+            "Server: test\r\n"
+            "Content-Length: 5\r\n"
+            "\r\n"
+            "hello";
+        header_view_parser<false> p;
+        p.eager(true);
+        error_code ec;
+        auto const n = p.put(net::buffer(s.data(), s.size()), ec);
+        BEAST_EXPECTS(! ec, ec.message());
+        BEAST_EXPECT(n == s.size());
+        BEAST_EXPECT(p.is_done());
+        BEAST_EXPECT(p.result() == status::not_found);
+        BEAST_EXPECT(p.result_int() == 404);
+        BEAST_EXPECT(p.reason() == "Not Found");
+        BEAST_EXPECT(p.version() == 11);
+        BEAST_EXPECT(within(p.reason(), s));
+        BEAST_EXPECT(p.fields()[field::server] == "test");
+        BEAST_EXPECT(p.content_length() == std::uint64_t(5));
+    }
+
+    void
+    testWholeHeader()
+    {
+        // Nothing is consumed until the header is complete,
+        // so every string refers to the final buffer.
+        string_view const s =
+            "GET / HTTP/1.1\r\n"
+            "Host: example.com\r\n"
+            "User-Agent: test\r\n"
+            "\r\n";
+        header_view_parser<true> p;
+        error_code ec;
+        for(std::size_t i = 1; i < s.size(); ++i)
+        {
+            std::string const part(s.data(), i);
+            auto const n = p.put(
+                net::buffer(part.data(), part.size()), ec);
+            BEAST_EXPECT(ec == error::need_more);
+            BEAST_EXPECT(n == 0);
+            BEAST_EXPECT(p.fields().empty());
+        }
+        std::string const all(s);
+        auto const n = p.put(net::buffer(all.data(), all.size()), ec);
+        BEAST_EXPECTS(! ec, ec.message());
+        BEAST_EXPECT(n == all.size());
+        BEAST_EXPECT(within(p.target(), all));
+        for(auto const& e : p.fields())
+        {
+            BEAST_EXPECT(within(e.name_string(), all));
+            BEAST_EXPECT(within(e.value(), all));
+        }
+        BEAST_EXPECT(p.fields()[field::user_agent] == "test");
+    }
+
+    void
+    testObsFold()
+    {
+        string_view const s =
+            "GET / HTTP/1.1\r\n"
+            "X-Fold: first\r\n"
+            "  second\r\n"
+            "X-Blank:\r\n"
+            " third\r\n"
+            "Host: example.com\r\n"
+            "\r\n";
+        header_view_parser<true> p;
+        error_code ec;
+        p.put(net::buffer(s.data(), s.size()), ec);
+        BEAST_EXPECTS(! ec, ec.message());
+        auto const& f = p.fields();
+        BEAST_EXPECT(f["x-fold"] == "first second");
+        BEAST_EXPECT(! within(f["x-fold"], s));
+        BEAST_EXPECT(f["x-blank"] == "third");
+        BEAST_EXPECT(f[field::host] == "example.com");
+        BEAST_EXPECT(within(f[field::host], s));
+    }
+
+    void
+    testBuffers()
+    {
+        // The header refers to storage owned by the parser
+        // when it is presented as more than one buffer.
+        string_view const s =
+            "GET / HTTP/1.1\r\n"
+            "Host: example.com\r\n"
+            "\r\n";
+        std::array<net::const_buffer, 2> const b{{
+            net::const_buffer(s.data(), 10),
+            net::const_buffer(s.data() + 10, s.size() - 10)}};
+        header_view_parser<true> p;
+        error_code ec;
+        auto const n = p.put(b, ec);
+        BEAST_EXPECTS(! ec, ec.message());
+        BEAST_EXPECT(n == s.size());
+        BEAST_EXPECT(p.target() == "/");
+        BEAST_EXPECT(p.fields()[field::host] == "example.com");
+    }
+
+    void
+    testLimits()
+    {
+        string_view const s =
+            "GET / HTTP/1.1\r\n"
+            "Host: example.com\r\n"
+            "User-Agent: test\r\n"
+            "\r\n";
+        {
+            header_view_parser<true> p;
+            p.header_limit(24);
+            error_code ec;
+            p.put(net::buffer(s.data(), s.size()), ec);
+            BEAST_EXPECTS(ec == error::header_limit, ec.message());
+        }
+        {
+            header_view_parser<true> p;
+            p.header_limit(static_cast<std::uint32_t>(s.size()));
+            error_code ec;
+            p.put(net::buffer(s.data(), s.size()), ec);
+            BEAST_EXPECTS(! ec, ec.message());
+        }
+        {
+            string_view const bad =
+                "GET / HTTP/1.1\r\n"
+                "Bad Field: x\r\n"
+                "\r\n";
+            header_view_parser<true> p;
+            error_code ec;
+            p.put(net::buffer(bad.data(), bad.size()), ec);
+            BEAST_EXPECTS(ec == error::bad_field, ec.message());
+        }
+    }
+
+    void
+    testBody()
+    {
+        string_view const s =
+            "HTTP/1.1 200 OK\r\n"
+            "Transfer-Encoding: chunked\r\n"
+            "Trailer: Digest\r\n"
+            "\r\n"
+            "5\r\nhello\r\n"
+            "0\r\n"
+            "Digest: x\r\n"
+            "\r\n";
+        header_view_parser<false> p;
+        p.eager(true);
+        error_code ec;
+        auto const n = p.put(net::buffer(s.data(), s.size()), ec);
+        BEAST_EXPECTS(! ec, ec.message());
+        BEAST_EXPECT(n == s.size());
+        BEAST_EXPECT(p.is_done());
+        BEAST_EXPECT(p.chunked());
+        BEAST_EXPECT(! p.fields().contains(field::digest));
+    }
+
+    void
+    testReset()
+    {
+        string_view const s =
+            "GET /a HTTP/1.1\r\n"
+            "Host: one\r\n"
+            "\r\n"
+            "GET /b HTTP/1.1\r\n"
+            "Accept: */*\r\n"
+            "\r\n";
+        header_view_parser<true> p;
+        error_code ec;
+        auto const n = p.put(net::buffer(s.data(), s.size()), ec);
+        BEAST_EXPECTS(! ec, ec.message());
+        BEAST_EXPECT(p.is_done());
+        BEAST_EXPECT(p.target() == "/a");
+        p.reset();
+        BEAST_EXPECT(! p.got_some());
+        BEAST_EXPECT(p.fields().empty());
+        BEAST_EXPECT(p.target().empty());
+        auto const rest = s.substr(n);
+        std::string const part(rest.data(), 10);
+        BEAST_EXPECT(p.put(net::buffer(
+            part.data(), part.size()), ec) == 0);
+        BEAST_EXPECT(ec == error::need_more);
+        p.put(net::buffer(rest.data(), rest.size()), ec);
+        BEAST_EXPECTS(! ec, ec.message());
+        BEAST_EXPECT(p.target() == "/b");
+        BEAST_EXPECT(within(p.target(), rest));
+        BEAST_EXPECT(! p.fields().contains(field::host));
+        BEAST_EXPECT(p.fields()[field::accept] == "*/*");
+    }
+
+    void
+    run() override
+    {
+        testRequest();
+        testResponse();
+        testWholeHeader();
+        testObsFold();
+        testBuffers();
+        testLimits();
+        testBody();
+        testReset();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(beast,http,header_view_parser);
+
+} // http
+} // beast
+} // boost
@@ -0,0 +1,284 @@
+//
+// Copyright (c) 2016-2019 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/beast
+//
+
+// Test that header file is self-contained.
+#include <boost/beast/http/mapped_file_body.hpp>
+
+#include <boost/beast/core/buffers_to_string.hpp>
+#include <boost/beast/http/serializer.hpp>
+#include <boost/beast/http/type_traits.hpp>
+#include <boost/beast/_experimental/unit_test/suite.hpp>
+#include <boost/filesystem.hpp>
+#include <fstream>
+#include <string>
+
+namespace boost {
+namespace beast {
+namespace http {
+
+class mapped_file_body_test : public beast::unit_test::suite
+{
+public:
+    BOOST_CORE_STATIC_ASSERT(is_body<mapped_file_body>::value);
+    BOOST_CORE_STATIC_ASSERT(is_body_writer<mapped_file_body>::value);
+    BOOST_CORE_STATIC_ASSERT(! is_body_reader<mapped_file_body>::value);
+
+    class temp_file
+    {
+        boost::filesystem::path path_;
+
+    public:
+        explicit
+        temp_file(std::string const& s)
+            : path_(boost::filesystem::unique_path())
+        {
+            std::ofstream f(path_.string(), std::ios::binary);
+            f << s;
+        }
+
+        ~temp_file()
+        {
+            boost::system::error_code ec;
+            boost::filesystem::remove(path_, ec);
+        }
+
+        std::string
+        path() const
+        {
+            return path_.string<std::string>();
+        }
+    };
+
+    struct lambda
+    {
+        std::string s;
+
+        template<class ConstBufferSequence>
+        void
+        operator()(error_code&, ConstBufferSequence const& buffers)
+        {
+            s.append(buffers_to_string(buffers));
+        }
+    };
+
+    static
+    std::string
+    content(std::size_t n)
+    {
+        std::string s;
+        s.reserve(n);
+        for(std::size_t i = 0; i < n; ++i)
+            s.push_back(static_cast<char>('a' + i % 26));
+        return s;
+    }
+
+    static
+    std::string
+    to_string(mapped_file_body::value_type const& v)
+    {
+        return std::string(v.data(), v.size());
+    }
+
+    void
+    testOpen()
+    {
+        auto const s = content(10000);
+        temp_file const tf(s);
+        error_code ec;
+
+        mapped_file_body::value_type v;
+        BEAST_EXPECT(! v.is_open());
+        BEAST_EXPECT(v.size() == 0);
+        v.open(tf.path().c_str(), ec);
+        BEAST_EXPECTS(! ec, ec.message());
+        BEAST_EXPECT(v.is_open());
+        BEAST_EXPECT(v.size() == s.size());
+        BEAST_EXPECT(mapped_file_body::size(v) == s.size());
+        BEAST_EXPECT(to_string(v) == s);
+
+        // an offset which is not on a page boundary
+        v.open(tf.path().c_str(), 5001, 100, ec);
+        BEAST_EXPECTS(! ec, ec.message());
+        BEAST_EXPECT(to_string(v) == s.substr(5001, 100));
+
+        // the length is reduced to the end of the file
+        v.open(tf.path().c_str(), 9990, 100, ec);
+        BEAST_EXPECTS(! ec, ec.message());
+        BEAST_EXPECT(to_string(v) == s.substr(9990));
+
+        v.open(tf.path().c_str(), 10000, 100, ec);
+        BEAST_EXPECTS(! ec, ec.message());
+        BEAST_EXPECT(v.is_open());
+        BEAST_EXPECT(v.size() == 0);
+
+        v.open(tf.path().c_str(), 10001, 100, ec);
+        BEAST_EXPECT(ec == errc::invalid_argument);
+        BEAST_EXPECT(! v.is_open());
+
+        // copies share the mapping
+        v.open(tf.path().c_str(), ec);
+        BEAST_EXPECTS(! ec, ec.message());
+        auto v2 = v;
+        v.close();
+        BEAST_EXPECT(! v.is_open());
+        BEAST_EXPECT(v.size() == 0);
+        BEAST_EXPECT(to_string(v2) == s);
+
+        // missing file
+        auto const missing =
+            boost::filesystem::unique_path().string<std::string>();
+        v.open(missing.c_str(), ec);
+        BEAST_EXPECT(ec);
+        BEAST_EXPECT(! v.is_open());
+
+        // empty file
+        temp_file const empty("");
+        v.open(empty.path().c_str(), ec);
+        BEAST_EXPECTS(! ec, ec.message());
+        BEAST_EXPECT(v.is_open());
+        BEAST_EXPECT(v.size() == 0);
+    }
+
+    void
+    testAdvise()
+    {
+        auto const s = content(100000);
+        temp_file const tf(s);
+        error_code ec;
+
+        mapped_file_body::value_type v;
+        v.advise(mapped_file_body::advice::sequential, ec);
+        BEAST_EXPECTS(! ec, ec.message());
+
+        v.open(tf.path().c_str(), 4097, 50000, ec);
+        BEAST_EXPECTS(! ec, ec.message());
+        v.advise(mapped_file_body::advice::sequential, ec);
+        BEAST_EXPECTS(! ec, ec.message());
+        v.advise(mapped_file_body::advice::willneed, ec);
+        BEAST_EXPECTS(! ec, ec.message());
+        v.advise(mapped_file_body::advice::normal, ec);
+        BEAST_EXPECTS(! ec, ec.message());
+        BEAST_EXPECT(to_string(v) == s.substr(4097, 50000));
+    }
+
+    void
+    testSerialize()
+    {
+        auto const s = content(20000);
+        temp_file const tf(s);
+        error_code ec;
+
+        response<mapped_file_body> res{status::ok, 11};
+        res.set(field::server, "test");
+        res.body().open(tf.path().c_str(), ec);
+        BEAST_EXPECTS(! ec, ec.message());
+        res.prepare_payload();
+        BEAST_EXPECT(res[field::content_length] == "20000");
+
+        serializer<false, mapped_file_body, fields> sr{res};
+        lambda visit;
+        sr.split(true);
+        sr.next(ec, visit);
+        BEAST_EXPECTS(! ec, ec.message());
+        sr.consume(visit.s.size());
+        BEAST_EXPECT(sr.is_header_done());
+        BEAST_EXPECT(visit.s ==
+            "HTTP/1.1 200 OK\r\n"
+            "Server: test\r\n"
+            "Content-Length: 20000\r\n"
+            "\r\n");
+
+        // the body is presented in one buffer
+        visit.s.clear();
+        sr.next(ec, visit);
+        BEAST_EXPECTS(! ec, ec.message());
+        BEAST_EXPECT(visit.s == s);
+        sr.consume(visit.s.size());
+        BEAST_EXPECT(sr.is_done());
+    }
+
+    void
+    testCache()
+    {
+        auto const s1 = content(3000);
+        auto const s2 = content(5000);
+        auto const s3 = content(7000);
+        temp_file const f1(s1);
+        temp_file const f2(s2);
+        temp_file const f3(s3);
+        error_code ec;
+
+        mapped_file_cache cache(2,
+            mapped_file_body::advice::willneed);
+        BEAST_EXPECT(cache.size() == 0);
+
+        auto v1 = cache.open(f1.path(), ec);
+        BEAST_EXPECTS(! ec, ec.message());
+        BEAST_EXPECT(to_string(v1) == s1);
+        BEAST_EXPECT(cache.size() == 1);
+
+        // the same mapping is returned
+        auto v2 = cache.open(f1.path(), ec);
+        BEAST_EXPECTS(! ec, ec.message());
+        BEAST_EXPECT(v2.data() == v1.data());
+        BEAST_EXPECT(cache.size() == 1);
+
+        // missing files are not cached
+        auto const missing =
+            boost::filesystem::unique_path().string<std::string>();
+        auto v3 = cache.open(missing, ec);
+        BEAST_EXPECT(ec);
+        BEAST_EXPECT(! v3.is_open());
+        BEAST_EXPECT(cache.size() == 1);
+
+        // the least recently used file is removed
+        cache.open(f2.path(), ec);
+        BEAST_EXPECTS(! ec, ec.message());
+        cache.open(f1.path(), ec);
+        BEAST_EXPECTS(! ec, ec.message());
+        cache.open(f3.path(), ec);
+        BEAST_EXPECTS(! ec, ec.message());
+        BEAST_EXPECT(cache.size() == 2);
+        BEAST_EXPECT(! cache.erase(f2.path()));
+        BEAST_EXPECT(cache.open(f1.path(), ec).data() == v1.data());
+        BEAST_EXPECT(cache.size() == 2);
+
+        BEAST_EXPECT(cache.erase(f1.path()));
+        BEAST_EXPECT(! cache.erase(f1.path()));
+        BEAST_EXPECT(cache.size() == 1);
+
+        // bodies remain valid after the cache is cleared
+        cache.clear();
+        BEAST_EXPECT(cache.size() == 0);
+        BEAST_EXPECT(to_string(v1) == s1);
+        BEAST_EXPECT(to_string(v2) == s1);
+
+        // a cache without capacity holds nothing
+        mapped_file_cache none(0);
+        auto v4 = none.open(f3.path(), ec);
+        BEAST_EXPECTS(! ec, ec.message());
+        BEAST_EXPECT(to_string(v4) == s3);
+        BEAST_EXPECT(none.size() == 0);
+    }
+
+    void
+    run() override
+    {
+        testOpen();
+        testAdvise();
+        testSerialize();
+        testCache();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(beast,http,mapped_file_body);
+
+} // http
+} // beast
+} // boost
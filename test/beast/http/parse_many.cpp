@@ -0,0 +1,188 @@
+//
+// Copyright (c) 2016-2019 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/beast
+//
+
+// Test that header file is self-contained.
+#include <boost/beast/http/parse_many.hpp>
+
+#include <boost/beast/core/flat_buffer.hpp>
+#include <boost/beast/core/multi_buffer.hpp>
+#include <boost/beast/core/ostream.hpp>
+#include <boost/beast/http/string_body.hpp>
+#include <boost/beast/_experimental/unit_test/suite.hpp>
+#include <string>
+#include <vector>
+
+namespace boost {
+namespace beast {
+namespace http {
+
+class parse_many_test : public beast::unit_test::suite
+{
+public:
+    template<class DynamicBuffer>
+    void
+    testPipelined()
+    {
+        DynamicBuffer b;
+        ostream(b) <<
+            "GET /1 HTTP/1.1\r\n"
+            "\r\n"
+            "POST /2 HTTP/1.1\r\n"
+            "Content-Length: 3\r\n"
+            "\r\n"
+            "abc"
+            "PUT /3 HTTP/1.1\r\n"
+            "Transfer-Encoding: chunked\r\n"
+            "\r\n"
+            "2\r\nxy\r\n"
+            "0\r\n\r\n"
+            "GET /4 HTTP/1.1\r\n"
+            "Host: exa";
+        request_parser<string_body> p;
+        std::vector<request<string_body>> v;
+        error_code ec;
+        auto const n = parse_many(b, p,
+            [&](request<string_body>&& req)
+            {
+                v.push_back(std::move(req));
+            }, ec);
+        BEAST_EXPECTS(! ec, ec.message());
+        BEAST_EXPECT(n == 3);
+        if(! BEAST_EXPECT(v.size() == 3))
+            return;
+        BEAST_EXPECT(v[0].target() == "/1");
+        BEAST_EXPECT(v[0].body().empty());
+        BEAST_EXPECT(v[1].method() == verb::post);
+        BEAST_EXPECT(v[1].body() == "abc");
+        BEAST_EXPECT(v[2].target() == "/3");
+        BEAST_EXPECT(v[2].body() == "xy");
+
+        // the partial message waits in the parser
+        BEAST_EXPECT(p.got_some());
+        BEAST_EXPECT(! p.is_done());
+        ostream(b) <<
+            "mple.com\r\n"
+            "\r\n";
+        v.clear();
+        BEAST_EXPECT(parse_many(b, p,
+            [&](request<string_body>&& req)
+            {
+                v.push_back(std::move(req));
+            }) == 1);
+        BEAST_EXPECT(b.size() == 0);
+        if(! BEAST_EXPECT(v.size() == 1))
+            return;
+        BEAST_EXPECT(v[0].target() == "/4");
+        BEAST_EXPECT(v[0][field::host] == "example.com");
+    }
+
+    void
+    testDone()
+    {
+        // a message completed beforehand is delivered first
+        std::string const s =
+            "GET /1 HTTP/1.1\r\n"
+            "\r\n"
+            "GET /2 HTTP/1.1\r\n"
+            "\r\n";
+        flat_buffer b;
+        ostream(b) << s;
+        request_parser<string_body> p;
+        error_code ec;
+        p.eager(false);
+        b.consume(p.put(b.data(), ec));
+        BEAST_EXPECTS(! ec, ec.message());
+        BEAST_EXPECT(p.is_done());
+        std::vector<std::string> v;
+        auto const n = parse_many(b, p,
+            [&](request<string_body>&& req)
+            {
+                v.emplace_back(req.target());
+            }, ec);
+        BEAST_EXPECTS(! ec, ec.message());
+        BEAST_EXPECT(n == 2);
+        BEAST_EXPECT((v == std::vector<std::string>{"/1", "/2"}));
+        BEAST_EXPECT(! p.got_some());
+
+        // nothing to do
+        BEAST_EXPECT(parse_many(b, p,
+            [&](request<string_body>&&)
+            {
+                fail("", __FILE__, __LINE__);
+            }, ec) == 0);
+        BEAST_EXPECTS(! ec, ec.message());
+    }
+
+    void
+    testError()
+    {
+        flat_buffer b;
+        ostream(b) <<
+            "GET /1 HTTP/1.1\r\n"
+            "\r\n"
+            "GET /2 HTTP/1.1\r\n"
+            "Bad Field: x\r\n"
+            "\r\n"
+            "GET /3 HTTP/1.1\r\n"
+            "\r\n";
+        request_parser<string_body> p;
+        std::size_t count = 0;
+        error_code ec;
+        auto const n = parse_many(b, p,
+            [&](request<string_body>&&)
+            {
+                ++count;
+            }, ec);
+        BEAST_EXPECTS(ec == error::bad_field, ec.message());
+        BEAST_EXPECT(n == 1);
+        BEAST_EXPECT(count == 1);
+
+        // body limit applies to each message
+        flat_buffer b2;
+        ostream(b2) <<
+            "POST / HTTP/1.1\r\n"
+            "Content-Length: 3\r\n"
+            "\r\n"
+            "abc"
+            "POST / HTTP/1.1\r\n"
+            "Content-Length: 5\r\n"
+            "\r\n"
+            "abcde";
+        request_parser<string_body> p2;
+        p2.body_limit(4);
+        try
+        {
+            parse_many(b2, p2,
+                [&](request<string_body>&&)
+                {
+                });
+            fail("", __FILE__, __LINE__);
+        }
+        catch(system_error const& e)
+        {
+            BEAST_EXPECTS(e.code() == error::body_limit,
+                e.code().message());
+        }
+    }
+
+    void
+    run() override
+    {
+        testPipelined<flat_buffer>();
+        testPipelined<multi_buffer>();
+        testDone();
+        testError();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(beast,http,parse_many);
+
+} // http
+} // beast
+} // boost
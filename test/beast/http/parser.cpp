@@ -15,10 +15,15 @@
 #include <boost/beast/_experimental/unit_test/suite.hpp>
 #include <boost/beast/core/buffer_traits.hpp>
 #include <boost/beast/core/buffers_suffix.hpp>
+#include <boost/beast/core/buffers_to_string.hpp>
 #include <boost/beast/core/flat_buffer.hpp>
 #include <boost/beast/core/multi_buffer.hpp>
 #include <boost/beast/core/ostream.hpp>
+#include <boost/beast/http/buffer_body.hpp>
+#include <boost/beast/http/dynamic_body.hpp>
+#include <boost/beast/http/empty_body.hpp>
 #include <boost/beast/http/string_body.hpp>
+#include <boost/beast/http/vector_body.hpp>
 #include <boost/system/system_error.hpp>
 #include <algorithm>
 
@@ -641,6 +646,228 @@ public:
         BEAST_EXPECT(p.is_done());
     }
 
+    void
+    testReset()
+    {
+        string_view const s =
+            "POST /one HTTP/1.1\r\n"
+            "Content-Length: 5\r\n"
+            "X-First: 1\r\n"
+            "\r\n"
+            "hello"
+            "GET /two HTTP/1.1\r\n"
+            "Transfer-Encoding: chunked\r\n"
+            "\r\n"
+            "3\r\nabc\r\n"
+            "0\r\n\r\n"
+            "PUT /three HTTP/1.0\r\n"
+            "Content-Length: 2\r\n"
+            "\r\n"
+            "xy";
+        request_parser<string_body> p;
+        p.body_limit(5);
+        p.eager(true);
+        error_code ec;
+        auto n = p.put(buf(s), ec);
+        BEAST_EXPECTS(! ec, ec.message());
+        BEAST_EXPECT(p.is_done());
+        BEAST_EXPECT(p.get().method() == verb::post);
+        BEAST_EXPECT(p.get().body() == "hello");
+        auto const capacity = p.get().body().capacity();
+        auto in = s.substr(n);
+
+        p.reset();
+        BEAST_EXPECT(! p.got_some());
+        BEAST_EXPECT(p.get().body().empty());
+        BEAST_EXPECT(p.get().body().capacity() == capacity);
+        BEAST_EXPECT(! p.get().count("X-First"));
+        n = p.put(buf(in), ec);
+        BEAST_EXPECTS(! ec, ec.message());
+        BEAST_EXPECT(p.is_done());
+        BEAST_EXPECT(p.chunked());
+        BEAST_EXPECT(p.get().target() == "/two");
+        BEAST_EXPECT(p.get().body() == "abc");
+        BEAST_EXPECT(! p.get().count("X-First"));
+        in = in.substr(n);
+
+        // the body limit applies to each message
+        auto msg = p.release();
+        BEAST_EXPECT(msg.body() == "abc");
+        p.reset();
+        n = p.put(buf(in), ec);
+        BEAST_EXPECTS(! ec, ec.message());
+        BEAST_EXPECT(p.is_done());
+        BEAST_EXPECT(n == in.size());
+        BEAST_EXPECT(p.get().method() == verb::put);
+        BEAST_EXPECT(p.get().version() == 10);
+        BEAST_EXPECT(! p.keep_alive());
+        BEAST_EXPECT(p.get().body() == "xy");
+
+        p.reset();
+        string_view const big =
+            "POST / HTTP/1.1\r\n"
+            "Content-Length: 6\r\n"
+            "\r\n"
+            "123456";
+        p.put(buf(big), ec);
+        BEAST_EXPECTS(ec == error::body_limit, ec.message());
+
+        // the header limit applies to each message
+        request_parser<string_body> p2;
+        p2.header_limit(40);
+        string_view const h =
+            "GET / HTTP/1.1\r\n"
+            "User-Agent: x\r\n"
+            "\r\n";
+        for(int i = 0; i < 3; ++i)
+        {
+            p2.put(buf(h), ec);
+            BEAST_EXPECTS(! ec, ec.message());
+            BEAST_EXPECT(p2.is_done());
+            p2.reset();
+        }
+
+        // the skip option is cleared
+        response_parser<string_body> p3;
+        p3.skip(true);
+        string_view const r =
+            "HTTP/1.1 200 OK\r\n"
+            "Content-Length: 3\r\n"
+            "\r\n";
+        p3.put(buf(r), ec);
+        BEAST_EXPECTS(! ec, ec.message());
+        BEAST_EXPECT(p3.is_done());
+        p3.reset();
+        BEAST_EXPECT(! p3.skip());
+        p3.put(buf(r), ec);
+        BEAST_EXPECTS(! ec, ec.message());
+        BEAST_EXPECT(! p3.is_done());
+
+        // body without clear()
+        request_parser<empty_body> p4;
+        for(int i = 0; i < 2; ++i)
+        {
+            p4.put(buf(h), ec);
+            BEAST_EXPECTS(! ec, ec.message());
+            BEAST_EXPECT(p4.is_done());
+            p4.reset();
+        }
+    }
+
+    template<class Body>
+    void
+    testPrepareBody()
+    {
+        string_view const h =
+            "POST / HTTP/1.1\r\n"
+            "Content-Length: 10\r\n"
+            "\r\n";
+        request_parser<Body> p;
+        error_code ec;
+        BEAST_EXPECT(p.prepare_body(10, ec).size() == 0);
+        BEAST_EXPECTS(! ec, ec.message());
+        p.put(buf(h), ec);
+        BEAST_EXPECTS(! ec, ec.message());
+        BEAST_EXPECT(p.is_header_done());
+
+        auto mb = p.prepare_body(4, ec);
+        BEAST_EXPECTS(! ec, ec.message());
+        BEAST_EXPECT(mb.size() == 4);
+        net::buffer_copy(mb, buf("0123"));
+        p.commit_body(4, ec);
+        BEAST_EXPECTS(! ec, ec.message());
+        BEAST_EXPECT(*p.content_length_remaining() == 6);
+
+        // clamped to the remaining length, partly used
+        mb = p.prepare_body(100, ec);
+        BEAST_EXPECTS(! ec, ec.message());
+        BEAST_EXPECT(mb.size() == 6);
+        net::buffer_copy(mb, buf("456"));
+        p.commit_body(3, ec);
+        BEAST_EXPECTS(! ec, ec.message());
+        BEAST_EXPECT(p.get().body().size() == 7);
+
+        // nothing received
+        mb = p.prepare_body(100, ec);
+        BEAST_EXPECT(mb.size() == 3);
+        p.commit_body(0, ec);
+        BEAST_EXPECTS(! ec, ec.message());
+        BEAST_EXPECT(p.get().body().size() == 7);
+
+        // mixed with put
+        p.put(buf("7"), ec);
+        BEAST_EXPECTS(! ec, ec.message());
+        mb = p.prepare_body(100, ec);
+        BEAST_EXPECT(mb.size() == 2);
+        net::buffer_copy(mb, buf("89"));
+        p.commit_body(2, ec);
+        BEAST_EXPECTS(! ec, ec.message());
+        BEAST_EXPECT(p.is_done());
+        BEAST_EXPECT(std::string(p.get().body().begin(),
+            p.get().body().end()) == "0123456789");
+        BEAST_EXPECT(p.prepare_body(100, ec).size() == 0);
+    }
+
+    void
+    testPrepareBody()
+    {
+        testPrepareBody<string_body>();
+        testPrepareBody<vector_body<char>>();
+
+        error_code ec;
+        {
+            // no storage for the body
+            request_parser<dynamic_body> p;
+            p.put(buf(
+                "POST / HTTP/1.1\r\n"
+                "Content-Length: 3\r\n"
+                "\r\n"), ec);
+            BEAST_EXPECTS(! ec, ec.message());
+            BEAST_EXPECT(p.prepare_body(3, ec).size() == 0);
+            BEAST_EXPECTS(! ec, ec.message());
+            p.put(buf("abc"), ec);
+            BEAST_EXPECTS(! ec, ec.message());
+            BEAST_EXPECT(p.is_done());
+            BEAST_EXPECT(buffers_to_string(
+                p.get().body().data()) == "abc");
+        }
+        {
+            // chunked bodies are not received in place
+            request_parser<string_body> p;
+            p.put(buf(
+                "POST / HTTP/1.1\r\n"
+                "Transfer-Encoding: chunked\r\n"
+                "\r\n"), ec);
+            BEAST_EXPECTS(! ec, ec.message());
+            BEAST_EXPECT(p.prepare_body(3, ec).size() == 0);
+            BEAST_EXPECTS(! ec, ec.message());
+        }
+        {
+            // buffer_body receives into the caller's buffer
+            char data[4];
+            response_parser<buffer_body> p;
+            p.put(buf(
+                "HTTP/1.1 200 OK\r\n"
+                "Content-Length: 6\r\n"
+                "\r\n"), ec);
+            BEAST_EXPECTS(! ec, ec.message());
+            BEAST_EXPECT(p.prepare_body(6, ec).size() == 0);
+            BEAST_EXPECTS(! ec, ec.message());
+            p.get().body().data = data;
+            p.get().body().size = sizeof(data);
+            auto const mb = p.prepare_body(6, ec);
+            BEAST_EXPECT(mb.data() == data);
+            BEAST_EXPECT(mb.size() == 4);
+            net::buffer_copy(mb, buf("abcd"));
+            p.commit_body(4, ec);
+            BEAST_EXPECTS(! ec, ec.message());
+            BEAST_EXPECT(p.get().body().size == 0);
+            BEAST_EXPECT(p.prepare_body(6, ec).size() == 0);
+            BEAST_EXPECT(ec == error::need_buffer);
+            BEAST_EXPECT(! p.is_done());
+        }
+    }
+
     void
     run() override
     {
@@ -654,6 +881,8 @@ public:
         testIssue1187();
         testIssue1880();
         testIssue2861();
+        testReset();
+        testPrepareBody();
     }
 };
 
@@ -0,0 +1,278 @@
+//
+// Copyright (c) 2016-2019 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/beast
+//
+
+// Test that header file is self-contained.
+#include <boost/beast/http/prepared_header.hpp>
+
+#include <boost/beast/core/buffers_to_string.hpp>
+#include <boost/beast/http/empty_body.hpp>
+#include <boost/beast/http/fields.hpp>
+#include <boost/beast/http/message.hpp>
+#include <boost/beast/http/serializer.hpp>
+#include <boost/beast/http/string_body.hpp>
+#include <boost/beast/http/type_traits.hpp>
+#include <boost/beast/_experimental/unit_test/suite.hpp>
+#include <stdexcept>
+#include <string>
+
+namespace boost {
+namespace beast {
+namespace http {
+
+class prepared_header_test : public beast::unit_test::suite
+{
+public:
+    BOOST_CORE_STATIC_ASSERT(is_fields<prepared_header>::value);
+    BOOST_CORE_STATIC_ASSERT(std::is_nothrow_move_constructible<prepared_header>::value);
+
+    struct serialize_visitor
+    {
+        std::string& s;
+
+        template<class ConstBufferSequence>
+        void
+        operator()(error_code&,
+            ConstBufferSequence const& buffers)
+        {
+            s.append(buffers_to_string(buffers));
+        }
+    };
+
+    template<class Body>
+    static
+    std::string
+    serialize(response<Body, prepared_header> const& m)
+    {
+        std::string s;
+        serializer<false, Body, prepared_header> sr{m};
+        error_code ec;
+        do
+        {
+            auto const n = s.size();
+            sr.next(ec, serialize_visitor{s});
+            if(ec)
+                break;
+            sr.consume(s.size() - n);
+        }
+        while(! sr.is_done());
+        return s;
+    }
+
+    static
+    std::string
+    render(prepared_header const& f,
+        unsigned version = 11, unsigned code = 200)
+    {
+        prepared_header::writer w(f, version, code);
+        return buffers_to_string(w.get());
+    }
+
+    static
+    response_header<>
+    make_header()
+    {
+        response_header<> h;
+        h.version(11);
+        h.result(status::ok);
+        h.set(field::server, "test");
+        h.set(field::content_length, "0");
+        h.set("X-Request-Id", "");
+        return h;
+    }
+
+    void
+    testPrepare()
+    {
+        prepared_header const ph(make_header(), {
+            field::content_length,
+            field::date,
+            {"x-request-id", 8}});
+        BEAST_EXPECT(ph[field::server] == "test");
+        BEAST_EXPECT(ph["Server"] == "test");
+        BEAST_EXPECT(ph[field::content_length] == "0");
+        BEAST_EXPECT(ph.contains(field::content_length));
+        BEAST_EXPECT(! ph.contains(field::date));
+        BEAST_EXPECT(! ph.contains("x-request-id"));
+        BEAST_EXPECT(ph.is_slot(field::date));
+        BEAST_EXPECT(ph.is_slot("X-REQUEST-ID"));
+        BEAST_EXPECT(! ph.is_slot(field::server));
+        BEAST_EXPECT(! ph.is_slot(field::host));
+
+        // slots without a value are left out
+        BEAST_EXPECT(render(ph) ==
+            "HTTP/1.1 200 OK\r\n"
+            "Server: test\r\n"
+            "Content-Length: 0                   \r\n"
+            "\r\n");
+
+        // a custom reason-phrase is kept
+        response_header<> h;
+        h.version(10);
+        h.result(status::not_found);
+        h.reason("Gone Fishing");
+        prepared_header const ph2(h);
+        BEAST_EXPECT(render(ph2, 10, 404) ==
+            "HTTP/1.0 404 Gone Fishing\r\n"
+            "\r\n");
+
+        // the default header has no fields
+        BEAST_EXPECT(render(prepared_header{}, 11, 204) ==
+            "HTTP/1.1 204 No Content\r\n"
+            "\r\n");
+    }
+
+    void
+    testSet()
+    {
+        prepared_header ph(make_header(), {
+            field::content_length,
+            field::date,
+            {"x-request-id", 8}});
+        ph.set(field::date, "Sun, 06 Nov 1994 08:49:37 GMT");
+        ph.set("X-Request-Id", "abcd");
+        BEAST_EXPECT(ph[field::date] == "Sun, 06 Nov 1994 08:49:37 GMT");
+        BEAST_EXPECT(ph["x-request-id"] == "abcd");
+        BEAST_EXPECT(render(ph) ==
+            "HTTP/1.1 200 OK\r\n"
+            "Server: test\r\n"
+            "Content-Length: 0                   \r\n"
+            "X-Request-Id: abcd    \r\n"
+            "Date: Sun, 06 Nov 1994 08:49:37 GMT\r\n"
+            "\r\n");
+
+        // copies are independent
+        auto ph2 = ph;
+        ph2.set("x-request-id", "12345678");
+        BEAST_EXPECT(ph["x-request-id"] == "abcd");
+        BEAST_EXPECT(ph2["x-request-id"] == "12345678");
+
+        // clearing a slot leaves it out
+        ph2.set(field::date, "");
+        BEAST_EXPECT(render(ph2) ==
+            "HTTP/1.1 200 OK\r\n"
+            "Server: test\r\n"
+            "Content-Length: 0                   \r\n"
+            "X-Request-Id: 12345678\r\n"
+            "\r\n");
+
+        // a different status is rendered again
+        BEAST_EXPECT(render(ph, 10, 202) ==
+            "HTTP/1.0 202 Accepted\r\n"
+            "Server: test\r\n"
+            "Content-Length: 0                   \r\n"
+            "X-Request-Id: abcd    \r\n"
+            "Date: Sun, 06 Nov 1994 08:49:37 GMT\r\n"
+            "\r\n");
+
+        try
+        {
+            ph.set("x-request-id", "123456789");
+            fail("", __FILE__, __LINE__);
+        }
+        catch(std::length_error const&)
+        {
+            pass();
+        }
+        try
+        {
+            ph.set(field::server, "other");
+            fail("", __FILE__, __LINE__);
+        }
+        catch(std::out_of_range const&)
+        {
+            pass();
+        }
+        BEAST_EXPECT(ph["x-request-id"] == "abcd");
+        BEAST_EXPECT(ph[field::server] == "test");
+    }
+
+    void
+    testMessage()
+    {
+        prepared_header const ph(make_header(), {
+            field::content_length,
+            field::connection});
+
+        response<string_body, prepared_header> res(
+            status::ok, 11, "Hello, world!", ph);
+        res.prepare_payload();
+        BEAST_EXPECT(res.has_content_length());
+        BEAST_EXPECT(res[field::content_length] == "13");
+        BEAST_EXPECT(! res.chunked());
+        BEAST_EXPECT(res.keep_alive());
+        res.keep_alive(false);
+        BEAST_EXPECT(! res.keep_alive());
+        BEAST_EXPECT(res[field::connection] == "close");
+        BEAST_EXPECT(res.reason() == "OK");
+        BEAST_EXPECT(serialize(res) ==
+            "HTTP/1.1 200 OK\r\n"
+            "Server: test\r\n"
+            "Content-Length: 13                  \r\n"
+            "X-Request-Id: \r\n"
+            "Connection: close     \r\n"
+            "\r\n"
+            "Hello, world!");
+
+        // changes to fields which are not slots are rejected
+        try
+        {
+            res.chunked(true);
+            fail("", __FILE__, __LINE__);
+        }
+        catch(std::invalid_argument const&)
+        {
+            pass();
+        }
+        try
+        {
+            res.reason("Fine");
+            fail("", __FILE__, __LINE__);
+        }
+        catch(std::invalid_argument const&)
+        {
+            pass();
+        }
+
+        // settings which leave a field unchanged are accepted
+        response<empty_body, prepared_header> res2(
+            status::not_found, 11, empty_body::value_type{},
+            prepared_header(make_header()));
+        res2.prepare_payload();
+        res2.keep_alive(true);
+        BEAST_EXPECT(serialize(res2) ==
+            "HTTP/1.1 404 Not Found\r\n"
+            "Server: test\r\n"
+            "Content-Length: 0\r\n"
+            "X-Request-Id: \r\n"
+            "\r\n");
+        try
+        {
+            res2.keep_alive(false);
+            fail("", __FILE__, __LINE__);
+        }
+        catch(std::invalid_argument const&)
+        {
+            pass();
+        }
+    }
+
+    void
+    run() override
+    {
+        testPrepare();
+        testSet();
+        testMessage();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(beast,http,prepared_header);
+
+} // http
+} // beast
+} // boost
@@ -18,6 +18,7 @@
 #include <boost/beast/http/dynamic_body.hpp>
 #include <boost/beast/http/parser.hpp>
 #include <boost/beast/http/string_body.hpp>
+#include <boost/beast/http/vector_body.hpp>
 #include <boost/beast/_experimental/test/stream.hpp>
 #include <boost/beast/_experimental/unit_test/suite.hpp>
 #include <boost/beast/test/yield_to.hpp>
@@ -787,6 +788,77 @@ public:
         // the timer handler may be invoked after the test suite is complete if we don't post.
         asio::post(ioc_, do_yield);
     }
+    template<class Body>
+    void
+    testBodyInPlace(yield_context do_yield)
+    {
+        std::string body(100000, 'x');
+        for(std::size_t i = 0; i < body.size(); ++i)
+            body[i] = static_cast<char>('a' + i % 26);
+        std::string const h =
+            "POST / HTTP/1.1\r\n"
+            "Content-Length: " + std::to_string(body.size()) + "\r\n"
+            "\r\n";
+        auto const check =
+            [&](request_parser<Body> const& p)
+            {
+                BEAST_EXPECT(p.is_done());
+                BEAST_EXPECT(std::string(
+                    p.get().body().begin(),
+                    p.get().body().end()) == body);
+            };
+
+        // the body bypasses the dynamic buffer
+        {
+            test::stream ts{ioc_, h + body};
+            ts.read_size(h.size() + 10);
+            flat_buffer b;
+            request_parser<Body> p;
+            error_code ec;
+            auto const n = read(ts, b, p, ec);
+            BEAST_EXPECTS(! ec, ec.message());
+            BEAST_EXPECT(n == h.size() + body.size());
+            BEAST_EXPECT(b.capacity() < 1024);
+            check(p);
+        }
+        {
+            test::stream ts{ioc_, h + body};
+            ts.read_size(h.size() + 10);
+            flat_buffer b;
+            request_parser<Body> p;
+            error_code ec;
+            auto const n = async_read(ts, b, p, do_yield[ec]);
+            BEAST_EXPECTS(! ec, ec.message());
+            BEAST_EXPECT(n == h.size() + body.size());
+            BEAST_EXPECT(b.capacity() < 1024);
+            check(p);
+        }
+
+        // the body is incomplete
+        {
+            test::stream ts{ioc_, h + body.substr(0, 50000)};
+            ts.read_size(h.size());
+            ts.close_remote();
+            flat_buffer b;
+            request_parser<Body> p;
+            error_code ec;
+            read(ts, b, p, ec);
+            BEAST_EXPECTS(ec == error::partial_message, ec.message());
+            BEAST_EXPECT(p.get().body().size() == 50000);
+        }
+        {
+            test::stream ts{ioc_, h + body.substr(0, 50000)};
+            ts.read_size(h.size());
+            ts.close_remote();
+            flat_buffer b;
+            request_parser<Body> p;
+            error_code ec;
+            async_read(ts, b, p, do_yield[ec]);
+            BEAST_EXPECTS(ec == error::partial_message, ec.message());
+            BEAST_EXPECT(p.get().body().size() == 50000);
+        }
+    }
+
     void
     run() override
     {
@@ -823,6 +895,11 @@ public:
             {
                 testCancellation(yield);
             });
+        yield_to([&](yield_context yield)
+        {
+            testBodyInPlace<string_body>(yield);
+            testBodyInPlace<vector_body<char>>(yield);
+        });
     }
 
 
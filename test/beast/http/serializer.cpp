@@ -11,8 +11,11 @@
 #include <boost/beast/http/serializer.hpp>
 
 #include <boost/beast/core/buffer_traits.hpp>
+#include <boost/beast/core/buffers_to_string.hpp>
 #include <boost/beast/http/string_body.hpp>
 #include <boost/beast/_experimental/unit_test/suite.hpp>
+#include <string>
+#include <vector>
 
 namespace boost {
 namespace beast {
@@ -116,10 +119,79 @@ public:
         }
     }
 
+    struct record
+    {
+        std::string s;
+        std::vector<std::size_t> sizes;
+
+        template<class ConstBufferSequence>
+        void
+        operator()(error_code&,
+            ConstBufferSequence const& buffers)
+        {
+            sizes.clear();
+            for(auto it = net::buffer_sequence_begin(buffers);
+                    it != net::buffer_sequence_end(buffers); ++it)
+                if(net::const_buffer(*it).size() > 0)
+                    sizes.push_back(net::const_buffer(*it).size());
+            s = buffers_to_string(buffers);
+        }
+    };
+
+    void
+    testContiguousHeader()
+    {
+        std::string const h =
+            "HTTP/1.1 200 OK\r\n"
+            "Server: test\r\n"
+            "Content-Type: text/plain\r\n"
+            "Content-Length: 5\r\n"
+            "\r\n";
+        response<string_body> res{status::ok, 11, "hello"};
+        res.set(field::server, "test");
+        res.set(field::content_type, "text/plain");
+        res.prepare_payload();
+        res.contiguous_header(true);
+        for(int i = 0; i < 2; ++i)
+        {
+            // the header and body go out as two buffers
+            record visit;
+            error_code ec;
+            serializer<false, string_body> sr{res};
+            sr.next(ec, visit);
+            BEAST_EXPECTS(! ec, ec.message());
+            BEAST_EXPECT(visit.s == h + "hello");
+            BEAST_EXPECT((visit.sizes ==
+                std::vector<std::size_t>{h.size(), 5}));
+            sr.consume(visit.s.size());
+            BEAST_EXPECT(sr.is_done());
+        }
+
+        res.chunked(true);
+        {
+            record visit;
+            error_code ec;
+            serializer<false, string_body> sr{res};
+            sr.next(ec, visit);
+            BEAST_EXPECTS(! ec, ec.message());
+            BEAST_EXPECT(visit.s ==
+                "HTTP/1.1 200 OK\r\n"
+                "Server: test\r\n"
+                "Content-Type: text/plain\r\n"
+                "Transfer-Encoding: chunked\r\n"
+                "\r\n"
+                "5\r\nhello\r\n"
+                "0\r\n\r\n");
+            BEAST_EXPECT(visit.sizes.front() ==
+                visit.s.find("\r\n\r\n") + 4);
+        }
+    }
+
     void
     run() override
     {
         testWriteLimit();
+        testContiguousHeader();
     }
 };
 
@@ -10,7 +10,9 @@
 // Test that header file is self-contained.
 #include <boost/beast/http/status.hpp>
 
+#include <boost/beast/http/detail/status_line.hpp>
 #include <boost/beast/_experimental/unit_test/suite.hpp>
+#include <string>
 
 namespace boost {
 namespace beast {
@@ -168,10 +170,43 @@ public:
         good(status::network_authentication_required);
     }
 
+    void
+    testStatusLine()
+    {
+        for(unsigned version = 9; version <= 12; ++version)
+        {
+            for(unsigned code = 0; code < 1000; ++code)
+            {
+                auto const line =
+                    detail::status_line(version, code);
+                if( (version != 10 && version != 11) ||
+                    int_to_status(code) == status::unknown)
+                {
+                    BEAST_EXPECT(line.empty());
+                    continue;
+                }
+                std::string s = "HTTP/1.";
+                s += static_cast<char>('0' + version % 10);
+                s += ' ';
+                s += std::to_string(code);
+                s += ' ';
+                s += std::string(obsolete_reason(
+                    static_cast<status>(code)));
+                s += "\r\n";
+                BEAST_EXPECTS(line == s, s);
+            }
+        }
+
+        BEAST_EXPECT(detail::request_line_suffix(10) == " HTTP/1.0\r\n");
+        BEAST_EXPECT(detail::request_line_suffix(11) == " HTTP/1.1\r\n");
+        BEAST_EXPECT(detail::request_line_suffix(20).empty());
+    }
+
     void
     run()
     {
         testStatus();
+        testStatusLine();
     }
 };
 
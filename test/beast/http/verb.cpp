@@ -106,6 +106,24 @@ public:
         bad("UNLOC_");
         bad("UNSUBSCRIB_");
 
+        // wrong case, length, or a character past the first eight
+        bad("");
+        bad("G");
+        bad("GE");
+        bad("get");
+        bad("Get");
+        bad("GETS");
+        bad("POST ");
+        bad("PROPPATCHH");
+        bad("SUBSCRIBER");
+        bad("MKACTIVITX");
+        bad("MKCALENDAX");
+        bad("UNSUBSCRIBED");
+        bad("UNSUBSCRIBEX");
+        bad("UNSUBSCRXBE");
+        bad(string_view("GET\0", 4));
+        bad(string_view("PUT\0\0\0\0\0\0", 9));
+
         try
         {
             to_string(static_cast<verb>(-1));
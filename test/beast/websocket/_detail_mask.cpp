@@ -0,0 +1,299 @@
+//
+// Copyright (c) 2016-2019 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/beast
+//
+
+// Test that header file is self-contained.
+#include <boost/beast/websocket/detail/mask.hpp>
+
+#include <boost/beast/_experimental/unit_test/suite.hpp>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace boost {
+namespace beast {
+namespace websocket {
+namespace detail {
+
+class mask_test
+    : public beast::unit_test::suite
+{
+public:
+    using kernel = std::size_t(*)(unsigned char*,
+        unsigned char const*, std::size_t, prepared_key const&);
+
+    void
+    testKernel(kernel f, std::size_t block)
+    {
+        std::mt19937 g;
+        prepared_key key;
+        prepare_key(key, 0x12345678);
+        for(std::size_t off = 0; off < 32; ++off)
+        {
+            for(std::size_t n = 0; n < 200; ++n)
+            {
+                std::vector<unsigned char> v(off + n);
+                for(auto& c : v)
+                    c = static_cast<unsigned char>(g());
+                auto const v0 = v;
+                auto const used = f(v.data() + off,
+                    v.data() + off, n, key);
+                BEAST_EXPECT(used == n - n % block);
+                for(std::size_t i = 0; i < off; ++i)
+                    BEAST_EXPECT(v[i] == v0[i]);
+                for(std::size_t i = 0; i < used; ++i)
+                    BEAST_EXPECT(v[off + i] ==
+                        (v0[off + i] ^ key[i % 4]));
+                for(std::size_t i = used; i < n; ++i)
+                    BEAST_EXPECT(v[off + i] == v0[off + i]);
+            }
+        }
+    }
+
+    void
+    testKernels()
+    {
+        testKernel(&mask_swar, 8);
+#if ! BOOST_BEAST_NO_INTRINSICS
+        auto const& ci = beast::detail::get_cpu_info();
+        if(ci.sse2)
+            testKernel(&mask_sse2, 16);
+        if(ci.avx2)
+            testKernel(&mask_avx2, 32);
+#endif
+#if BOOST_BEAST_NEON
+        testKernel(&mask_neon, 16);
+#endif
+    }
+
+    void
+    testMaskInplace()
+    {
+        // Masking a payload in pieces of any size and
+        // alignment must give the same result as masking
+        // it all at once, and leave the key rotated.
+        std::mt19937 g;
+        for(int iter = 0; iter < 2000; ++iter)
+        {
+            std::size_t const off = g() % 40;
+            std::size_t const n = g() % 700;
+            std::vector<unsigned char> v(off + n);
+            for(auto& c : v)
+                c = static_cast<unsigned char>(g());
+            auto expected = v;
+            auto const k = static_cast<std::uint32_t>(g());
+            prepared_key key;
+            prepare_key(key, k);
+            for(std::size_t i = 0; i < n; ++i)
+                expected[off + i] ^= key[i % 4];
+
+            std::size_t pos = off;
+            while(pos < off + n)
+            {
+                auto const m = (std::min<std::size_t>)(
+                    1 + g() % 200, off + n - pos);
+                mask_inplace(net::mutable_buffer(
+                    v.data() + pos, m), key);
+                pos += m;
+            }
+            BEAST_EXPECT(v == expected);
+
+            prepared_key rotated;
+            prepare_key(rotated, k);
+            auto const r = n % 4;
+            BEAST_EXPECT(
+                key[0] == rotated[(0 + r) % 4] &&
+                key[1] == rotated[(1 + r) % 4] &&
+                key[2] == rotated[(2 + r) % 4] &&
+                key[3] == rotated[(3 + r) % 4]);
+        }
+    }
+
+    void
+    testMaskCopy()
+    {
+        // Copying from a sequence of buffers must give
+        // the same result as masking the payload in place.
+        std::mt19937 g;
+        for(int iter = 0; iter < 2000; ++iter)
+        {
+            std::string const s = [&]
+            {
+                std::string s(g() % 700, 0);
+                for(auto& c : s)
+                    c = static_cast<char>(g());
+                return s;
+            }();
+            auto const k = static_cast<std::uint32_t>(g());
+
+            std::string expected = s;
+            prepared_key key0;
+            prepare_key(key0, k);
+            mask_inplace(net::buffer(&expected[0],
+                expected.size()), key0);
+
+            std::vector<net::const_buffer> v;
+            std::size_t pos = 0;
+            while(pos < s.size())
+            {
+                auto const m = (std::min<std::size_t>)(
+                    g() % 100, s.size() - pos);
+                v.emplace_back(s.data() + pos, m);
+                pos += m;
+            }
+            std::size_t const off = g() % 40;
+            std::string dest(off + s.size() + 8, '*');
+            prepared_key key;
+            prepare_key(key, k);
+            auto const n = mask_copy(net::mutable_buffer(
+                &dest[off], s.size()), v, key);
+            BEAST_EXPECT(n == s.size());
+            BEAST_EXPECT(dest.substr(off, n) == expected);
+            BEAST_EXPECT(dest.substr(0, off) ==
+                std::string(off, '*'));
+            BEAST_EXPECT(dest.substr(off + n) ==
+                std::string(8, '*'));
+            BEAST_EXPECT(key == key0);
+        }
+
+        // The destination limits the copy
+        {
+            std::string const s = "Hello, world!";
+            char buf[5];
+            prepared_key key;
+            prepare_key(key, 0x01020304);
+            auto const n = mask_copy(
+                net::buffer(buf), net::buffer(s), key);
+            BEAST_EXPECT(n == sizeof(buf));
+            prepared_key key0;
+            prepare_key(key0, 0x01020304);
+            for(std::size_t i = 0; i < n; ++i)
+                BEAST_EXPECT(static_cast<unsigned char>(buf[i]) ==
+                    (static_cast<unsigned char>(s[i]) ^ key0[i % 4]));
+        }
+    }
+
+    using text_kernel = std::size_t(*)(unsigned char*,
+        std::size_t, prepared_key const&);
+
+    void
+    testKernel(text_kernel f, std::size_t block)
+    {
+        std::mt19937 g;
+        prepared_key key;
+        prepare_key(key, 0x12345678);
+        for(std::size_t n = 0; n < 200; ++n)
+        {
+            for(std::size_t pos = 0; pos <= n; ++pos)
+            {
+                // plain text with one non-ASCII byte at pos
+                std::vector<unsigned char> v(n);
+                for(auto& c : v)
+                    c = static_cast<unsigned char>(g() % 128);
+                if(pos < n)
+                    v[pos] = 0x80 | static_cast<unsigned char>(g());
+                auto const plain = v;
+                for(std::size_t i = 0; i < n; ++i)
+                    v[i] ^= key[i % 4];
+                auto const v0 = v;
+                auto const used = f(v.data(), n, key);
+                auto const ascii = pos - pos % block;
+                BEAST_EXPECT(used == (std::min)(
+                    ascii, n - n % block));
+                for(std::size_t i = 0; i < used; ++i)
+                    BEAST_EXPECT(v[i] == plain[i]);
+                for(std::size_t i = used; i < n; ++i)
+                    BEAST_EXPECT(v[i] == v0[i]);
+            }
+        }
+    }
+
+    void
+    testTextKernels()
+    {
+        testKernel(&unmask_ascii_swar, 8);
+#if ! BOOST_BEAST_NO_INTRINSICS
+        auto const& ci = beast::detail::get_cpu_info();
+        if(ci.sse2)
+            testKernel(&unmask_ascii_sse2, 16);
+        if(ci.avx2)
+            testKernel(&unmask_ascii_avx2, 32);
+#endif
+#if BOOST_BEAST_NEON
+        testKernel(&unmask_ascii_neon, 16);
+#endif
+    }
+
+    void
+    testUnmaskUtf8()
+    {
+        // Unmasking and checking a payload in pieces must
+        // give the same bytes as masking it in place, and
+        // the same verdict as checking the plain text.
+        static char const* const chars[] = {
+            "a", "Hello, world! ", "\xc2\xa9", "\xe2\x82\xac",
+            "\xe4\xb8\xad\xe6\x96\x87", "\xf0\x9f\x98\x80" };
+        static char const* const bad[] = {
+            "\x80", "\xc0\xaf", "\xed\xa0\x80", "\xf5\x80\x80\x80",
+            "\xe2\x82" };
+        std::mt19937 g;
+        for(int iter = 0; iter < 2000; ++iter)
+        {
+            std::string s;
+            auto const len = g() % 1500;
+            auto const mix = 1 + g() % 6;
+            while(s.size() < len)
+                s += chars[g() % mix];
+            if(iter % 4 == 0)
+                s.insert(g() % (s.size() + 1),
+                    bad[g() % (sizeof(bad) / sizeof(*bad))]);
+            auto const k = static_cast<std::uint32_t>(g());
+
+            std::string v = s;
+            prepared_key key;
+            prepare_key(key, k);
+            mask_inplace(net::buffer(&v[0], v.size()), key);
+
+            std::vector<net::mutable_buffer> bs;
+            std::size_t pos = 0;
+            while(pos < v.size())
+            {
+                auto const m = (std::min<std::size_t>)(
+                    g() % 300, v.size() - pos);
+                bs.emplace_back(&v[pos], m);
+                pos += m;
+            }
+            prepared_key key1;
+            prepare_key(key1, k);
+            utf8_checker checker;
+            auto const valid =
+                unmask_utf8(bs, key1, checker) &&
+                checker.finish();
+            BEAST_EXPECT(v == s);
+            BEAST_EXPECT(key1 == key);
+            BEAST_EXPECT(valid == check_utf8(s.data(), s.size()));
+        }
+    }
+
+    void
+    run() override
+    {
+        testKernels();
+        testMaskInplace();
+        testMaskCopy();
+        testTextKernels();
+        testUnmaskUtf8();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(beast,websocket,mask);
+
+} // detail
+} // websocket
+} // beast
+} // boost
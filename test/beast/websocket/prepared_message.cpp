@@ -0,0 +1,297 @@
+//
+// Copyright (c) 2016-2019 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/beast
+//
+
+// Test that header file is self-contained.
+#include <boost/beast/websocket/prepared_message.hpp>
+
+#include "test.hpp"
+
+#include <boost/beast/zlib/inflate_stream.hpp>
+#include <string>
+
+namespace boost {
+namespace beast {
+namespace websocket {
+
+class prepared_message_test : public websocket_test_suite
+{
+public:
+    // Returns the bytes sent to the client and not yet read
+    static
+    std::string
+    sent(stream_pair& p)
+    {
+        std::string const s(p.client.next_layer().str());
+        p.client.next_layer().clear();
+        return s;
+    }
+
+    std::string
+    inflate(std::string in, std::size_t n)
+    {
+        in.append("\x00\x00\xff\xff", 4);
+        zlib::inflate_stream zi;
+        zi.reset(15);
+        std::string out;
+        out.resize(n + 1);
+        zlib::z_params zs;
+        zs.next_in = in.data();
+        zs.avail_in = in.size();
+        zs.next_out = &out[0];
+        zs.avail_out = out.size();
+        error_code ec;
+        zi.write(zs, zlib::Flush::sync, ec);
+        BEAST_EXPECTS(! ec, ec.message());
+        out.resize(zs.total_out);
+        return out;
+    }
+
+    void
+    testFrame()
+    {
+        net::io_context ioc;
+        stream_pair p(ioc, make_pmd(false), make_pmd(false));
+
+        // small text message
+        {
+            prepared_message const m(net::buffer("Hello", 5));
+            BEAST_EXPECT(! m.binary());
+            BEAST_EXPECT(m.size() == 5);
+            BEAST_EXPECT(! m.deflated());
+            p.server.write_prepared(m);
+            BEAST_EXPECT(sent(p) ==
+                std::string("\x81\x05Hello", 7));
+        }
+
+        // empty binary message
+        {
+            prepared_message const m(net::const_buffer{}, true);
+            BEAST_EXPECT(m.binary());
+            BEAST_EXPECT(m.size() == 0);
+            p.server.write_prepared(m);
+            BEAST_EXPECT(sent(p) ==
+                std::string("\x82\x00", 2));
+        }
+
+        // 16-bit and 64-bit lengths
+        {
+            auto const s = content(300);
+            prepared_message const m(net::buffer(s));
+            p.server.write_prepared(m);
+            BEAST_EXPECT(sent(p) ==
+                std::string("\x81\x7e\x01\x2c", 4) + s);
+        }
+        {
+            auto const s = content(70000);
+            prepared_message const m(net::buffer(s), true);
+            p.server.write_prepared(m);
+            BEAST_EXPECT(sent(p) ==
+                std::string("\x82\x7f\x00\x00\x00\x00\x00\x01\x11\x70", 10) + s);
+        }
+
+        // copies send the same frame
+        {
+            prepared_message const m(net::buffer("abc", 3));
+            prepared_message m2(net::buffer("x", 1));
+            m2 = m;
+            p.server.write_prepared(m2);
+            BEAST_EXPECT(sent(p) ==
+                std::string("\x81\x03" "abc", 5));
+        }
+    }
+
+    void
+    testDeflate()
+    {
+        net::io_context ioc;
+        auto const s = content(10000);
+
+        // compressed with a fresh window
+        {
+            prepared_message const m(net::buffer(s), false, make_pmd(true));
+            BEAST_EXPECT(m.deflated());
+            BEAST_EXPECT(m.size() == s.size());
+            stream_pair p(ioc, make_pmd(true), make_pmd(true));
+            p.server.write_prepared(m);
+            auto const f = sent(p);
+            BEAST_EXPECT(f.size() < s.size());
+            BEAST_EXPECT(static_cast<unsigned char>(f[0]) == 0xc1);
+            BEAST_EXPECT(static_cast<unsigned char>(f[1]) == f.size() - 2);
+            BEAST_EXPECT(inflate(f.substr(2), s.size()) == s);
+
+            // the uncompressed frame is sent without the extension
+            stream_pair p2(ioc, make_pmd(false), make_pmd(false));
+            p2.server.write_prepared(m);
+            BEAST_EXPECT(sent(p2).size() == 4 + s.size());
+        }
+
+        // server side of the extension not enabled
+        {
+            auto pmd = make_pmd(true);
+            pmd.server_enable = false;
+            prepared_message const m(net::buffer(s), false, pmd);
+            BEAST_EXPECT(! m.deflated());
+        }
+
+        // below the threshold
+        {
+            auto pmd = make_pmd(true);
+            pmd.msg_size_threshold = s.size() + 1;
+            prepared_message const m(net::buffer(s), false, pmd);
+            BEAST_EXPECT(! m.deflated());
+        }
+
+        // incompressible payloads are sent uncompressed
+        {
+            prepared_message const m(net::buffer("x", 1), false, make_pmd(true));
+            BEAST_EXPECT(! m.deflated());
+        }
+
+        // invalid settings
+        {
+            auto pmd = make_pmd(true);
+            pmd.server_max_window_bits = 8;
+            try
+            {
+                prepared_message const m(net::buffer(s), false, pmd);
+                fail("", __FILE__, __LINE__);
+            }
+            catch(std::invalid_argument const&)
+            {
+                pass();
+            }
+        }
+    }
+
+    void
+    testWrite()
+    {
+        net::io_context ioc;
+        auto const s = content(10000);
+        prepared_message const m(net::buffer(s), false, make_pmd(true));
+        prepared_message const mb(net::buffer(s), true);
+        BEAST_EXPECT(m.deflated());
+
+        // without permessage-deflate
+        {
+            stream_pair p(ioc, make_pmd(false), make_pmd(false));
+            BEAST_EXPECT(p.server.write_prepared(m) == s.size());
+            BEAST_EXPECT(read(p.client, false) == s);
+            p.server.write_prepared(mb);
+            BEAST_EXPECT(read(p.client, true) == s);
+        }
+
+        // with permessage-deflate, followed by regular messages
+        {
+            stream_pair p(ioc, make_pmd(true), make_pmd(true));
+            p.server.write(net::buffer(s));
+            BEAST_EXPECT(read(p.client, false) == s);
+            BEAST_EXPECT(p.server.write_prepared(m) == s.size());
+            BEAST_EXPECT(read(p.client, false) == s);
+            p.server.write(net::buffer(s));
+            BEAST_EXPECT(read(p.client, false) == s);
+            p.server.write_prepared(m);
+            p.server.write_prepared(m);
+            BEAST_EXPECT(read(p.client, false) == s);
+            BEAST_EXPECT(read(p.client, false) == s);
+        }
+
+        // compression disabled on the stream
+        {
+            stream_pair p(ioc, make_pmd(true), make_pmd(true));
+            p.server.compress(false);
+            p.server.write_prepared(m);
+            BEAST_EXPECT(read(p.client, false) == s);
+            p.server.compress(true);
+            p.server.write(net::buffer(s));
+            BEAST_EXPECT(read(p.client, false) == s);
+        }
+
+        // the client negotiated a smaller window
+        {
+            auto pmd = make_pmd(true);
+            pmd.server_max_window_bits = 10;
+            stream_pair p(ioc, make_pmd(true), pmd);
+            p.server.write_prepared(m);
+            BEAST_EXPECT(read(p.client, false) == s);
+            p.server.write(net::buffer(s));
+            BEAST_EXPECT(read(p.client, false) == s);
+        }
+
+        // async
+        {
+            stream_pair p(ioc, make_pmd(true), make_pmd(true));
+            p.server.async_write_prepared(m,
+                [&](error_code ec, std::size_t n)
+                {
+                    BEAST_EXPECTS(! ec, ec.message());
+                    BEAST_EXPECT(n == s.size());
+                    p.server.async_write_prepared(mb,
+                        test::success_handler());
+                });
+            ioc.run();
+            ioc.restart();
+            BEAST_EXPECT(read(p.client, false) == s);
+            BEAST_EXPECT(read(p.client, true) == s);
+        }
+
+        // client role
+        {
+            stream_pair p(ioc, make_pmd(false), make_pmd(false));
+            error_code ec;
+            p.client.write_prepared(m, ec);
+            BEAST_EXPECT(ec == net::error::operation_not_supported);
+            p.client.async_write_prepared(m, test::fail_handler(
+                net::error::operation_not_supported));
+            ioc.run();
+            ioc.restart();
+
+            // the stream is still usable
+            p.client.write(net::buffer(s));
+            BEAST_EXPECT(read(p.server, false) == s);
+        }
+
+        // in the middle of a message
+        {
+            stream_pair p(ioc, make_pmd(false), make_pmd(false));
+            p.server.write_some(false, net::buffer(s));
+            error_code ec;
+            p.server.write_prepared(m, ec);
+            BEAST_EXPECT(ec == net::error::operation_not_supported);
+        }
+
+        // closed
+        {
+            stream_pair p(ioc, make_pmd(false), make_pmd(false));
+            flat_buffer b;
+            p.client.async_close({}, test::success_handler());
+            p.server.async_read(b, test::fail_handler(
+                websocket::error::closed));
+            ioc.run();
+            ioc.restart();
+            error_code ec;
+            p.server.write_prepared(m, ec);
+            BEAST_EXPECT(ec == net::error::operation_aborted);
+        }
+    }
+
+    void
+    run() override
+    {
+        testFrame();
+        testDeflate();
+        testWrite();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(beast,websocket,prepared_message);
+
+} // websocket
+} // beast
+} // boost
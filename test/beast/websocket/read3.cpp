@@ -1268,6 +1268,137 @@ public:
         }
     }
 
+    void
+    testReadBuffer()
+    {
+        std::string const small(10, 'a');
+        std::string const medium(5000, 'b');
+        std::string const large(200000, 'c');
+
+        auto const check =
+        [&](stream_base::read_buffer const& opt, bool async)
+        {
+            net::io_context ioc;
+            stream<test::stream> wsc{ioc};
+            stream<test::stream> wss{ioc};
+            wss.set_option(opt);
+            wsc.next_layer().connect(wss.next_layer());
+            wsc.async_handshake(
+                "localhost", "/", [](error_code){});
+            wss.async_accept([](error_code){});
+            ioc.run();
+            ioc.restart();
+            BEAST_EXPECT(wss.is_open());
+            wsc.binary(true);
+            wsc.write(net::buffer(small));
+            wsc.write(net::buffer(large));
+            wsc.write(net::buffer(medium));
+            wsc.write(net::buffer(large));
+
+            auto const read =
+            [&](flat_buffer& b)
+            {
+                error_code ec;
+                if(async)
+                {
+                    wss.async_read(b,
+                        [&ec](error_code ec_, std::size_t)
+                        {
+                            ec = ec_;
+                        });
+                    ioc.run();
+                    ioc.restart();
+                }
+                else
+                {
+                    wss.read(b, ec);
+                }
+                BEAST_EXPECTS(! ec, ec.message());
+            };
+
+            for(auto const& s : {small, large, medium})
+            {
+                flat_buffer b;
+                read(b);
+                BEAST_EXPECT(buffers_to_string(b.data()) == s);
+            }
+
+            // the rest of a large frame goes
+            // straight into the caller's buffer
+            std::string v(large.size(), 'x');
+            std::size_t n = 0;
+            while(n < v.size())
+            {
+                error_code ec;
+                auto const mb = net::buffer(&v[n], v.size() - n);
+                if(async)
+                {
+                    wss.async_read_some(mb,
+                        [&](error_code ec_, std::size_t bytes)
+                        {
+                            ec = ec_;
+                            n += bytes;
+                        });
+                    ioc.run();
+                    ioc.restart();
+                }
+                else
+                {
+                    n += wss.read_some(mb, ec);
+                }
+                if(! BEAST_EXPECTS(! ec, ec.message()))
+                    break;
+            }
+            BEAST_EXPECT(wss.is_message_done());
+            BEAST_EXPECT(v == large);
+
+            stream_base::read_buffer opt2{};
+            wss.get_option(opt2);
+            BEAST_EXPECT(opt2.size == (std::max)(
+                opt.size, std::size_t(1536)));
+            BEAST_EXPECT(opt2.pooled == opt.pooled);
+
+            // resize while open
+            wss.set_option(stream_base::read_buffer{0, false});
+            wsc.write(net::buffer(medium));
+            flat_buffer b;
+            read(b);
+            BEAST_EXPECT(buffers_to_string(b.data()) == medium);
+        };
+
+        for(auto async : {false, true})
+        {
+            check({0, false}, async);
+            check({1536, true}, async);
+            check({65536, false}, async);
+            check({65536, true}, async);
+            check({1024 * 1024, true}, async);
+        }
+
+        // streams share pooled buffers
+        {
+            net::io_context ioc;
+            stream<test::stream> ws1{ioc};
+            stream<test::stream> ws2{ioc};
+            ws1.set_option(stream_base::read_buffer{65536, true});
+            ws2.set_option(stream_base::read_buffer{65536, true});
+            ws1.next_layer().connect(ws2.next_layer());
+            ws1.async_handshake(
+                "localhost", "/", [](error_code){});
+            ws2.async_accept([](error_code){});
+            ioc.run();
+            ioc.restart();
+            ws1.write(net::buffer(medium));
+            ws2.write(net::buffer(medium));
+            flat_buffer b1;
+            flat_buffer b2;
+            ws2.read(b2);
+            ws1.read(b1);
+            BEAST_EXPECT(buffers_to_string(b1.data()) == medium);
+            BEAST_EXPECT(buffers_to_string(b2.data()) == medium);
+        }
+    }
+
     void
     testMoveOnly()
     {
@@ -1317,6 +1448,7 @@ public:
         testIssue3028();
         testIssueBF1();
         testIssueBF2();
+        testReadBuffer();
         testMoveOnly();
         testAsioHandlerInvoke();
     }
@@ -0,0 +1,271 @@
+//
+// Copyright (c) 2016-2019 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/beast
+//
+
+// Test that header file is self-contained.
+#include <boost/beast/websocket/stream.hpp>
+
+#include "test.hpp"
+
+#include <boost/beast/websocket/prepared_message.hpp>
+
+#include <boost/asio/bind_cancellation_slot.hpp>
+#include <string>
+
+namespace boost {
+namespace beast {
+namespace websocket {
+
+class send_test : public websocket_test_suite
+{
+public:
+    void
+    testSend(permessage_deflate const& pmd)
+    {
+        net::io_context ioc;
+        auto const s = content(3000);
+
+        // messages queued together are sent with one write
+        {
+            stream_pair p(ioc, pmd);
+            auto const n = p.server.next_layer().nwrite();
+            BEAST_EXPECT(p.server.send(net::buffer("one", 3)));
+            BEAST_EXPECT(p.server.send(net::buffer(s)));
+            p.server.binary(true);
+            BEAST_EXPECT(p.server.send(net::buffer("three", 5)));
+            p.server.binary(false);
+            BEAST_EXPECT(p.server.send_queue_size() > 0);
+            p.server.async_flush(test::success_handler());
+            p.run();
+            BEAST_EXPECT(p.server.next_layer().nwrite() == n + 1);
+            BEAST_EXPECT(p.server.send_queue_size() == 0);
+            BEAST_EXPECT(read(p.client) == "one");
+            BEAST_EXPECT(read(p.client) == s);
+            BEAST_EXPECT(read(p.client, true) == "three");
+
+            // regular writes may follow
+            p.server.write(net::buffer(s));
+            BEAST_EXPECT(read(p.client) == s);
+            BEAST_EXPECT(p.server.send(net::buffer(s)));
+            p.run();
+            BEAST_EXPECT(read(p.client) == s);
+        }
+
+        // writes started with messages queued go after them
+        {
+            stream_pair p(ioc, pmd);
+            auto const s1 = content(1000);
+            auto const s2 = content(2000);
+            prepared_message const m(net::buffer(s), false, pmd);
+
+            BEAST_EXPECT(p.server.send(net::buffer(s1)));
+            p.server.write(net::buffer(s2));
+            BEAST_EXPECT(read(p.client) == s1);
+            BEAST_EXPECT(read(p.client) == s2);
+
+            BEAST_EXPECT(p.server.send(net::buffer(s1)));
+            p.server.async_write(net::buffer(s2),
+                test::success_handler());
+            BEAST_EXPECT(p.server.send(net::buffer("two", 3)));
+            p.run();
+            BEAST_EXPECT(read(p.client) == s1);
+            BEAST_EXPECT(read(p.client) == "two");
+            BEAST_EXPECT(read(p.client) == s2);
+
+            BEAST_EXPECT(p.server.send(net::buffer(s1)));
+            p.server.write_prepared(m);
+            BEAST_EXPECT(p.server.send(net::buffer(s2)));
+            p.server.async_write_prepared(m,
+                test::success_handler());
+            p.run();
+            BEAST_EXPECT(read(p.client) == s1);
+            BEAST_EXPECT(read(p.client) == s);
+            BEAST_EXPECT(read(p.client) == s2);
+            BEAST_EXPECT(read(p.client) == s);
+            p.server.write(net::buffer(s1));
+            BEAST_EXPECT(read(p.client) == s1);
+        }
+
+        // client role
+        {
+            stream_pair p(ioc, pmd);
+            BEAST_EXPECT(p.client.send(net::buffer(s)));
+            BEAST_EXPECT(p.client.send(net::buffer("two", 3)));
+            BEAST_EXPECT(p.client.send(net::const_buffer{}));
+            p.run();
+            BEAST_EXPECT(read(p.server) == s);
+            BEAST_EXPECT(read(p.server) == "two");
+            BEAST_EXPECT(read(p.server) == "");
+            p.client.write(net::buffer(s));
+            BEAST_EXPECT(read(p.server) == s);
+        }
+    }
+
+    void
+    testLimit()
+    {
+        net::io_context ioc;
+        auto const s = content(60);
+        stream_pair p(ioc, make_pmd(false));
+        BEAST_EXPECT(p.server.send_queue_limit() == 1024 * 1024);
+        p.server.send_queue_limit(100);
+        BEAST_EXPECT(p.server.send_queue_limit() == 100);
+
+        // an empty queue accepts any message
+        BEAST_EXPECT(p.server.send(net::buffer(content(500))));
+        BEAST_EXPECT(! p.server.send(net::buffer(s)));
+        p.run();
+        BEAST_EXPECT(p.server.send_queue_size() == 0);
+        BEAST_EXPECT(read(p.client) == content(500));
+
+        BEAST_EXPECT(p.server.send(net::buffer(s)));
+        BEAST_EXPECT(p.server.send_queue_size() == 62);
+        BEAST_EXPECT(! p.server.send(net::buffer(s)));
+        BEAST_EXPECT(p.server.send(net::buffer("x", 1)));
+        p.run();
+        BEAST_EXPECT(read(p.client) == s);
+        BEAST_EXPECT(read(p.client) == "x");
+    }
+
+    void
+    testFlush()
+    {
+        net::io_context ioc;
+
+        // nothing queued
+        {
+            stream_pair p(ioc, make_pmd(false));
+            bool invoked = false;
+            p.server.async_flush(
+                [&](error_code ec)
+                {
+                    BEAST_EXPECTS(! ec, ec.message());
+                    invoked = true;
+                });
+            BEAST_EXPECT(! invoked);
+            p.run();
+            BEAST_EXPECT(invoked);
+        }
+
+        // write error
+        {
+            stream_pair p(ioc, make_pmd(false));
+            p.server.next_layer().close();
+            BEAST_EXPECT(p.server.send(net::buffer("abc", 3)));
+            p.server.async_flush(test::fail_handler(
+                net::error::connection_reset));
+            p.run();
+            BEAST_EXPECT(p.server.send_queue_size() == 0);
+            BEAST_EXPECT(! p.server.send(net::buffer("abc", 3)));
+        }
+
+        // messages queued behind a close frame are discarded
+        {
+            stream_pair p(ioc, make_pmd(false));
+            BEAST_EXPECT(p.server.send(net::buffer("abc", 3)));
+            p.server.async_close({}, test::success_handler());
+            p.server.async_flush(test::fail_handler(
+                net::error::operation_aborted));
+            flat_buffer b;
+            p.client.async_read(b, test::fail_handler(
+                websocket::error::closed));
+            p.run();
+            BEAST_EXPECT(! p.server.send(net::buffer("abc", 3)));
+        }
+
+        // cancellation
+        {
+            stream_pair p(ioc, make_pmd(false));
+            net::cancellation_signal sig;
+            BEAST_EXPECT(p.server.send(net::buffer("abc", 3)));
+            p.server.async_flush(net::bind_cancellation_slot(
+                sig.slot(), test::fail_handler(
+                    net::error::operation_aborted)));
+            sig.emit(net::cancellation_type::total);
+            p.run();
+            BEAST_EXPECT(read(p.client) == "abc");
+        }
+    }
+
+    void
+    testFragmented(permessage_deflate const& pmd)
+    {
+        net::io_context ioc;
+
+        // the queue waits for the end of a message
+        {
+            stream_pair p(ioc, pmd);
+            p.server.async_write_some(false,
+                net::buffer("abc", 3), test::success_handler());
+            p.run();
+            BEAST_EXPECT(p.server.send(net::buffer("two", 3)));
+            p.run();
+            p.server.async_write_some(true,
+                net::buffer("def", 3), test::success_handler());
+            p.run();
+            BEAST_EXPECT(read(p.client) == "abcdef");
+            BEAST_EXPECT(read(p.client) == "two");
+        }
+
+        // the end of the message is written first
+        {
+            stream_pair p(ioc, pmd);
+            p.server.async_write_some(false,
+                net::buffer("abc", 3), test::success_handler());
+            p.run();
+            BEAST_EXPECT(p.server.send(net::buffer("two", 3)));
+            p.server.async_write_some(true,
+                net::buffer("def", 3), test::success_handler());
+            p.run();
+            BEAST_EXPECT(read(p.client) == "abcdef");
+            BEAST_EXPECT(read(p.client) == "two");
+        }
+
+        // synchronous writes finish the message too
+        {
+            stream_pair p(ioc, pmd);
+            p.server.write_some(false, net::buffer("abc", 3));
+            BEAST_EXPECT(p.server.send(net::buffer("two", 3)));
+            p.run();
+            p.server.write_some(true, net::buffer("def", 3));
+            p.run();
+            BEAST_EXPECT(read(p.client) == "abcdef");
+            BEAST_EXPECT(read(p.client) == "two");
+        }
+
+        // queued while a message is being written in several frames
+        {
+            auto const s = content(3000);
+            stream_pair p(ioc, pmd);
+            p.server.write_buffer_bytes(8);
+            p.server.async_write(net::buffer(s),
+                test::success_handler());
+            BEAST_EXPECT(p.server.send(net::buffer(s)));
+            p.run();
+            BEAST_EXPECT(read(p.client) == s);
+            BEAST_EXPECT(read(p.client) == s);
+        }
+    }
+
+    void
+    run() override
+    {
+        testSend(make_pmd(false));
+        testSend(make_pmd(true));
+        testLimit();
+        testFlush();
+        testFragmented(make_pmd(false));
+        testFragmented(make_pmd(true));
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(beast,websocket,send);
+
+} // websocket
+} // beast
+} // boost
@@ -10,7 +10,9 @@
 // Test that header file is self-contained.
 #include <boost/beast/websocket/stream.hpp>
 
+#include <boost/beast/core/flat_buffer.hpp>
 #include <boost/beast/core/tcp_stream.hpp>
+#include <boost/beast/_experimental/test/handler.hpp>
 #include <boost/asio/strand.hpp>
 
 #include "test.hpp"
@@ -60,6 +62,17 @@ public:
             ws.get_option(opt);
             ws.set_option(opt);
         }
+
+        {
+            ws.set_option(
+                stream_base::read_buffer{65536, true});
+
+            stream_base::read_buffer opt;
+            ws.get_option(opt);
+            BEAST_EXPECT(opt.size == 65536);
+            BEAST_EXPECT(opt.pooled);
+            ws.set_option(opt);
+        }
     }
 
     void
@@ -152,6 +165,117 @@ public:
         }
     }
 
+    void
+    testHibernate()
+    {
+        net::io_context ioc;
+        permessage_deflate pmd;
+        pmd.client_enable = true;
+        pmd.server_enable = true;
+        pmd.msg_size_threshold = 0;
+
+        stream<test::stream> ws0(ioc);
+        stream<test::stream> ws1(ioc);
+        ws0.set_option(pmd);
+        ws1.set_option(pmd);
+        ws0.next_layer().connect(ws1.next_layer());
+        ws0.async_accept(test::success_handler());
+        ws1.async_handshake("localhost", "/",
+            test::success_handler());
+        ioc.run();
+        ioc.restart();
+
+        std::string const s(4000, '*');
+        flat_buffer b;
+        auto const check =
+            [&]
+            {
+                ws0.read(b);
+                BEAST_EXPECT(buffers_to_string(b.data()) == s);
+                b.clear();
+            };
+
+        // the write buffer and compressor are kept
+        BEAST_EXPECT(! ws1.hibernate());
+        ws1.write(net::buffer(s));
+        check();
+        auto const awake = ws1.memory_usage();
+        BEAST_EXPECT(awake > sizeof(ws1) + 4096);
+
+        // and given back while hibernating
+        ws1.hibernate(true);
+        BEAST_EXPECT(ws1.hibernate());
+        auto const idle = ws1.memory_usage();
+        BEAST_EXPECT(idle + 4096 < awake);
+        ws1.write(net::buffer(s));
+        BEAST_EXPECT(ws1.memory_usage() == idle);
+        check();
+        ws1.write(net::buffer(s));
+        check();
+
+        // the send queue
+        BEAST_EXPECT(ws1.send(net::buffer(s)));
+        BEAST_EXPECT(ws1.memory_usage() > idle);
+        ioc.run();
+        ioc.restart();
+        BEAST_EXPECT(ws1.memory_usage() == idle);
+        check();
+
+        // the read buffer is pooled
+        ws0.set_option(stream_base::read_buffer{65536, false});
+        auto const before = ws0.memory_usage();
+        ws0.hibernate(true);
+        stream_base::read_buffer opt;
+        ws0.get_option(opt);
+        BEAST_EXPECT(opt.size == 65536);
+        BEAST_EXPECT(opt.pooled);
+        BEAST_EXPECT(ws0.memory_usage() + 65536 <= before);
+        auto const after = ws0.memory_usage();
+        ws1.write(net::buffer(s));
+        check();
+        BEAST_EXPECT(ws0.memory_usage() == after);
+
+        // leaving hibernation restores the read buffer setting
+        ws0.hibernate(false);
+        ws0.get_option(opt);
+        BEAST_EXPECT(opt.size == 65536);
+        BEAST_EXPECT(! opt.pooled);
+        BEAST_EXPECT(ws0.memory_usage() >= after + 65536);
+
+        // a stream that is not hibernating keeps its buffers
+        ws1.hibernate(false);
+        ws1.write(net::buffer(s));
+        check();
+        BEAST_EXPECT(ws1.memory_usage() > idle + 4096);
+
+        // a pending read holds no pooled storage while it
+        // waits, and the option may be changed under it
+        ws0.hibernate(true);
+        auto const waiting = ws0.memory_usage();
+        bool invoked = false;
+        ws0.async_read(b,
+            [&](error_code ec, std::size_t)
+            {
+                BEAST_EXPECTS(! ec, ec.message());
+                invoked = true;
+            });
+        ioc.poll();
+        ioc.restart();
+        BEAST_EXPECT(! invoked);
+        BEAST_EXPECT(ws0.memory_usage() == waiting);
+        ws0.hibernate(false);
+        ws0.get_option(opt);
+        BEAST_EXPECT(opt.pooled);
+        ws1.write(net::buffer(s));
+        ioc.run();
+        ioc.restart();
+        BEAST_EXPECT(invoked);
+        BEAST_EXPECT(buffers_to_string(b.data()) == s);
+        ws0.get_option(opt);
+        BEAST_EXPECT(! opt.pooled);
+        BEAST_EXPECT(ws0.memory_usage() >= waiting + 65536);
+    }
+
     void
     testJavadoc()
     {
@@ -190,6 +314,7 @@ public:
     #endif
 
         testOptions();
+        testHibernate();
         testJavadoc();
     }
 };
@@ -13,9 +13,11 @@
 #include <boost/beast/core/bind_handler.hpp>
 #include <boost/beast/core/buffer_traits.hpp>
 #include <boost/beast/core/buffers_to_string.hpp>
+#include <boost/beast/core/flat_buffer.hpp>
 #include <boost/beast/core/ostream.hpp>
 #include <boost/beast/core/multi_buffer.hpp>
 #include <boost/beast/websocket/stream.hpp>
+#include <boost/beast/_experimental/test/handler.hpp>
 #include <boost/beast/_experimental/test/stream.hpp>
 #include <boost/beast/test/yield_to.hpp>
 #include <boost/beast/_experimental/unit_test/suite.hpp>
@@ -441,6 +443,80 @@ public:
         return s;
     }
 
+    // Returns n bytes of compressible text
+    static
+    std::string
+    content(std::size_t n)
+    {
+        std::string s;
+        s.reserve(n);
+        for(std::size_t i = 0; i < n; ++i)
+            s.push_back(static_cast<char>('a' + i % 26));
+        return s;
+    }
+
+    static
+    permessage_deflate
+    make_pmd(bool enable)
+    {
+        permessage_deflate pmd;
+        pmd.client_enable = enable;
+        pmd.server_enable = enable;
+        pmd.msg_size_threshold = 0;
+        return pmd;
+    }
+
+    // A server and client which completed the handshake
+    struct stream_pair
+    {
+        net::io_context& ioc;
+        stream<test::stream> server;
+        stream<test::stream> client;
+
+        stream_pair(
+            net::io_context& ioc_,
+            permessage_deflate const& pmd)
+            : stream_pair(ioc_, pmd, pmd)
+        {
+        }
+
+        stream_pair(
+            net::io_context& ioc_,
+            permessage_deflate const& server_pmd,
+            permessage_deflate const& client_pmd)
+            : ioc(ioc_)
+            , server(ioc_)
+            , client(ioc_)
+        {
+            server.set_option(server_pmd);
+            client.set_option(client_pmd);
+            server.next_layer().connect(client.next_layer());
+            server.async_accept(test::success_handler());
+            client.async_handshake("localhost", "/",
+                test::success_handler());
+            run();
+        }
+
+        void
+        run()
+        {
+            ioc.run();
+            ioc.restart();
+        }
+    };
+
+    // Reads one message and checks its type
+    std::string
+    read(stream<test::stream>& ws, bool binary = false)
+    {
+        flat_buffer b;
+        error_code ec;
+        ws.read(b, ec);
+        BEAST_EXPECTS(! ec, ec.message());
+        BEAST_EXPECT(ws.got_binary() == binary);
+        return buffers_to_string(b.data());
+    }
+
     //--------------------------------------------------------------------------
 
     struct SyncClient
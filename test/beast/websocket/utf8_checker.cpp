@@ -14,6 +14,8 @@
 #include <boost/beast/core/multi_buffer.hpp>
 #include <boost/beast/_experimental/unit_test/suite.hpp>
 #include <array>
+#include <random>
+#include <string>
 
 namespace boost {
 namespace beast {
@@ -566,6 +568,109 @@ public:
         }
     }
 
+    using validator = bool(*)(std::uint8_t const*, std::size_t);
+
+    void
+    checkValidator(validator f)
+    {
+        static char const* const chars[] = {
+            "a", "Hello, world! ", "\xc2\xa9", "\xe2\x82\xac",
+            "\xe4\xb8\xad\xe6\x96\x87", "\xf0\x9f\x98\x80",
+            "\xf4\x8f\xbf\xbf", "\xed\x9f\xbf", "\xee\x80\x80" };
+        std::mt19937 g;
+
+        // random text with a few damaged bytes, compared
+        // against checking it one code point at a time
+        for(int i = 0; i < 20000; ++i)
+        {
+            std::string s;
+            auto const len = g() % 200;
+            auto const mix = 1 + g() % 9;
+            while(s.size() < len)
+                s += chars[g() % mix];
+            for(auto n = g() % 3; n > 0 && ! s.empty(); --n)
+                s[g() % s.size()] = static_cast<char>(g());
+            auto const p = reinterpret_cast<
+                std::uint8_t const*>(s.data());
+            BEAST_EXPECT(f(p, s.size()) ==
+                validate_utf8_scalar(p, s.size()));
+        }
+
+        // every pair of leading bytes, straddling block boundaries
+        for(unsigned a = 0x80; a < 0x100; ++a)
+        {
+            for(unsigned b = 0; b < 0x100; ++b)
+            {
+                for(std::size_t off : {0, 14, 15, 30, 31})
+                {
+                    std::string s(off, '*');
+                    s.push_back(static_cast<char>(a));
+                    s.push_back(static_cast<char>(b));
+                    s.append("\x80\x80*");
+                    for(std::size_t n : {off + 2, s.size() - 1, s.size()})
+                    {
+                        auto const p = reinterpret_cast<
+                            std::uint8_t const*>(s.data());
+                        BEAST_EXPECT(f(p, n) ==
+                            validate_utf8_scalar(p, n));
+                    }
+                }
+            }
+        }
+    }
+
+    void
+    testValidators()
+    {
+        // the scalar validator agrees with the incremental checker
+        {
+            std::uint8_t const good[] = {
+                'a', 0xc2, 0xa9, 0xe2, 0x82, 0xac, 0xf0, 0x9f, 0x98, 0x80 };
+            BEAST_EXPECT(validate_utf8_scalar(good, sizeof(good)));
+            BEAST_EXPECT(! validate_utf8_scalar(good, sizeof(good) - 1));
+            BEAST_EXPECT(! validate_utf8_scalar(good + 2, 1));
+        }
+        checkValidator(&validate_utf8);
+#if ! BOOST_BEAST_NO_INTRINSICS
+        auto const& ci = beast::detail::get_cpu_info();
+        if(ci.ssse3)
+            checkValidator(&validate_utf8_ssse3);
+        if(ci.avx2)
+            checkValidator(&validate_utf8_avx2);
+#endif
+#if BOOST_BEAST_NEON
+        checkValidator(&validate_utf8_neon);
+#endif
+    }
+
+    void
+    testSplitCodePoints()
+    {
+        // long text written in pieces which cut code
+        // points at every offset must still be valid
+        std::string s;
+        while(s.size() < 300)
+            s.append("\xe4\xb8\xad\xf0\x9f\x98\x80 ascii \xc2\xa9");
+        auto const p = reinterpret_cast<
+            std::uint8_t const*>(s.data());
+        for(std::size_t i = 0; i <= s.size(); ++i)
+        {
+            utf8_checker u;
+            BEAST_EXPECT(u.write(p, i));
+            BEAST_EXPECT(u.write(p + i, s.size() - i));
+            BEAST_EXPECT(u.finish());
+        }
+
+        // a bad byte after the cut is still found
+        s[s.size() - 3] = '\xff';
+        for(std::size_t i = 0; i < s.size() - 3; ++i)
+        {
+            utf8_checker u;
+            BEAST_EXPECT(u.write(p, i));
+            BEAST_EXPECT(! u.write(p + i, s.size() - i));
+        }
+    }
+
     void
     run() override
     {
@@ -576,6 +681,8 @@ public:
         testWithStreamBuffer();
         testBranches();
         AutodeskTests();
+        testValidators();
+        testSplitCodePoints();
         // 6.4.2
         AutobahnTest(std::vector<std::vector<std::uint8_t>>{
             { 0xCE, 0xBA, 0xE1, 0xBD, 0xB9, 0xCF, 0x83, 0xCE, 0xBC, 0xCE, 0xB5, 0xF4 },
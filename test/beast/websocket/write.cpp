@@ -12,6 +12,8 @@
 
 #include <boost/asio/io_context.hpp>
 #include <boost/asio/strand.hpp>
+#include <memory>
+#include <vector>
 
 #if BOOST_ASIO_HAS_CO_AWAIT
 #include <boost/asio/use_awaitable.hpp>
@@ -835,6 +837,195 @@ public:
         }
     }
 
+    void
+    testCompressPolicy()
+    {
+        auto const open_pair =
+            [](net::io_context& ioc,
+                permessage_deflate const& pmd,
+                stream<test::stream>& ws0,
+                stream<test::stream>& ws1)
+            {
+                ws0.next_layer().connect(ws1.next_layer());
+                ws0.set_option(pmd);
+                ws1.set_option(pmd);
+                ws1.async_accept(
+                    [](error_code ec)
+                    {
+                        BEAST_EXPECTS(! ec, ec.message());
+                    });
+                ws0.async_handshake("test", "/",
+                    [](error_code ec)
+                    {
+                        BEAST_EXPECTS(! ec, ec.message());
+                    });
+                ioc.run();
+                ioc.restart();
+            };
+
+        // Returns the bytes sent by ws1 for a message
+        auto const sent =
+            [](stream<test::stream>& ws0,
+                stream<test::stream>& ws1,
+                std::string const& s)
+            {
+                auto const n0 = ws0.next_layer().nwrite_bytes();
+                ws1.binary(true);
+                ws1.write(net::buffer(s));
+                auto const n = ws0.next_layer().nwrite_bytes() - n0;
+                flat_buffer b;
+                ws0.read(b);
+                BEAST_EXPECT(buffers_to_string(b.data()) == s);
+                return n;
+            };
+
+        auto const& rs = random_string();
+        std::string const ts(4096, '*');
+
+        // incompressible messages are sent as-is
+        for(auto probe : {true, false})
+        {
+            net::io_context ioc;
+            permessage_deflate pmd;
+            pmd.client_enable = true;
+            pmd.server_enable = true;
+            pmd.msg_probe = probe;
+            stream<test::stream> ws0{ioc};
+            stream<test::stream> ws1{ioc};
+            open_pair(ioc, pmd, ws0, ws1);
+            BEAST_EXPECT(
+                (sent(ws0, ws1, rs) == rs.size() + 4) == probe);
+            BEAST_EXPECT(sent(ws0, ws1, ts) < ts.size());
+            // a header does not hide the data after it
+            auto const s = std::string(200, '\0') + rs;
+            BEAST_EXPECT(
+                (sent(ws0, ws1, s) == s.size() + 4) == probe);
+        }
+
+        // the level drops while messages compress poorly
+        {
+            net::io_context ioc;
+            permessage_deflate pmd;
+            pmd.client_enable = true;
+            pmd.server_enable = true;
+            pmd.compLevel = 9;
+            pmd.server_no_context_takeover = true;
+            pmd.adaptive_level = true;
+            stream<test::stream> ws0{ioc};
+            stream<test::stream> ws1{ioc};
+            open_pair(ioc, pmd, ws0, ws1);
+            // 7 bits per byte passes the probe
+            std::string s = rs;
+            for(auto& c : s)
+                c = static_cast<char>(c & 0x7f);
+            sent(ws0, ws1, s);
+            BEAST_EXPECT(ws1.impl_->pmd_->zo_level == 9);
+            sent(ws0, ws1, s);
+            BEAST_EXPECT(ws1.impl_->pmd_->zo_level == 1);
+            sent(ws0, ws1, ts);
+            sent(ws0, ws1, ts);
+            sent(ws0, ws1, ts);
+            BEAST_EXPECT(ws1.impl_->pmd_->zo_level == 9);
+        }
+
+        // callback
+        {
+            net::io_context ioc;
+            permessage_deflate pmd;
+            pmd.client_enable = true;
+            pmd.server_enable = true;
+            pmd.msg_probe = true;
+            stream<test::stream> ws0{ioc};
+            stream<test::stream> ws1{ioc};
+            open_pair(ioc, pmd, ws0, ws1);
+            int level = 0;
+            std::size_t calls = 0;
+            ws1.compress_callback(
+                [&](net::const_buffer b, std::size_t n)
+                {
+                    ++calls;
+                    BEAST_EXPECT(b.size() == n);
+                    BEAST_EXPECT(n == ts.size() || n == rs.size());
+                    return level;
+                });
+            BEAST_EXPECT(sent(ws0, ws1, ts) == ts.size() + 4);
+            level = 3;
+            BEAST_EXPECT(sent(ws0, ws1, ts) < ts.size());
+            BEAST_EXPECT(ws1.impl_->pmd_->zo_level == 3);
+            // the callback replaces the probe
+            BEAST_EXPECT(sent(ws0, ws1, rs) != rs.size() + 4);
+            ws1.compress(false);
+            BEAST_EXPECT(sent(ws0, ws1, ts) == ts.size() + 4);
+            ws1.compress(true);
+            BEAST_EXPECT(calls == 3);
+            ws1.compress_callback();
+            BEAST_EXPECT(sent(ws0, ws1, rs) == rs.size() + 4);
+            BEAST_EXPECT(calls == 3);
+        }
+    }
+
+    void
+    testDeflatePool()
+    {
+        // Streams on one context share compression
+        // state between messages without context takeover
+        for(auto takeover : {false, true})
+        {
+            net::io_context ioc;
+            permessage_deflate pmd;
+            pmd.client_enable = true;
+            pmd.server_enable = true;
+            pmd.client_no_context_takeover = ! takeover;
+            pmd.server_no_context_takeover = ! takeover;
+            std::vector<std::unique_ptr<stream<test::stream>>> v;
+            for(int i = 0; i < 6; ++i)
+            {
+                v.emplace_back(new stream<test::stream>(ioc));
+                v.back()->set_option(pmd);
+            }
+            for(std::size_t i = 0; i < v.size(); i += 2)
+            {
+                v[i]->next_layer().connect(v[i + 1]->next_layer());
+                v[i]->async_handshake("test", "/",
+                    [](error_code ec)
+                    {
+                        BEAST_EXPECTS(! ec, ec.message());
+                    });
+                v[i + 1]->async_accept(
+                    [](error_code ec)
+                    {
+                        BEAST_EXPECTS(! ec, ec.message());
+                    });
+            }
+            ioc.run();
+            for(int round = 0; round < 3; ++round)
+            {
+                for(std::size_t i = 0; i < v.size(); ++i)
+                {
+                    std::string const s(
+                        1000 + 100 * i + round,
+                        static_cast<char>('a' + i));
+                    v[i]->write(net::buffer(s));
+                    flat_buffer b;
+                    v[i ^ 1]->read(b);
+                    BEAST_EXPECT(
+                        buffers_to_string(b.data()) == s);
+                }
+            }
+            // a closed stream's state goes back to the pool
+            v[0]->next_layer().close();
+            v.erase(v.begin(), v.begin() + 2);
+            for(std::size_t i = 0; i < v.size(); ++i)
+            {
+                std::string const s(5000, '*');
+                v[i]->write(net::buffer(s));
+                flat_buffer b;
+                v[i ^ 1]->read(b);
+                BEAST_EXPECT(buffers_to_string(b.data()) == s);
+            }
+        }
+    }
+
 #if BOOST_ASIO_HAS_CO_AWAIT
     void testAwaitableCompiles(
         stream<test::stream>& s,
@@ -864,6 +1055,8 @@ public:
         testIssue300();
         testIssue1666();
         testIssue2880();
+        testCompressPolicy();
+        testDeflatePool();
 #if BOOST_ASIO_HAS_CO_AWAIT
         boost::ignore_unused(&write_test::testAwaitableCompiles);
 #endif
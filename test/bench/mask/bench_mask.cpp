@@ -0,0 +1,187 @@
+//
+// Copyright (c) 2016-2019 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/beast
+//
+
+#include <boost/beast/websocket/detail/mask.hpp>
+#include <boost/beast/_experimental/unit_test/suite.hpp>
+#include <chrono>
+#include <random>
+#include <vector>
+
+namespace boost {
+namespace beast {
+
+class mask_test : public beast::unit_test::suite
+{
+    std::mt19937 rng_;
+
+public:
+    using size_type = std::uint64_t;
+    using prepared_key = websocket::detail::prepared_key;
+
+    class timer
+    {
+    public:
+        using clock_type =
+            std::chrono::system_clock;
+
+    private:
+        clock_type::time_point when_;
+
+    public:
+        using duration =
+            clock_type::duration;
+
+        timer()
+            : when_(clock_type::now())
+        {
+        }
+
+        duration
+        elapsed() const
+        {
+            return clock_type::now() - when_;
+        }
+    };
+
+    static
+    inline
+    size_type
+    throughput(std::chrono::duration<
+        double> const& elapsed, size_type items)
+    {
+        using namespace std::chrono;
+        return static_cast<size_type>(
+            1 / (elapsed/items).count());
+    }
+
+    // The original four bytes at a time loop
+    static
+    std::size_t
+    mask_bytes(
+        unsigned char* out,
+        unsigned char const* in,
+        std::size_t n,
+        prepared_key const& key) noexcept
+    {
+        auto const n0 = n;
+        while(n >= 4)
+        {
+            for(int i = 0; i < 4; ++i)
+                out[i] = in[i] ^ key[i];
+            in += 4;
+            out += 4;
+            n -= 4;
+        }
+        return n0 - n;
+    }
+
+    static
+    std::size_t
+    mask_dispatch(
+        unsigned char* out,
+        unsigned char const* in,
+        std::size_t n,
+        prepared_key const& key) noexcept
+    {
+        auto k = key;
+        if(out == in)
+            websocket::detail::mask_inplace(
+                net::mutable_buffer(out, n), k);
+        else
+            websocket::detail::mask_copy(
+                net::mutable_buffer(out, n),
+                net::const_buffer(in, n), k);
+        return n;
+    }
+
+    // The original copy followed by a masking pass
+    static
+    std::size_t
+    copy_then_mask(
+        unsigned char* out,
+        unsigned char const* in,
+        std::size_t n,
+        prepared_key const& key) noexcept
+    {
+        auto k = key;
+        net::buffer_copy(
+            net::mutable_buffer(out, n),
+            net::const_buffer(in, n));
+        websocket::detail::mask_inplace(
+            net::mutable_buffer(out, n), k);
+        return n;
+    }
+
+    template<class F>
+    void
+    bench(
+        char const* name,
+        F const& f,
+        std::vector<unsigned char>& out,
+        std::vector<unsigned char> const& in,
+        std::size_t size)
+    {
+        prepared_key key;
+        websocket::detail::prepare_key(key,
+            static_cast<std::uint32_t>(rng_()));
+        // Keep the total work the same for every size
+        auto const repeat = (64 * 1024 * 1024) / size;
+        timer t;
+        for(std::size_t i = 0; i < repeat; ++i)
+            f(out.data(), in.data(), size, key);
+        auto const elapsed = t.elapsed();
+        log <<
+            name << " " << size << " bytes: " <<
+            throughput(elapsed, repeat * size) << " byte/s" <<
+            std::endl;
+    }
+
+    void
+    run() override
+    {
+        std::vector<unsigned char> v(1024 * 1024);
+        for(auto& c : v)
+            c = static_cast<unsigned char>(rng_());
+        auto w = v;
+
+        std::size_t const sizes[] = {
+            125, 1536, 16 * 1024, 1024 * 1024 };
+
+        log << "In place:" << std::endl;
+        for(auto size : sizes)
+        {
+            bench("bytes   ", &mask_bytes, v, v, size);
+            bench("swar    ", &websocket::detail::mask_swar, v, v, size);
+#if ! BOOST_BEAST_NO_INTRINSICS
+            auto const& ci = beast::detail::get_cpu_info();
+            if(ci.sse2)
+                bench("sse2    ", &websocket::detail::mask_sse2, v, v, size);
+            if(ci.avx2)
+                bench("avx2    ", &websocket::detail::mask_avx2, v, v, size);
+#endif
+#if BOOST_BEAST_NEON
+            bench("neon    ", &websocket::detail::mask_neon, v, v, size);
+#endif
+            bench("inplace ", &mask_dispatch, v, v, size);
+        }
+
+        log << "Copy:" << std::endl;
+        for(auto size : sizes)
+        {
+            bench("two pass", &copy_then_mask, w, v, size);
+            bench("fused   ", &mask_dispatch, w, v, size);
+        }
+        pass();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(beast,benchmarks,mask);
+
+} // beast
+} // boost
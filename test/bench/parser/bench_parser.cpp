@@ -19,8 +19,10 @@
 #include <boost/beast/core/flat_buffer.hpp>
 #include <boost/beast/core/multi_buffer.hpp>
 #include <boost/beast/_experimental/unit_test/suite.hpp>
+#include <algorithm>
 #include <chrono>
 #include <iostream>
+#include <string>
 #include <vector>
 
 namespace boost {
@@ -129,6 +131,43 @@ public:
             }
     }
 
+    // Split each message into pieces of at most `size` bytes,
+    // as when reading into a multi_buffer or a circular buffer.
+    static
+    std::vector<std::vector<net::const_buffer>>
+    segment(corpus const& v, std::size_t size)
+    {
+        std::vector<std::vector<net::const_buffer>> result;
+        result.reserve(v.size());
+        for(auto const& b : v)
+        {
+            std::vector<net::const_buffer> pieces;
+            auto const data = b.data();
+            for(std::size_t i = 0; i < data.size(); i += size)
+                pieces.emplace_back(
+                    static_cast<char const*>(data.data()) + i,
+                    (std::min)(size, data.size() - i));
+            result.emplace_back(std::move(pieces));
+        }
+        return result;
+    }
+
+    template<class Parser>
+    void
+    testParser3(std::size_t repeat,
+        std::vector<std::vector<net::const_buffer>> const& v)
+    {
+        while(repeat--)
+            for(auto const& b : v)
+            {
+                Parser p;
+                p.header_limit((std::numeric_limits<std::uint32_t>::max)());
+                error_code ec;
+                feed(b, p, ec);
+                BEAST_EXPECTS(! ec, ec.message());
+            }
+    }
+
     template<class Function>
     void
     timedTest(std::size_t repeat, std::string const& name, Function&& f)
@@ -321,6 +360,20 @@ public:
                     false, dynamic_body, fields>>(
                         Repeat, cres_);
             });
+        {
+            auto const sreq = segment(creq_, 512);
+            auto const sres = segment(cres_, 512);
+            timedTest(Trials, "http::basic_parser, 512 byte pieces",
+                [&]
+                {
+                    testParser3<bench_parser<
+                        true, dynamic_body, fields> >(
+                            Repeat, sreq);
+                    testParser3<bench_parser<
+                        false, dynamic_body, fields>>(
+                            Repeat, sres);
+                });
+        }
 #if 1
         timedTest(Trials, "nodejs_parser",
             [&]
@@ -337,10 +390,55 @@ public:
         pass();
     }
 
+    void
+    testSegmented()
+    {
+        static std::size_t constexpr Trials = 5;
+        static std::size_t constexpr Repeat = 50;
+
+        // Large messages arrive in many pieces, which
+        // the parser consumes without flattening them.
+        corpus v;
+        v.resize(N/2);
+        for(auto& b : v)
+            ostream(b) <<
+                "HTTP/1.1 200 OK\r\n"
+                "Server: test\r\n"
+                "Content-Length: 65536\r\n"
+                "\r\n" <<
+                std::string(65536, '*');
+
+        testcase << "Segmented parser speed test, " <<
+            ((Repeat * v.size() * v.front().size() + 512) / 1024) <<
+                "KB in " << (Repeat * v.size()) << " messages";
+
+        timedTest(Trials, "http::basic_parser, flat",
+            [&]
+            {
+                testParser2<bench_parser<
+                    false, dynamic_body, fields>>(
+                        Repeat, v);
+            });
+        for(std::size_t size : { 16384, 4096 })
+        {
+            auto const sv = segment(v, size);
+            timedTest(Trials, "http::basic_parser, " +
+                std::to_string(size) + " byte pieces",
+                [&]
+                {
+                    testParser3<bench_parser<
+                        false, dynamic_body, fields>>(
+                            Repeat, sv);
+                });
+        }
+        pass();
+    }
+
     void run() override
     {
         pass();
         testSpeed();
+        testSegmented();
     }
 };
 
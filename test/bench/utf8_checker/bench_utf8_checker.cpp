@@ -75,6 +75,7 @@ public:
             1 / (elapsed/items).count());
     }
 
+    // Printable ASCII
     std::string
     corpus(std::size_t n)
     {
@@ -86,6 +87,42 @@ public:
         return s;
     }
 
+    // Mostly ASCII with an occasional two, three
+    // or four byte code point, like chat messages
+    std::string
+    mixed_corpus(std::size_t n)
+    {
+        static char const* const chars[] = {
+            "\xc3\xa9", "\xc3\xbc", "\xe2\x80\x94",
+            "\xe2\x82\xac", "\xf0\x9f\x98\x80" };
+        std::string s;
+        s.reserve(n + 4);
+        while(s.size() < n)
+        {
+            if(rand(20) == 0)
+                s.append(chars[rand(5)]);
+            else
+                s.push_back(static_cast<char>(' ' + rand(95)));
+        }
+        return s;
+    }
+
+    // Three byte code points from the CJK block
+    std::string
+    cjk_corpus(std::size_t n)
+    {
+        std::string s;
+        s.reserve(n + 3);
+        while(s.size() < n)
+        {
+            auto const cp = 0x4e00 + rand(0x5200);
+            s.push_back(static_cast<char>(0xe0 | (cp >> 12)));
+            s.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3f)));
+            s.push_back(static_cast<char>(0x80 | (cp & 0x3f)));
+        }
+        return s;
+    }
+
     void
     checkBeast(std::string const& s)
     {
@@ -93,6 +130,14 @@ public:
             s.data(), s.size());
     }
 
+    void
+    checkScalar(std::string const& s)
+    {
+        beast::websocket::detail::validate_utf8_scalar(
+            reinterpret_cast<std::uint8_t const*>(
+                s.data()), s.size());
+    }
+
 #if BEAST_USE_BOOST_LOCALE_BENCHMARK
     void
     checkLocale(std::string const& s)
@@ -118,34 +163,48 @@ public:
         return t.elapsed();
     }
 
+    template<class F>
     void
-    run() override
+    bench(char const* name, std::string const& s, F const& f)
     {
-        auto const s = corpus(32 * 1024 * 1024);
         for(int i = 0; i < 5; ++ i)
         {
             auto const elapsed = test([&]{
-                checkBeast(s);
-                checkBeast(s);
-                checkBeast(s);
-                checkBeast(s);
-                checkBeast(s);
+                f(s);
+                f(s);
+                f(s);
+                f(s);
+                f(s);
             });
-            log << "beast:  " << throughput(elapsed, s.size()) << " char/s" << std::endl;
+            log << name << throughput(elapsed, 5 * s.size()) << " char/s" << std::endl;
         }
-    #if BEAST_USE_BOOST_LOCALE_BENCHMARK
-        for(int i = 0; i < 5; ++ i)
+    }
+
+    void
+    run() override
+    {
+        std::size_t constexpr size = 32 * 1024 * 1024;
+        struct corpus_type
         {
-            auto const elapsed = test([&]{
-                checkLocale(s);
-                checkLocale(s);
-                checkLocale(s);
-                checkLocale(s);
-                checkLocale(s);
-            });
-            log << "locale: " << throughput(elapsed, s.size()) << " char/s" << std::endl;
+            char const* name;
+            std::string text;
+        };
+        corpus_type const corpora[] = {
+            { "ascii", corpus(size) },
+            { "mixed", mixed_corpus(size) },
+            { "cjk", cjk_corpus(size) } };
+        for(auto const& c : corpora)
+        {
+            log << c.name << ":" << std::endl;
+            bench("scalar: ", c.text,
+                [&](std::string const& s){ checkScalar(s); });
+            bench("beast:  ", c.text,
+                [&](std::string const& s){ checkBeast(s); });
+        #if BEAST_USE_BOOST_LOCALE_BENCHMARK
+            bench("locale: ", c.text,
+                [&](std::string const& s){ checkLocale(s); });
+        #endif
         }
-    #endif
         pass();
     }
 };